@@ -0,0 +1,137 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief defines the observer tracking the heap allocations of the test cases
+// ***************************************************************************
+
+#ifndef BOOST_TEST_ALLOC_MONITOR_HPP_101926GER
+#define BOOST_TEST_ALLOC_MONITOR_HPP_101926GER
+
+// Boost.Test
+#include <boost/test/tree/observer.hpp>
+#include <boost/test/detail/global_typedef.hpp>
+#include <boost/test/utils/trivial_singleton.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+
+// STL
+#include <iosfwd>   // for std::ostream&
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                  alloc_stats                 ************** //
+// ************************************************************************** //
+
+/// Heap allocations made through the global operator new during a test case, or any other measure
+struct BOOST_TEST_DECL alloc_stats {
+    alloc_stats() { clear(); }
+
+    counter_t       m_allocations;      ///< number of blocks allocated
+    counter_t       m_bytes;            ///< number of bytes requested
+    counter_t       m_peak_bytes;       ///< peak of the bytes in use, above the ones in use at the start
+    counter_t       m_leaked_blocks;    ///< blocks allocated and not freed, net of the older blocks freed
+    bool            m_measured;         ///< false where the allocations can't be tracked
+
+    void            clear();
+    bool            empty() const { return !m_measured; }
+
+    /// Adds the allocations of another test unit, the peak being the highest of the two
+    alloc_stats&    operator+=( alloc_stats const& );
+};
+
+/// Writes the measured allocations, like "3 allocations, 120 bytes, peak 96 bytes, 1 leaked block"
+BOOST_TEST_DECL std::ostream& operator<<( std::ostream& ostr, alloc_stats const& as );
+
+// ************************************************************************** //
+// **************                 alloc_measure                ************** //
+// ************************************************************************** //
+
+/// Measures the heap allocations of the whole process between two points
+///
+/// The allocations are only tracked while a measure is in progress. The measures in progress at the same time
+/// must be nested, which allows checking the allocations of a piece of code in a test case:
+/// @code
+/// boost::unit_test::alloc_measure m;
+/// m.start();
+/// f();
+/// BOOST_TEST( m.stop().m_allocations == 0U );
+/// @endcode
+class BOOST_TEST_DECL alloc_measure {
+public:
+    alloc_measure();
+
+    /// Starts tracking the allocations
+    void            start();
+
+    /// Stops tracking the allocations and returns the ones made since the call to @ref start
+    alloc_stats     stop();
+
+    /// Whether the allocations can be tracked in this build
+    static bool     is_supported();
+
+private:
+    // Data members
+    boost::int64_t  m_allocations;      // values of the counters at the start
+    boost::int64_t  m_deallocations;
+    boost::int64_t  m_bytes;
+    boost::int64_t  m_live_bytes;
+    boost::int64_t  m_outer_peak;       // peak of the enclosing measure, restored by stop
+};
+
+// ************************************************************************** //
+// **************                 alloc_monitor                ************** //
+// ************************************************************************** //
+
+/// This class implements test observer interface and tracks the heap allocations of each test case
+///
+/// The global operator new and delete are replaced on Linux, unless @c BOOST_TEST_DISABLE_ALLOC_TRACKING is defined
+/// or the test module replaces them itself. The allocations made during the executions of the body of each test case,
+/// without its fixtures and the other observers, are reported to the other observers by
+/// framework::allocations_measured once the test case is finished. They are not tracked when the test cases are
+/// executed concurrently or in child processes.
+class BOOST_TEST_DECL alloc_monitor_t : public test_observer, public singleton<alloc_monitor_t> {
+public:
+    /// @name Test observer interface
+    /// @{
+    virtual void    test_start( counter_t );
+    virtual void    test_finish();
+
+    virtual void    test_unit_start( test_unit const& );
+    virtual void    test_unit_finish( test_unit const&, unsigned long );
+
+    virtual int     priority() { return 5; }
+    /// @}
+
+    /// @name Measure of the test case body
+    /// Called by the framework around each execution of the body of the test case being executed
+    /// @{
+    void            test_body_start( test_case const& );
+    void            test_body_finish( test_case const& );
+    /// @}
+
+private:
+    BOOST_TEST_SINGLETON_CONS( alloc_monitor_t )
+}; // alloc_monitor_t
+
+BOOST_TEST_SINGLETON_INST( alloc_monitor )
+
+} // namespace unit_test
+} // namespace boost
+
+//____________________________________________________________________________//
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_ALLOC_MONITOR_HPP_101926GER
@@ -15,6 +15,7 @@
 // Boost.Test
 #include <boost/test/data/monomorphic/array.hpp>
 #include <boost/test/data/monomorphic/collection.hpp>
+#include <boost/test/data/monomorphic/file_records.hpp>
 #include <boost/test/data/monomorphic/initializer_list.hpp>
 #include <boost/test/data/monomorphic/generate.hpp>
 #include <boost/test/data/monomorphic/generators.hpp>
@@ -48,6 +48,7 @@ public:
     // dataset interface
     data::size_t    size() const    { return m_size; }
     iterator        begin() const   { return m_arr; }
+    T const&        sample_at( std::size_t index ) const    { return m_arr[index]; }
 
 private:
     // Data members
@@ -16,6 +16,10 @@
 #include <boost/test/data/config.hpp>
 #include <boost/test/data/monomorphic/fwd.hpp>
 
+// STL
+#include <iterator>
+#include <type_traits>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -58,6 +62,13 @@ public:
     data::size_t    size() const            { return m_col.size(); }
     iterator        begin() const           { return m_col.begin(); }
 
+    //! Direct access to the samples, for the containers with random access iterators only
+    template<typename It = iterator>
+    typename std::enable_if<std::is_base_of<std::random_access_iterator_tag,
+                                            typename std::iterator_traits<It>::iterator_category>::value,
+                            sample const&>::type
+                    sample_at( std::size_t index ) const    { return m_col.begin()[index]; }
+
 private:
     // Data members
     C               m_col;
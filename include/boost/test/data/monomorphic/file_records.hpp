@@ -0,0 +1,414 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+///@file
+///Defines the dataset of the records of a file
+// ***************************************************************************
+
+#ifndef BOOST_TEST_DATA_MONOMORPHIC_FILE_RECORDS_HPP_101018GER
+#define BOOST_TEST_DATA_MONOMORPHIC_FILE_RECORDS_HPP_101018GER
+
+// Boost.Test
+#include <boost/test/data/config.hpp>
+#include <boost/test/data/monomorphic/fwd.hpp>
+
+#include <boost/test/utils/basic_cstring/basic_cstring.hpp>
+#include <boost/test/utils/basic_cstring/io.hpp>
+#include <boost/test/utils/mapped_file.hpp>
+#include <boost/test/utils/named_params.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+// STL
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <mutex>
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace data {
+
+namespace {
+nfp::keyword<struct record_size_t>      record_size;
+nfp::keyword<struct length_prefix_t>    length_prefix;
+nfp::keyword<struct delimiter_t>        delimiter;
+nfp::keyword<struct index_file_t>       index_file;
+} // local namespace
+
+namespace monomorphic {
+
+namespace ds_detail {
+
+// ************************************************************************** //
+// **************                 record_index                 ************** //
+// ************************************************************************** //
+
+// Content of the file and boundaries of its records. The offsets of the records are computed once: either read from
+// the index file written by a previous run, or computed by going through the file and then written to the index file.
+//
+// For N records, N+1 offsets are stored. The record i spans from m_offsets[i] + m_head to m_offsets[i+1] - m_tail:
+// - delimited records:         each offset is the position following a delimiter, the last one is the size of the
+//                              file plus 1 if the last record is not followed by a delimiter (head 0, tail 1);
+// - length prefixed records:   each offset is the position of a length, the last one is the size of the file
+//                              (head is the size of the length, tail 0).
+struct record_index {
+    enum { INDEX_VERSION = 1 };
+
+    record_index( std::string const& file_name, std::string const& index_file_name, char delim, unsigned prefix )
+    : m_file( file_name )
+    , m_head( prefix )
+    , m_tail( prefix == 0 ? 1 : 0 )
+    , m_offsets( 0 )
+    , m_count( 0 )
+    {
+        BOOST_TEST_DS_ASSERT( m_file.is_open(), "Can't read the file " + file_name );
+
+        // the format is part of the index, so that the index of another format of the same file is not used
+        m_format = prefix == 0 ? static_cast<unsigned char>( delim ) : 0x100 + prefix;
+
+        if( !index_file_name.empty() && load( index_file_name ) )
+            return;
+
+        build();
+
+        if( !index_file_name.empty() )
+            save( index_file_name );
+    }
+
+    data::size_t    size() const    { return m_count; }
+    const_string    record( std::size_t index ) const
+    {
+        char const* data = m_file.data();
+
+        return const_string( data + m_offsets[index] + m_head, data + m_offsets[index+1] - m_tail );
+    }
+
+private:
+    struct header {
+        char            m_magic[8];
+        boost::uint64_t m_version;
+        boost::uint64_t m_format;
+        boost::uint64_t m_file_size;
+        boost::uint64_t m_file_time;
+        boost::uint64_t m_count;
+    };
+
+    void            init_header( header& h ) const
+    {
+        std::memcpy( h.m_magic, "BTRECIDX", sizeof(h.m_magic) );
+        h.m_version     = INDEX_VERSION;
+        h.m_format      = m_format;
+        h.m_file_size   = m_file.size();
+        h.m_file_time   = m_file.last_write_time();
+        h.m_count       = 0;
+    }
+
+    // Uses the index of a previous run, if it was computed for the current content of the file
+    bool            load( std::string const& index_file_name )
+    {
+        if( m_file.last_write_time() == 0 )
+            return false;
+
+        shared_ptr<utils::mapped_file> index( new utils::mapped_file( index_file_name ) );
+        if( !index->is_open() || index->size() < sizeof(header) )
+            return false;
+
+        header expected;
+        init_header( expected );
+
+        header stored;
+        std::memcpy( &stored, index->data(), sizeof(header) );
+        expected.m_count = stored.m_count;
+
+        if( std::memcmp( &stored, &expected, sizeof(header) ) != 0 ||
+            stored.m_count >= (index->size() - sizeof(header)) / sizeof(boost::uint64_t) ||
+            index->size() != sizeof(header) + (stored.m_count + 1) * sizeof(boost::uint64_t) )
+            return false;
+
+        boost::uint64_t const* offsets = reinterpret_cast<boost::uint64_t const*>( index->data() + sizeof(header) );
+        if( !valid_offsets( offsets, static_cast<std::size_t>( stored.m_count ) ) )
+            return false;
+
+        // the offsets are used in place
+        m_index_file    = index;
+        m_offsets       = offsets;
+        m_count         = static_cast<std::size_t>( stored.m_count );
+
+        return true;
+    }
+
+    // Checks that the offsets read from an index file give records within the file: the size and the time of the
+    // last modification of the file do not tell reliably that its content did not change
+    bool            valid_offsets( boost::uint64_t const* offsets, std::size_t count ) const
+    {
+        boost::uint64_t const size = m_file.size();
+
+        if( offsets[0] != 0 )
+            return false;
+
+        for( std::size_t i = 0; i < count; ++i ) {
+            if( offsets[i+1] < offsets[i] || offsets[i+1] - offsets[i] < m_head + m_tail )
+                return false;
+        }
+
+        return offsets[count] == size || (m_head == 0 && offsets[count] == size + 1);
+    }
+
+    // Writes the index for the next runs. Failures are ignored: the index is then computed again
+    void            save( std::string const& index_file_name ) const
+    {
+        if( m_file.last_write_time() == 0 )
+            return;
+
+        header h;
+        init_header( h );
+        h.m_count = m_count;
+
+        // the index is written aside, so that concurrent runs never read a partial index
+        std::string const tmp_name = index_file_name + ".tmp";
+        {
+            std::ofstream out( tmp_name.c_str(), std::ios::binary );
+
+            out.write( reinterpret_cast<char const*>( &h ), sizeof(h) );
+            out.write( reinterpret_cast<char const*>( &m_built_offsets[0] ),
+                       static_cast<std::streamsize>( m_built_offsets.size() * sizeof(boost::uint64_t) ) );
+
+            if( !out.flush() ) {
+                out.close();
+                std::remove( tmp_name.c_str() );
+                return;
+            }
+        }
+
+        if( std::rename( tmp_name.c_str(), index_file_name.c_str() ) != 0 )
+            std::remove( tmp_name.c_str() );
+    }
+
+    void            build()
+    {
+        char const*     data = m_file.data();
+        boost::uint64_t const size = m_file.size();
+
+        m_built_offsets.push_back( 0 );
+
+        if( m_head == 0 ) {
+            char const  delim = static_cast<char>( m_format );
+            char const* end   = data + size;
+
+            for( char const* pos = data; pos != end; ) {
+                char const* found = static_cast<char const*>( std::memchr( pos, delim, static_cast<std::size_t>( end - pos ) ) );
+
+                pos = found ? found + 1 : end;
+                m_built_offsets.push_back( found ? static_cast<boost::uint64_t>( pos - data ) : size + 1 );
+            }
+        }
+        else {
+            for( boost::uint64_t pos = 0; pos != size; ) {
+                BOOST_TEST_DS_ASSERT( size - pos >= m_head, "Truncated length of the last record" );
+
+                // lengths are stored with the least significant byte first
+                boost::uint64_t length = 0;
+                for( std::size_t i = m_head; i > 0; --i )
+                    length = (length << 8) | static_cast<unsigned char>( data[pos + i - 1] );
+
+                BOOST_TEST_DS_ASSERT( size - pos - m_head >= length, "Truncated last record" );
+
+                pos += m_head + length;
+                m_built_offsets.push_back( pos );
+            }
+        }
+
+        m_offsets   = &m_built_offsets[0];
+        m_count     = m_built_offsets.size() - 1;
+    }
+
+    // Data members
+    utils::mapped_file              m_file;
+    std::size_t                     m_head;
+    std::size_t                     m_tail;
+    unsigned                        m_format;
+    shared_ptr<utils::mapped_file>  m_index_file;
+    std::vector<boost::uint64_t>    m_built_offsets;
+    boost::uint64_t const*          m_offsets;
+    std::size_t                     m_count;
+};
+
+//____________________________________________________________________________//
+
+// The samples point into the content of the file, and the test cases generated at start-up outlive the dataset they
+// are generated from: the contents are kept until the end of the program
+template<typename T>
+inline shared_ptr<T>
+retain_content( shared_ptr<T> const& content )
+{
+    static std::vector<shared_ptr<void> > s_contents;
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    static std::mutex s_mutex;
+    std::lock_guard<std::mutex> lock( s_mutex );
+#endif
+
+    s_contents.push_back( content );
+
+    return content;
+}
+
+} // namespace ds_detail
+
+// ************************************************************************** //
+// **************                file_records_t                ************** //
+// ************************************************************************** //
+
+//! Dataset of the records of a file
+//!
+//! The file is mapped in memory and its records are given without copy, as @c const_string samples pointing into the
+//! mapping. The dataset can be copied: the copies share the mapping, which is kept until the end of the program.
+class file_records_t {
+public:
+    typedef const_string sample;
+
+    enum { arity = 1 };
+
+    struct iterator {
+        // Constructor
+        iterator( file_records_t const& ds, std::size_t index )
+        : m_ds( &ds )
+        , m_index( index )
+        {}
+
+        // forward iterator interface
+        sample          operator*() const   { return m_ds->sample_at( m_index ); }
+        void            operator++()        { ++m_index; }
+
+    private:
+        file_records_t const*   m_ds;
+        std::size_t             m_index;
+    };
+
+    // Constructors
+    //! Records of a fixed size
+    file_records_t( std::string const& file_name, std::size_t record_size_val )
+    : m_file( ds_detail::retain_content( shared_ptr<utils::mapped_file>( new utils::mapped_file( file_name ) ) ) )
+    , m_record_size( record_size_val )
+    {
+        BOOST_TEST_DS_ASSERT( m_file->is_open(), "Can't read the file " + file_name );
+        BOOST_TEST_DS_ASSERT( m_record_size != 0, "Record size should not be null" );
+        BOOST_TEST_DS_ASSERT( m_file->size() % m_record_size == 0, "Size of the file " + file_name +
+                                                                   " is not a multiple of the record size" );
+    }
+
+    //! Records separated by a delimiter, or prefixed with their length
+    file_records_t( std::string const& file_name, std::string const& index_file_name, char delim, unsigned prefix )
+    : m_index( ds_detail::retain_content( shared_ptr<ds_detail::record_index>(
+                   new ds_detail::record_index( file_name, index_file_name, delim, prefix ) ) ) )
+    , m_record_size( 0 )
+    {
+    }
+
+    //! dataset interface
+    data::size_t    size() const
+    {
+        return m_index ? m_index->size() : data::size_t( m_file->size() / m_record_size );
+    }
+    iterator        begin() const   { return iterator( *this, 0 ); }
+    sample          sample_at( std::size_t index ) const
+    {
+        if( m_index )
+            return m_index->record( index );
+
+        char const* begin = m_file->data() + index * m_record_size;
+
+        return const_string( begin, m_record_size );
+    }
+
+private:
+    // Data members
+    shared_ptr<utils::mapped_file>          m_file;
+    shared_ptr<ds_detail::record_index>     m_index;
+    std::size_t                             m_record_size;
+};
+
+//____________________________________________________________________________//
+
+//! A file records dataset is a dataset
+template<>
+struct is_dataset<file_records_t> : mpl::true_ {};
+
+} // namespace monomorphic
+
+//____________________________________________________________________________//
+
+//! Creates a dataset of the records of a file
+//!
+//! @code
+//! auto d = file_records(file_name);
+//! auto d = file_records(file_name, params);
+//! @endcode
+//!
+//! The records are given as @c const_string samples, pointing into the file mapped in memory. By default the records
+//! are the lines of the file, without their terminating new line character. The following named parameters are
+//! accepted:
+//!   - @c record_size: the records have this fixed size in bytes
+//!   - @c length_prefix: each record is preceded by its length, an unsigned integer of this size in bytes (1, 2, 4
+//!     or 8) with the least significant byte first
+//!   - @c delimiter: the records are separated by this character instead of a new line
+//!   - @c index_file: name of the file in which the boundaries of the records are saved for the next runs, defaults
+//!     to the name of the file followed by ".idx". The boundaries are not saved if this name is empty.
+//!
+//! @note The samples of the dataset are accessed directly: a test case generated on demand for the sample of any
+//! index does not need to go through the previous records.
+inline monomorphic::file_records_t
+file_records( std::string const& file_name )
+{
+    return monomorphic::file_records_t( file_name, file_name + ".idx", '\n', 0 );
+}
+
+//____________________________________________________________________________//
+
+/// @overload boost::unit_test::data::file_records()
+template<typename Params>
+inline typename enable_if_c<nfp::is_named_param_pack<Params>::value,monomorphic::file_records_t>::type
+file_records( std::string const& file_name, Params const& params )
+{
+    if( params.has( data::record_size ) ) {
+        std::size_t size_val = 0;
+        nfp::opt_assign( size_val, params, data::record_size );
+
+        return monomorphic::file_records_t( file_name, size_val );
+    }
+
+    unsigned prefix = 0;
+    nfp::opt_assign( prefix, params, data::length_prefix );
+    BOOST_TEST_DS_ASSERT( prefix == 0 || prefix == 1 || prefix == 2 || prefix == 4 || prefix == 8,
+                          "Size of the length of the records should be 1, 2, 4 or 8" );
+
+    return monomorphic::file_records_t( file_name,
+                                        nfp::opt_get( params, data::index_file, file_name + ".idx" ),
+                                        nfp::opt_get( params, data::delimiter, '\n' ),
+                                        prefix );
+}
+
+//____________________________________________________________________________//
+
+} // namespace data
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_DATA_MONOMORPHIC_FILE_RECORDS_HPP_101018GER
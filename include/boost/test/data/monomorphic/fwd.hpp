@@ -22,10 +22,12 @@
 #include <boost/type_traits/remove_const.hpp>
 #include <boost/type_traits/remove_reference.hpp>
 #include <boost/type_traits/is_array.hpp>
+#include <boost/type_traits/decay.hpp>
 #include <boost/mpl/bool.hpp>
 
 // STL
 #include <tuple>
+#include <utility>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -80,6 +82,24 @@ struct is_dataset<DataSet&> : is_dataset<DataSet> {};
 template<typename DataSet>
 struct is_dataset<DataSet const> : is_dataset<DataSet> {};
 
+// ************************************************************************** //
+// **************          monomorphic::has_sample_at          ************** //
+// ************************************************************************** //
+
+//! Helper metafunction indicating if the specified dataset gives a direct access to its samples
+//!
+//! Such a dataset implements a member function @c sample_at(index), returning the sample at the given index
+//! without iterating over the previous ones.
+template<typename DataSet, typename Enable = void>
+struct has_sample_at : mpl::false_ {};
+
+//____________________________________________________________________________//
+
+template<typename DataSet>
+struct has_sample_at<DataSet,
+                     decltype( (void)std::declval<typename boost::decay<DataSet>::type const&>().sample_at( std::size_t() ) )>
+: mpl::true_ {};
+
 } // namespace monomorphic
 
 // ************************************************************************** //
@@ -87,6 +87,13 @@ public:
     //! Iterator on the beginning of the dataset
     iterator        begin() const           { return iterator( boost::ref(const_cast<Generator&>(m_generator)) ); }
 
+    //! Direct access to the samples, for the generators computing them from their index
+    template<typename G = Generator>
+    auto            sample_at( std::size_t index ) const -> decltype( std::declval<G const&>().sample_at( index ) )
+    {
+        return m_generator.sample_at( index );
+    }
+
 private:
     // Data members
     Generator       m_generator;
@@ -15,6 +15,7 @@
 // Boost.Test
 #include <boost/test/data/monomorphic/generators/xrange.hpp>
 #include <boost/test/data/monomorphic/generators/random.hpp>
+#include <boost/test/data/monomorphic/generators/csv.hpp>
 
 #endif // BOOST_TEST_DATA_MONOMORPHIC_GENERATORS_HPP_112011GER
 
@@ -0,0 +1,424 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+///@file
+///Defines the dataset of the rows of a delimited text file
+// ***************************************************************************
+
+#ifndef BOOST_TEST_DATA_MONOMORPHIC_GENERATORS_CSV_HPP_101018GER
+#define BOOST_TEST_DATA_MONOMORPHIC_GENERATORS_CSV_HPP_101018GER
+
+// Boost.Test
+#include <boost/test/data/config.hpp>
+#include <boost/test/data/index_sequence.hpp>
+#include <boost/test/data/monomorphic/fwd.hpp>
+#include <boost/test/data/monomorphic/file_records.hpp>
+#include <boost/test/data/monomorphic/generators/keywords.hpp>
+
+#include <boost/test/utils/basic_cstring/basic_cstring.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+// Boost
+#include <boost/static_assert.hpp>
+#include <boost/utility/enable_if.hpp>
+
+// STL
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace data {
+
+namespace {
+nfp::keyword<struct header_t>   header;
+} // local namespace
+
+namespace monomorphic {
+
+namespace ds_detail {
+
+// ************************************************************************** //
+// **************                    csv_row                   ************** //
+// ************************************************************************** //
+
+// Cursor over the fields of a row. The fields are slices of the row: the quotes enclosing a field are excluded, the
+// doubled quotes inside it are left as is
+class csv_row {
+public:
+    // Constructor
+    csv_row( const_string row, char delim )
+    : m_rest( row )
+    , m_delim( delim )
+    , m_done( false )
+    {}
+
+    // Gives the next field. Returns false after the last field, or if the field is malformed
+    bool            next( const_string& field, bool& quoted )
+    {
+        if( m_done )
+            return false;
+
+        char const* const   end = m_rest.end();
+        char const*         pos = m_rest.begin();
+
+        quoted = pos != end && *pos == '"';
+        if( quoted ) {
+            for( ++pos; pos != end; ++pos ) {
+                if( *pos != '"' )
+                    continue;
+
+                // a doubled quote is part of the field
+                if( pos + 1 == end || pos[1] != '"' )
+                    break;
+
+                ++pos;
+            }
+
+            // the closing quote ends the field
+            if( pos == end || (pos + 1 != end && pos[1] != m_delim) ) {
+                m_done = true;
+                return false;
+            }
+
+            field = const_string( m_rest.begin() + 1, pos );
+            ++pos;
+        }
+        else {
+            char const* found = static_cast<char const*>( std::memchr( pos, m_delim, static_cast<std::size_t>( end - pos ) ) );
+
+            pos   = found ? found : end;
+            field = const_string( m_rest.begin(), pos );
+        }
+
+        m_done = pos == end;
+        if( !m_done )
+            m_rest = const_string( pos + 1, end );
+
+        return true;
+    }
+
+    // Indicates if all the fields were given
+    bool            done() const    { return m_done; }
+
+private:
+    // Data members
+    const_string    m_rest;
+    char            m_delim;
+    bool            m_done;
+};
+
+// ************************************************************************** //
+// **************                  csv_convert                 ************** //
+// ************************************************************************** //
+
+// Conversions of a field to the type of its column. The arithmetic values are parsed without memory allocation
+
+inline std::string
+csv_unquote( const_string field, bool quoted )
+{
+    std::string res( field.begin(), field.end() );
+
+    if( quoted ) {
+        for( std::string::size_type pos = res.find( "\"\"" ); pos != std::string::npos; pos = res.find( "\"\"", pos + 1 ) )
+            res.erase( pos, 1 );
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+// Copies the trimmed field to a null terminated buffer, as required by the C conversion functions
+template<std::size_t N>
+inline bool
+csv_number( const_string field, char (&buffer)[N] )
+{
+    field.trim();
+
+    if( field.is_empty() || field.size() >= N )
+        return false;
+
+    std::memcpy( buffer, field.begin(), field.size() );
+    buffer[field.size()] = '\0';
+    errno = 0;
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+inline bool
+csv_convert( const_string field, bool /* quoted */, const_string& value )
+{
+    value = field;
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+inline bool
+csv_convert( const_string field, bool quoted, std::string& value )
+{
+    value = csv_unquote( field, quoted );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+inline bool
+csv_convert( const_string field, bool /* quoted */, bool& value )
+{
+    field.trim();
+
+    value = field == "1" || field == "true";
+
+    return value || field == "0" || field == "false";
+}
+
+//____________________________________________________________________________//
+
+inline bool
+csv_convert( const_string field, bool /* quoted */, char& value )
+{
+    if( field.size() != 1 )
+        return false;
+
+    value = field[0];
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value,bool>::type
+csv_convert( const_string field, bool /* quoted */, T& value )
+{
+    char buffer[32];
+    if( !csv_number( field, buffer ) )
+        return false;
+
+    char* end;
+    long long res = std::strtoll( buffer, &end, 10 );
+    if( *end != '\0' || errno != 0 || res < (std::numeric_limits<T>::min)() || res > (std::numeric_limits<T>::max)() )
+        return false;
+
+    value = static_cast<T>( res );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+template<typename T>
+inline typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value,bool>::type
+csv_convert( const_string field, bool /* quoted */, T& value )
+{
+    char buffer[32];
+    if( !csv_number( field, buffer ) || buffer[0] == '-' )
+        return false;
+
+    char* end;
+    unsigned long long res = std::strtoull( buffer, &end, 10 );
+    if( *end != '\0' || errno != 0 || res > (std::numeric_limits<T>::max)() )
+        return false;
+
+    value = static_cast<T>( res );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+template<typename T>
+inline typename std::enable_if<std::is_floating_point<T>::value,bool>::type
+csv_convert( const_string field, bool /* quoted */, T& value )
+{
+    char buffer[64];
+    if( !csv_number( field, buffer ) )
+        return false;
+
+    char* end;
+    long double res = std::strtold( buffer, &end );
+    if( *end != '\0' || errno != 0 )
+        return false;
+
+    value = static_cast<T>( res );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+// Other types are read from a stream
+template<typename T>
+inline typename std::enable_if<!std::is_arithmetic<T>::value,bool>::type
+csv_convert( const_string field, bool quoted, T& value )
+{
+    return utils::string_as( csv_unquote( field, quoted ), value );
+}
+
+} // namespace ds_detail
+
+// ************************************************************************** //
+// **************                     csv_t                    ************** //
+// ************************************************************************** //
+
+//! Dataset of the rows of a delimited text file
+//!
+//! Each row is a line of the file, and gives a sample made of the values of its columns, with the types @c Types.
+//! The file is mapped in memory and the rows are parsed when their samples are accessed.
+template<typename ...Types>
+class csv_t {
+    BOOST_STATIC_ASSERT_MSG( sizeof...(Types) > 0, "The types of the columns should be specified" );
+public:
+    typedef std::tuple<Types...> sample;
+
+    enum { arity = sizeof...(Types) };
+
+    struct iterator {
+        // Constructor
+        iterator( csv_t const& ds, std::size_t index )
+        : m_ds( &ds )
+        , m_index( index )
+        {}
+
+        // forward iterator interface
+        sample          operator*() const   { return m_ds->sample_at( m_index ); }
+        void            operator++()        { ++m_index; }
+
+    private:
+        csv_t const*    m_ds;
+        std::size_t     m_index;
+    };
+
+    // Constructor
+    csv_t( std::string const& file_name, std::string const& index_file_name, char delim, bool has_header )
+    : m_file_name( file_name )
+    , m_rows( file_name, index_file_name, '\n', 0 )
+    , m_delim( delim )
+    , m_first_row( has_header && m_rows.size().value() > 0 ? 1 : 0 )
+    {}
+
+    //! dataset interface
+    data::size_t    size() const    { return m_rows.size().value() - m_first_row; }
+    iterator        begin() const   { return iterator( *this, 0 ); }
+    sample          sample_at( std::size_t index ) const
+    {
+        const_string row = m_rows.sample_at( m_first_row + index );
+
+        // the lines of the files written on Windows end with a carriage return
+        if( !row.is_empty() && row[row.size() - 1] == '\r' )
+            row.trim_right( 1 );
+
+        ds_detail::csv_row fields( row, m_delim );
+        sample res;
+
+        parse( fields, res, m_first_row + index + 1, data::index_sequence_for<Types...>() );
+
+        BOOST_TEST_DS_ASSERT( fields.done(), "Too many columns in the line " + utils::string_cast( m_first_row + index + 1 ) +
+                                             " of the file " + m_file_name );
+
+        return res;
+    }
+
+private:
+    template<std::size_t ...I>
+    void            parse( ds_detail::csv_row& fields, sample& res, std::size_t line, data::index_sequence<I...> ) const
+    {
+        // the columns are parsed in their order
+        int dummy[] = { (parse_column( fields, std::get<I>( res ), line, I ), 0)... };
+        (void)dummy;
+    }
+
+    template<typename T>
+    void            parse_column( ds_detail::csv_row& fields, T& value, std::size_t line, std::size_t column ) const
+    {
+        const_string field;
+        bool quoted = false;
+
+        BOOST_TEST_DS_ASSERT( fields.next( field, quoted ) && ds_detail::csv_convert( field, quoted, value ),
+                              "Invalid column " + utils::string_cast( column + 1 ) + " in the line " +
+                              utils::string_cast( line ) + " of the file " + m_file_name );
+    }
+
+    // Data members
+    std::string     m_file_name;
+    file_records_t  m_rows;
+    char            m_delim;
+    std::size_t     m_first_row;
+};
+
+//____________________________________________________________________________//
+
+//! A csv dataset is a dataset
+template<typename ...Types>
+struct is_dataset<csv_t<Types...>> : mpl::true_ {};
+
+} // namespace monomorphic
+
+//____________________________________________________________________________//
+
+//! Creates a dataset of the rows of a delimited text file
+//!
+//! @code
+//! auto d = csv<Types...>(file_name);
+//! auto d = csv<Types...>(file_name, params);
+//! @endcode
+//!
+//! Each line of the file is a row, giving a sample made of the values of its columns. The types of the columns are
+//! the template parameters @c Types, and their number is the arity of the dataset. The fields may be enclosed in
+//! double quotes, in which case they may contain the delimiter and double quotes, written twice. The following named
+//! parameters are accepted:
+//!   - @c delimiter: the columns are separated by this character instead of a comma ('\\t' for TSV files)
+//!   - @c header: the first line holds the names of the columns and is skipped
+//!   - @c index_file: name of the file in which the boundaries of the lines are saved for the next runs, see
+//!     @ref boost::unit_test::data::file_records
+//!
+//! Only the rows whose samples are accessed are parsed. The fields are converted without memory allocation to the
+//! arithmetic types and to @c const_string, which refers to the field in the file mapped in memory.
+template<typename ...Types>
+inline monomorphic::csv_t<Types...>
+csv( std::string const& file_name )
+{
+    return monomorphic::csv_t<Types...>( file_name, file_name + ".idx", ',', false );
+}
+
+//____________________________________________________________________________//
+
+/// @overload boost::unit_test::data::csv()
+template<typename ...Types, typename Params>
+inline typename enable_if_c<nfp::is_named_param_pack<Params>::value,monomorphic::csv_t<Types...>>::type
+csv( std::string const& file_name, Params const& params )
+{
+    return monomorphic::csv_t<Types...>( file_name,
+                                         nfp::opt_get( params, data::index_file, file_name + ".idx" ),
+                                         nfp::opt_get( params, data::delimiter, ',' ),
+                                         nfp::opt_get( params, data::header, false ) );
+}
+
+//____________________________________________________________________________//
+
+} // namespace data
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_DATA_MONOMORPHIC_GENERATORS_CSV_HPP_101018GER
@@ -26,6 +26,7 @@
 // STL
 #include <limits>
 #include <cmath>
+#include <type_traits>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -79,6 +80,15 @@ public:
         m_index = 0;
     }
 
+    //! Sample at the given index, for the integral ranges only: the floating point samples are accumulated by next(),
+    //! so computing them from their index could give slightly different values
+    template<typename S = SampleType>
+    typename std::enable_if<std::is_integral<S>::value && std::is_integral<StepType>::value,SampleType>::type
+                        sample_at( std::size_t index ) const
+    {
+        return static_cast<SampleType>( m_begin + static_cast<SampleType>( index ) * static_cast<SampleType>( m_step ) );
+    }
+
 private:
     // Data members
     SampleType      m_begin;
@@ -105,6 +105,18 @@ public:
     data::size_t    size() const    { return m_ds1.size() * m_ds2.size(); }
     iterator        begin() const   { return iterator( m_ds1.begin(), m_ds2 ); }
 
+    //! Direct access to the samples, if both datasets give a direct access to theirs: the index is decomposed
+    //! into the indexes of the samples of each dataset
+    template<typename DS1 = dataset1_decay, typename DS2 = dataset2_decay>
+    auto            sample_at( std::size_t index ) const
+        -> decltype( sample_merge( std::declval<DS1 const&>().sample_at( index ),
+                                   std::declval<DS2 const&>().sample_at( index ) ) )
+    {
+        std::size_t const ds2_size = m_ds2.size().value();
+
+        return sample_merge( m_ds1.sample_at( index / ds2_size ), m_ds2.sample_at( index % ds2_size ) );
+    }
+
 private:
     // Data members
     DataSet1             m_ds1;
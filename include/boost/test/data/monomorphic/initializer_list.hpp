@@ -47,6 +47,7 @@ public:
     //! dataset interface
     data::size_t    size() const    { return m_data.size(); }
     iterator        begin() const   { return m_data.begin(); }
+    T const&        sample_at( std::size_t index ) const    { return m_data.begin()[index]; }
 
 private:
     // Data members
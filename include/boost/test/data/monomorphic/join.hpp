@@ -16,6 +16,9 @@
 #include <boost/test/data/config.hpp>
 #include <boost/test/data/monomorphic/fwd.hpp>
 
+// STL
+#include <type_traits>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -80,6 +83,16 @@ public:
     data::size_t    size() const    { return m_ds1.size() + m_ds2.size(); }
     iterator        begin() const   { return iterator( m_ds1.begin(), m_ds2.begin(), m_ds1.size() ); }
 
+    //! Direct access to the samples, if both datasets give a direct access to theirs
+    template<typename DS1 = dataset1_decay, typename DS2 = dataset2_decay>
+    typename std::enable_if<has_sample_at<DS1>::value && has_sample_at<DS2>::value,sample>::type
+                    sample_at( std::size_t index ) const
+    {
+        std::size_t const ds1_size = m_ds1.size().value();
+
+        return index < ds1_size ? sample( m_ds1.sample_at( index ) ) : sample( m_ds2.sample_at( index - ds1_size ) );
+    }
+
 private:
     // Data members
     DataSet1        m_ds1;
@@ -63,6 +63,7 @@ public:
     //! dataset interface
     data::size_t    size() const    { return 1; }
     iterator        begin() const   { return iterator( this ); }
+    sample const&   sample_at( std::size_t ) const  { return m_value; }
 
 private:
     // Data members
@@ -92,6 +92,17 @@ public:
     data::size_t    size() const    { return m_size; }
     iterator        begin() const   { return iterator( m_ds1.begin(), m_ds2.begin() ); }
 
+    //! Direct access to the samples, if both datasets give a direct access to theirs. A dataset of size 1 gives
+    //! its sample for all the indexes
+    template<typename DS1 = dataset1_decay, typename DS2 = dataset2_decay>
+    auto            sample_at( std::size_t index ) const
+        -> decltype( sample_merge( std::declval<DS1 const&>().sample_at( index ),
+                                   std::declval<DS2 const&>().sample_at( index ) ) )
+    {
+        return sample_merge( m_ds1.sample_at( m_ds1.size() == 1 ? 0 : index ),
+                             m_ds2.sample_at( m_ds2.size() == 1 ? 0 : index ) );
+    }
+
 private:
     // Data members
     DataSet1        m_ds1;
@@ -113,49 +113,82 @@ auto boost_bind_rvalue_holder_helper(T&& value)
 
 
 // ************************************************************************** //
-// **************                 test_case_gen                ************** //
+// **************                 sample_source                ************** //
 // ************************************************************************** //
 
+// Body of the test case of a sample which could not be read from the dataset: the error is reported when the test
+// case is executed, as the failure of this sample only
+struct invalid_sample {
+    explicit    invalid_sample( std::string const& what ) : m_what( what ) {}
+
+    void        operator()() const  { BOOST_TEST_I_THROW( std::logic_error( m_what ) ); }
+
+    std::string m_what;
+};
+
+//____________________________________________________________________________//
+
+// Generates the test case of each sample of the dataset. The samples are accessed directly if the dataset supports
+// it. Otherwise they are reached by iterating over the dataset, so the test cases are generated in order, and going
+// back restarts the iteration from the first sample
 template<typename TestCase,typename DataSet>
-class test_case_gen : public test_unit_generator {
+class sample_source : public test_case_source {
+    typedef typename std::decay<DataSet>::type  dataset_t;
+    typedef typename dataset_t::iterator        iterator;
 public:
     // Constructor
 #ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
-    test_case_gen( const_string tc_name, const_string tc_file, std::size_t tc_line, DataSet&& ds )
-    : m_tc_name( ut_detail::normalize_test_case_name( tc_name ) )
-    , m_tc_file( tc_file )
+    sample_source( const_string tc_file, std::size_t tc_line, DataSet&& ds )
+    : m_tc_file( tc_file )
     , m_tc_line( tc_line )
-    , m_tc_index( 0 )
-    {
-        data::for_each_sample( std::forward<DataSet>( ds ), *this );
-    }
-    test_case_gen( test_case_gen&& gen )
-    : m_tc_name( gen.m_tc_name )
-    , m_tc_file( gen.m_tc_file )
-    , m_tc_line( gen.m_tc_line )
-    , m_tc_index( gen.m_tc_index )
-    , m_test_cases( std::move(gen.m_test_cases) )
-    {}
+    , m_dataset( std::forward<DataSet>( ds ) )
+    , m_it( m_dataset.begin() )
+    , m_position( 0 )
+    , m_test_case( 0 )
 #else
-    test_case_gen( const_string tc_name, const_string tc_file, std::size_t tc_line, DataSet const& ds )
-    : m_tc_name( ut_detail::normalize_test_case_name( tc_name ) )
-    , m_tc_file( tc_file )    
+    sample_source( const_string tc_file, std::size_t tc_line, DataSet const& ds )
+    : m_tc_file( tc_file )
     , m_tc_line( tc_line )
-    , m_tc_index( 0 )
+    , m_dataset( ds )
+    , m_it( m_dataset.begin() )
+    , m_position( 0 )
+    , m_test_case( 0 )
+#endif
     {
-        data::for_each_sample( ds, *this );
+        BOOST_TEST_DS_ASSERT( !m_dataset.size().is_inf(), "Dataset has infinite size. Please specify the number of samples" );
+
+        m_size = m_dataset.size().value();
     }
-#endif
 
-    virtual test_unit* next() const
+    // test_case_source interface
+    virtual counter_t   size() const                    { return m_size; }
+    virtual std::string name( counter_t index ) const   { return "_" + utils::string_cast( index ); }
+    virtual counter_t   find( const_string tc_name ) const
     {
-        if( m_test_cases.empty() )
-            return 0;
+        counter_t index = 0;
 
-        test_unit* res = m_test_cases.front();
-        m_test_cases.pop_front();
+        if( tc_name.size() < 2 || tc_name[0] != '_' || (tc_name[1] == '0' && tc_name.size() > 2) )
+            return m_size;
 
-        return res;
+        for( const_string::iterator it = tc_name.begin() + 1; it != tc_name.end(); ++it ) {
+            if( *it < '0' || *it > '9' || index > (m_size - 1) / 10 )
+                return m_size;
+
+            index = index * 10 + (*it - '0');
+        }
+
+        return index < m_size ? index : m_size;
+    }
+    virtual test_case*  make( counter_t index )
+    {
+        BOOST_TEST_I_TRY {
+            make_impl( index, typename monomorphic::has_sample_at<dataset_t>::type() );
+        }
+        BOOST_TEST_I_CATCH( std::logic_error, ex ) {
+            m_test_case = new test_case( name( index ), m_tc_file, m_tc_line, invalid_sample( ex.what() ) );
+        }
+
+        return m_test_case;
     }
 
 #if !defined(BOOST_TEST_DATASET_VARIADIC)
@@ -164,9 +197,9 @@ public:
     template<BOOST_PP_ENUM_PARAMS(arity, typename Arg)>                                 \
     void    operator()( BOOST_PP_ENUM_BINARY_PARAMS(arity, Arg, const& arg) ) const     \
     {                                                                                   \
-        m_test_cases.push_back( new test_case( genTestCaseName(), m_tc_file, m_tc_line, \
+        m_test_case = new test_case( name( m_position ), m_tc_file, m_tc_line,          \
            boost::bind( &TestCase::template test_method<BOOST_PP_ENUM_PARAMS(arity,Arg)>,\
-           BOOST_PP_ENUM_PARAMS(arity, arg) ) ) );                                      \
+           BOOST_PP_ENUM_PARAMS(arity, arg) ) );                                        \
     }                                                                                   \
 
     BOOST_PP_REPEAT_FROM_TO(1, BOOST_TEST_DATASET_MAX_ARITY, TC_MAKE, _)
@@ -174,27 +207,99 @@ public:
     template<typename ...Arg>
     void    operator()(Arg&& ... arg) const
     {
-        m_test_cases.push_back(
-            new test_case( genTestCaseName(),
-                           m_tc_file,
-                           m_tc_line,
-                           boost::bind( &TestCase::template test_method<Arg...>,
-                                        boost_bind_rvalue_holder_helper(std::forward<Arg>(arg))...)));
+        m_test_case = new test_case( name( m_position ),
+                                     m_tc_file,
+                                     m_tc_line,
+                                     boost::bind( &TestCase::template test_method<Arg...>,
+                                                  boost_bind_rvalue_holder_helper(std::forward<Arg>(arg))...));
     }
 #endif
 
 private:
-    std::string  genTestCaseName() const
+    // the dataset gives a direct access to its samples
+    void        make_impl( counter_t index, mpl::true_ )
     {
-        return "_" + utils::string_cast(m_tc_index++);
+        m_position = index;
+
+        invoke_sample( m_dataset.sample_at( index ) );
+    }
+
+    // the dataset is iterated up to the sample, from the beginning if it was already passed
+    void        make_impl( counter_t index, mpl::false_ )
+    {
+        if( index < m_position ) {
+            m_it        = m_dataset.begin();
+            m_position  = 0;
+        }
+
+        for( ; m_position < index; ++m_position )
+            ++m_it;
+
+        invoke_sample( *m_it );
+    }
+
+    template<typename Sample>
+    void        invoke_sample( Sample&& sample )
+    {
+        data::invoke_action( *this, std::forward<Sample>( sample ), typename monomorphic::ds_detail::is_tuple<typename std::decay<Sample>::type>::type() );
     }
 
     // Data members
-    std::string                     m_tc_name;
     const_string                    m_tc_file;
     std::size_t                     m_tc_line;
-    mutable std::size_t             m_tc_index;
-    mutable std::list<test_unit*>   m_test_cases;
+    dataset_t                       m_dataset;
+    counter_t                       m_size;
+    iterator                        m_it;
+    counter_t                       m_position;     // index of the sample m_it points to
+    mutable test_case*              m_test_case;
+};
+
+// ************************************************************************** //
+// **************                 test_case_gen                ************** //
+// ************************************************************************** //
+
+// Generates the test cases of all the samples at registration, unless the data test case is lazy
+template<typename TestCase,typename DataSet>
+class test_case_gen : public test_unit_generator {
+public:
+    // Constructor
+#ifndef BOOST_NO_CXX11_RVALUE_REFERENCES
+    test_case_gen( const_string tc_name, const_string tc_file, std::size_t tc_line, DataSet&& ds )
+    : m_tc_name( ut_detail::normalize_test_case_name( tc_name ) )
+    , m_source( new sample_source<TestCase,DataSet>( tc_file, tc_line, std::forward<DataSet>( ds ) ) )
+    , m_tc_index( 0 )
+    {}
+    test_case_gen( test_case_gen&& gen )
+    : m_tc_name( gen.m_tc_name )
+    , m_source( std::move(gen.m_source) )
+    , m_tc_index( gen.m_tc_index )
+    {}
+#else
+    test_case_gen( const_string tc_name, const_string tc_file, std::size_t tc_line, DataSet const& ds )
+    : m_tc_name( ut_detail::normalize_test_case_name( tc_name ) )
+    , m_source( new sample_source<TestCase,DataSet>( tc_file, tc_line, ds ) )
+    , m_tc_index( 0 )
+    {}
+#endif
+
+    virtual test_unit* next() const
+    {
+        if( m_tc_index == m_source->size() )
+            return 0;
+
+        return m_source->make( m_tc_index++ );
+    }
+
+    virtual shared_ptr<test_case_source> source() const
+    {
+        return m_source;
+    }
+
+private:
+    // Data members
+    std::string                     m_tc_name;
+    shared_ptr<test_case_source>    m_source;
+    mutable counter_t               m_tc_index;
 };
 
 //____________________________________________________________________________//
@@ -236,13 +341,13 @@ struct BOOST_PP_CAT(test_name, case) : public F {                       \
     template<BOOST_PP_ENUM_PARAMS(arity, typename Arg)>                 \
     static void test_method( BOOST_DATA_TEST_CASE_PARAMS( params ) )    \
     {                                                                   \
-        BOOST_TEST_CHECKPOINT('"' << #test_name << "\" fixture entry.");\
+        BOOST_TEST_INVOKER_CHECKPOINT( test_name, "fixture entry." );   \
         BOOST_PP_CAT(test_name, case) t;                                \
-        BOOST_TEST_CHECKPOINT('"' << #test_name << "\" entry.");        \
+        BOOST_TEST_INVOKER_CHECKPOINT( test_name, "entry." );           \
         BOOST_TEST_CONTEXT( ""                                          \
             BOOST_PP_SEQ_FOR_EACH(BOOST_DATA_TEST_CONTEXT, _, params))  \
         t._impl(BOOST_PP_SEQ_ENUM(params));                             \
-        BOOST_TEST_CHECKPOINT('"' << #test_name << "\" exit.");         \
+        BOOST_TEST_INVOKER_CHECKPOINT( test_name, "exit." );            \
     }                                                                   \
 private:                                                                \
     template<BOOST_PP_ENUM_PARAMS(arity, typename Arg)>                 \
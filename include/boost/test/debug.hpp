@@ -23,6 +23,7 @@
 
 // STL
 #include <string>
+#include <cstddef>  // for std::size_t
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -128,6 +129,40 @@ void BOOST_TEST_DECL detect_memory_leaks( bool on_off, unit_test::const_string r
 
 void BOOST_TEST_DECL break_memory_alloc( long mem_alloc_order_num );
 
+// ************************************************************************** //
+/// Memory usage of the current process
+
+/// Filled by @ref memory_usage. The page faults are counted from the start of the process.
+// ************************************************************************** //
+
+struct process_memory_usage {
+    std::size_t     m_resident_bytes;       ///< memory currently resident in RAM
+    std::size_t     m_peak_resident_bytes;  ///< highest resident memory since the start or the last @ref reset_peak_memory_usage
+    unsigned long   m_minor_page_faults;    ///< page faults serviced without any I/O
+    unsigned long   m_major_page_faults;    ///< page faults which required an I/O
+};
+
+// ************************************************************************** //
+/// Retrieves the memory usage of the current process
+
+/// At the moment this is only available on Linux, where the resident memory is read from @c /proc/self/statm, its peak from
+/// @c /proc/self/status and the page faults from @c getrusage.
+/// @param[out] usage memory usage of the process
+/// @returns true if the memory usage could be retrieved. False otherwise
+// ************************************************************************** //
+
+bool BOOST_TEST_DECL memory_usage( process_memory_usage& usage );
+
+// ************************************************************************** //
+/// Resets the peak resident memory of the current process to its current resident memory
+
+/// This allows measuring the peak of a piece of code. At the moment this is only possible on Linux, by means of
+/// @c /proc/self/clear_refs.
+/// @returns true if the peak is reset. False otherwise
+// ************************************************************************** //
+
+bool BOOST_TEST_DECL reset_peak_memory_usage();
+
 } // namespace debug
 /// @}
 
@@ -78,6 +78,42 @@ class type_info;
 
 //____________________________________________________________________________//
 
+// parallel execution of the test cases relies on the C++11 threading support
+#if !defined(BOOST_TEST_DISABLE_THREADS)                && \
+    !defined(BOOST_NO_CXX11_HDR_THREAD)                 && \
+    !defined(BOOST_NO_CXX11_HDR_MUTEX)                  && \
+    !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)     && \
+    !defined(BOOST_NO_CXX11_HDR_ATOMIC)                 && \
+    !defined(BOOST_NO_CXX11_THREAD_LOCAL)
+#  define BOOST_TEST_SUPPORT_THREADS 1
+#  define BOOST_TEST_THREAD_LOCAL thread_local
+#else
+#  define BOOST_TEST_THREAD_LOCAL /**/
+#endif
+
+// isolation of the test cases in child processes relies on POSIX fork
+#if !defined(BOOST_TEST_DISABLE_FORK) && defined(BOOST_HAS_UNISTD_H) && defined(BOOST_HAS_SIGACTION)
+#  define BOOST_TEST_SUPPORT_FORK 1
+#endif
+
+// files are mapped in memory with POSIX mmap
+#if !defined(BOOST_TEST_DISABLE_MAPPED_FILE) && defined(BOOST_HAS_UNISTD_H)
+#  define BOOST_TEST_SUPPORT_MAPPED_FILE 1
+#endif
+
+// hardware performance counters of the test cases rely on the Linux perf_event_open system call
+#if !defined(BOOST_TEST_DISABLE_PERF_EVENTS) && defined(__linux__)
+#  define BOOST_TEST_SUPPORT_PERF_EVENTS 1
+#endif
+
+// allocation tracking replaces the global operator new and delete, and relies on malloc_usable_size and the GCC
+// atomic builtins. It is left out of the builds instrumented by the address sanitizer, which replaces them as well
+#if !defined(BOOST_TEST_DISABLE_ALLOC_TRACKING) && defined(__linux__) && defined(__GNUC__) && !defined(__SANITIZE_ADDRESS__)
+#  define BOOST_TEST_SUPPORT_ALLOC_TRACKING 1
+#endif
+
+//____________________________________________________________________________//
+
 #if defined(BOOST_ALL_DYN_LINK) && !defined(BOOST_TEST_DYN_LINK)
 #  define BOOST_TEST_DYN_LINK
 #endif
@@ -34,9 +34,16 @@ class  unit_test_log_t;
 class  unit_test_log_formatter;
 struct log_entry_data;
 struct log_checkpoint_data;
+struct benchmark_data;
+struct perf_counters;
+struct alloc_stats;
 
 class lazy_ostream;
 
+namespace utils {
+struct elapsed_time;
+} // namespace utils
+
 } // namespace unit_test
 
 } // namespace boost
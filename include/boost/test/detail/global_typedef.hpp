@@ -39,12 +39,35 @@ enum output_format { OF_INVALID,
                      OF_CLF,      ///< compiler log format
                      OF_XML,      ///< XML format for report and log,
                      OF_JUNIT,    ///< JUNIT format for report and log,
+                     OF_BINARY,   ///< binary format for log
                      OF_CUSTOM_LOGGER, ///< User specified logger.
                      OF_DOT       ///< dot format for output content
 };
 
 //____________________________________________________________________________//
 
+//! Indicates where the test cases are executed
+enum isolation_mode { ISOLATION_NONE,   ///< in the process of the test module
+                      ISOLATION_FORK    ///< each test case in a child process of the test module
+};
+
+//____________________________________________________________________________//
+
+//! Indicates the order of execution of the sibling test units
+enum schedule_order { SCHEDULE_DECLARATION,     ///< in the order of declaration
+                      SCHEDULE_LONGEST_FIRST    ///< longest test units first, according to the durations of the previous runs
+};
+
+//____________________________________________________________________________//
+
+//! Indicates which test cases are executed according to the results of the previous runs
+enum rerun_mode { RERUN_ALL,            ///< all the test cases
+                  RERUN_FAILED,         ///< only the test cases which failed in the previous runs
+                  RERUN_FAILED_FIRST    ///< all the test cases, the ones which failed in the previous runs first
+};
+
+//____________________________________________________________________________//
+
 enum test_unit_type { TUT_CASE = 0x01, TUT_SUITE = 0x10, TUT_ANY = 0x11 };
 
 //____________________________________________________________________________//
@@ -61,6 +84,9 @@ const test_unit_id MIN_TEST_CASE_ID  = 0x00010000;
 const test_unit_id MAX_TEST_SUITE_ID = 0x0000FF00;
 const test_unit_id MIN_TEST_SUITE_ID = 0x00000001;
 
+//! Allocation budget of the test cases whose allocations are not checked
+const counter_t NO_ALLOCATION_LIMIT  = static_cast<counter_t>( -1 );
+
 //____________________________________________________________________________//
 
 namespace ut_detail {
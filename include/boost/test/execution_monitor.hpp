@@ -27,6 +27,10 @@
 #include <boost/cstdlib.hpp>
 #include <boost/function/function0.hpp>
 
+// STL
+#include <string>
+#include <vector>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 #ifdef BOOST_SEH_BASED_SIGNAL_HANDLING
@@ -91,6 +95,10 @@
 //! your compiler (for instance, ESXi).
 #define BOOST_TEST_DISABLE_ALT_STACK
 
+//! Enables the capture of the call stack where the C++ exceptions are thrown. The capture interposes the function
+//! @c __cxa_throw of the GNU C++ library for the whole test module, and only works when this library is linked dynamically.
+#define BOOST_TEST_ENABLE_THROW_BACKTRACE
+
 #endif
 
 //____________________________________________________________________________//
@@ -226,6 +234,46 @@ protected:
 
 } // namespace detail
 
+// ************************************************************************** //
+/// @class stack_trace
+/// @brief Call stack of a failure detected by the execution_monitor
+///
+/// The return addresses of the stack are kept in a fixed size buffer, so that they can be captured from a signal handler
+/// without allocating any memory. They are turned into function names (symbolized) only when the stack trace is described,
+/// after the failure is caught.
+// ************************************************************************** //
+
+class BOOST_TEST_DECL stack_trace {
+public:
+    enum { max_frames = 64 };
+
+    /// Constructs an empty stack trace
+    stack_trace() : m_size( 0 ) {}
+
+    /// Constructs a stack trace from the return addresses, innermost first; the addresses above max_frames are ignored
+    stack_trace( void* const* frames, std::size_t size );
+
+    /// @name Access methods
+    bool            empty() const                   { return m_size == 0; }
+    std::size_t     size() const                    { return m_size; }
+    void*           frame( std::size_t i ) const    { return m_frames[i]; }
+    ///@}
+
+    /// Describes each frame, innermost first, with the name of its function and of its binary when they can be found
+    std::vector<std::string>    symbolize() const;
+
+    /// Indicates whether the call stack is captured where the signals are raised on this platform
+    static bool     is_supported();
+
+    /// Indicates whether the call stack is captured where the C++ exceptions are thrown on this platform
+    static bool     is_supported_for_exceptions();
+
+private:
+    // Data members
+    void*           m_frames[max_frames];
+    std::size_t     m_size;
+};
+
 // ************************************************************************** //
 /// @class execution_exception
 /// @brief This class is used to report any kind of an failure during execution of a monitored function inside of execution_monitor
@@ -283,7 +331,8 @@ public:
     /// @param[in] ec           error code
     /// @param[in] what_msg     error message
     /// @param[in] location     error location
-    execution_exception( error_code ec, const_string what_msg, location const& location );
+    /// @param[in] backtrace    call stack of the error, if captured
+    execution_exception( error_code ec, const_string what_msg, location const& location, stack_trace const& backtrace = stack_trace() );
 
     /// @name Access methods
 
@@ -293,6 +342,8 @@ public:
     const_string    what() const    { return m_what; }
     /// Exception location
     location const& where() const   { return m_location; }
+    /// Call stack of the error, captured when execution_monitor::p_capture_backtrace is set; empty otherwise
+    stack_trace const& backtrace() const { return m_backtrace; }
     ///@}
 
 private:
@@ -300,8 +351,19 @@ private:
     error_code      m_error_code;
     const_string    m_what;
     location        m_location;
+    stack_trace     m_backtrace;
 }; // execution_exception
 
+// ************************************************************************** //
+/// @brief Action taken when the timeout of a monitored function expires
+// ************************************************************************** //
+
+enum timeout_action {
+    TIMEOUT_REPORT,     ///< the function is interrupted and a timeout_error is reported
+    TIMEOUT_BACKTRACE,  ///< the stack of the function is written to the standard error stream, then the timeout_error is reported
+    TIMEOUT_ABORT       ///< the stack of the function is written to the standard error stream and the process is aborted
+};
+
 // ************************************************************************** //
 /// @brief Function execution monitor
 
@@ -336,9 +398,16 @@ public:
 
     ///  Specifies the seconds that elapse before a timer_error occurs.
     ///
-    /// The @em p_timeout property is an integer timeout (in seconds) for monitored function execution. Use this parameter to monitor code with possible deadlocks
-    /// or indefinite loops. This feature is only available for some operating systems (not yet Microsoft Windows).
-    unit_test::readwrite_property<unsigned>  p_timeout;
+    /// The @em p_timeout property is a timeout (in seconds, possibly fractional) for monitored function execution. Use this parameter to monitor code with possible deadlocks
+    /// or indefinite loops. The timeout is applied with a microsecond precision. This feature is only available for some operating systems (not yet Microsoft Windows).
+    unit_test::readwrite_property<double>    p_timeout;
+
+    ///  Specifies what happens when the timeout expires.
+    ///
+    /// The @em p_timeout_action property (default value is TIMEOUT_REPORT) specifies whether the stack of the monitored function is written to
+    /// the standard error stream when its timeout expires, and whether the process is aborted instead of reporting a timeout_error. Aborting
+    /// the process lets a core file be dumped for the functions which can't be interrupted safely.
+    unit_test::readwrite_property<timeout_action>   p_timeout_action;
 
     ///  Should monitor use alternative stack for the signal catching.
     ///
@@ -353,6 +422,14 @@ public:
     /// traps for the floating point exception on platforms where it's supported.
     unit_test::readwrite_property<unsigned> p_detect_fp_exceptions;
 
+    /// Should monitor capture the call stack of the failures.
+    ///
+    /// The @em p_capture_backtrace property is a boolean flag (default value is false) specifying whether or not execution_monitor should
+    /// capture the call stack where a signal is raised or where an uncaught C++ exception is thrown, and attach it to the execution_exception.
+    /// The call stack is captured with the GNU C library only, and the call stack of the C++ exceptions only with the shared GNU C++ library,
+    /// when BOOST_TEST_ENABLE_THROW_BACKTRACE is defined.
+    unit_test::readwrite_property<bool> p_capture_backtrace;
+
 
     // @name Monitoring entry points
 
@@ -417,6 +494,30 @@ public:
     //@}
 #endif
 
+    /// @brief Shares custom exception translators registered with another execution monitor
+    ///
+    /// Allows a monitor executing functions in a different thread to translate exceptions the same way.
+    /// @param[in] em   monitor to take translators from
+    void        copy_exception_translators( execution_monitor const& em )
+    {
+        m_custom_translators = em.m_custom_translators;
+    }
+
+    /// @brief Sets the function called before the process is terminated by a fatal signal
+    ///
+    /// The function is called when a signal like SIGSEGV or SIGABRT is not caught by a monitored function, either because it
+    /// is raised outside of the monitored functions or because the system errors are not caught, just before the default
+    /// action of the signal terminates the process. This allows to write out the buffered output, such as the test log.
+    /// The function is only called on the platforms with POSIX signals.
+    /// @param[in] hook  function to call, or 0 to remove the hook
+    static void set_termination_hook( void (*hook)() );
+
+    /// @brief Indicates whether several threads can monitor functions with a timeout at once
+    ///
+    /// On Linux each monitoring thread arms its own timer, which interrupts only the thread that armed it. Elsewhere
+    /// the timeout is implemented with the real time interval timer of the process, which can't be shared by several threads.
+    static bool thread_timeouts_supported();
+
 private:
     // implementation helpers
     int         catch_signals( boost::function<int ()> const& F );
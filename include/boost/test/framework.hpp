@@ -231,12 +231,26 @@ BOOST_TEST_DECL void                assertion_result( unit_test::assertion_resul
 BOOST_TEST_DECL void                exception_caught( execution_exception const& );
 /// Reports aborted test unit to all test observers
 BOOST_TEST_DECL void                test_unit_aborted( test_unit const& );
+/// Reports the performance counters of the test case to all test observers
+BOOST_TEST_DECL void                perf_counters_measured( test_case const&, perf_counters const& );
+/// Reports the heap allocations of the test case to all test observers
+BOOST_TEST_DECL void                allocations_measured( test_case const&, alloc_stats const& );
 /// @}
 
 namespace impl {
 // exclusively for self test
 BOOST_TEST_DECL void                setup_for_execution( test_unit const& );
 BOOST_TEST_DECL void                setup_loggers( );
+
+/// Gives the calling thread its own current test case and context, until detach_thread_state is called
+///
+/// Used by the threads reporting the test events on behalf of the thread driving the execution of the test tree.
+BOOST_TEST_DECL void                attach_thread_state();
+BOOST_TEST_DECL void                detach_thread_state();
+/// Sets the current test case of the calling thread
+BOOST_TEST_DECL void                set_thread_test_case( test_unit_id tc_id );
+/// Marks the test tree as being executed, for replaying the events of a test run outside of it
+BOOST_TEST_DECL void                set_test_in_progress( bool in_progress );
 } // namespace impl
 
 // ************************************************************************** //
@@ -0,0 +1,491 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements the tracking of the heap allocations of the test cases
+// ***************************************************************************
+
+#ifndef BOOST_TEST_ALLOC_MONITOR_IPP_101926GER
+#define BOOST_TEST_ALLOC_MONITOR_IPP_101926GER
+
+// Boost.Test
+#include <boost/test/alloc_monitor.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+
+#include <boost/test/tree/test_unit.hpp>
+
+// STL
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_ALLOC_TRACKING
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_SUPPORT_ALLOC_TRACKING
+
+namespace boost {
+namespace unit_test {
+namespace {
+
+// ************************************************************************** //
+// **************                alloc_counters                ************** //
+// ************************************************************************** //
+
+// Counters of the whole process, updated by any thread while a measure is in progress. They are constant
+// initialized, since the allocations start before the dynamic initialization
+struct alloc_counters {
+    int             m_tracking;         // number of measures in progress
+    boost::int64_t  m_allocations;
+    boost::int64_t  m_deallocations;
+    boost::int64_t  m_bytes;
+    boost::int64_t  m_live_bytes;       // relative to an arbitrary origin: the untracked blocks are not counted
+    boost::int64_t  m_peak_bytes;
+};
+
+alloc_counters s_alloc_counters = { 0, 0, 0, 0, 0, 0 };
+
+//____________________________________________________________________________//
+
+inline bool
+alloc_tracking()
+{
+    return __atomic_load_n( &s_alloc_counters.m_tracking, __ATOMIC_RELAXED ) > 0;
+}
+
+//____________________________________________________________________________//
+
+inline void
+raise_peak( boost::int64_t value )
+{
+    boost::int64_t peak = __atomic_load_n( &s_alloc_counters.m_peak_bytes, __ATOMIC_RELAXED );
+
+    while( value > peak &&
+           !__atomic_compare_exchange_n( &s_alloc_counters.m_peak_bytes, &peak, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) )
+        ;
+}
+
+//____________________________________________________________________________//
+
+void*
+tracked_malloc( std::size_t size )
+{
+    if( size == 0 )
+        size = 1;
+
+    for( ;; ) {
+        void* p = std::malloc( size );
+
+        if( p ) {
+            if( alloc_tracking() ) {
+                __atomic_add_fetch( &s_alloc_counters.m_allocations, 1, __ATOMIC_RELAXED );
+                __atomic_add_fetch( &s_alloc_counters.m_bytes, static_cast<boost::int64_t>( size ), __ATOMIC_RELAXED );
+                raise_peak( __atomic_add_fetch( &s_alloc_counters.m_live_bytes,
+                                                static_cast<boost::int64_t>( ::malloc_usable_size( p ) ), __ATOMIC_RELAXED ) );
+            }
+
+            return p;
+        }
+
+#if __cplusplus >= 201103L
+        std::new_handler handler = std::get_new_handler();
+#else
+        std::new_handler handler = std::set_new_handler( 0 );
+        std::set_new_handler( handler );
+#endif
+        if( !handler )
+            return 0;
+
+        handler();
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+tracked_free( void* p )
+{
+    if( !p )
+        return;
+
+    if( alloc_tracking() ) {
+        __atomic_add_fetch( &s_alloc_counters.m_deallocations, 1, __ATOMIC_RELAXED );
+        __atomic_sub_fetch( &s_alloc_counters.m_live_bytes, static_cast<boost::int64_t>( ::malloc_usable_size( p ) ), __ATOMIC_RELAXED );
+    }
+
+    std::free( p );
+}
+
+} // local namespace
+} // namespace unit_test
+} // namespace boost
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************       global operator new and delete         ************** //
+// ************************************************************************** //
+
+// The replacements are weak, so that the test modules can still replace them. The aligned and sized versions
+// of C++14 and C++17 are not replaced: the default ones call the unaligned ones, or are not tracked
+
+#if __cplusplus >= 201103L
+#  define BOOST_TEST_THROW_BAD_ALLOC
+#else
+#  define BOOST_TEST_THROW_BAD_ALLOC throw( std::bad_alloc )
+#endif
+
+__attribute__((weak)) void*
+operator new( std::size_t size ) BOOST_TEST_THROW_BAD_ALLOC
+{
+    if( void* p = boost::unit_test::tracked_malloc( size ) )
+        return p;
+
+    throw std::bad_alloc();
+}
+
+__attribute__((weak)) void*
+operator new[]( std::size_t size ) BOOST_TEST_THROW_BAD_ALLOC
+{
+    if( void* p = boost::unit_test::tracked_malloc( size ) )
+        return p;
+
+    throw std::bad_alloc();
+}
+
+__attribute__((weak)) void*
+operator new( std::size_t size, std::nothrow_t const& ) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    try {
+        return boost::unit_test::tracked_malloc( size );
+    }
+    catch( ... ) {
+        return 0;
+    }
+}
+
+__attribute__((weak)) void*
+operator new[]( std::size_t size, std::nothrow_t const& ) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    try {
+        return boost::unit_test::tracked_malloc( size );
+    }
+    catch( ... ) {
+        return 0;
+    }
+}
+
+__attribute__((weak)) void
+operator delete( void* p ) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    boost::unit_test::tracked_free( p );
+}
+
+__attribute__((weak)) void
+operator delete[]( void* p ) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    boost::unit_test::tracked_free( p );
+}
+
+__attribute__((weak)) void
+operator delete( void* p, std::nothrow_t const& ) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    boost::unit_test::tracked_free( p );
+}
+
+__attribute__((weak)) void
+operator delete[]( void* p, std::nothrow_t const& ) BOOST_NOEXCEPT_OR_NOTHROW
+{
+    boost::unit_test::tracked_free( p );
+}
+
+#undef BOOST_TEST_THROW_BAD_ALLOC
+
+#endif // BOOST_TEST_SUPPORT_ALLOC_TRACKING
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                  alloc_stats                 ************** //
+// ************************************************************************** //
+
+void
+alloc_stats::clear()
+{
+    m_allocations   = 0;
+    m_bytes         = 0;
+    m_peak_bytes    = 0;
+    m_leaked_blocks = 0;
+    m_measured      = false;
+}
+
+//____________________________________________________________________________//
+
+alloc_stats&
+alloc_stats::operator+=( alloc_stats const& other )
+{
+    m_allocations   += other.m_allocations;
+    m_bytes         += other.m_bytes;
+    m_peak_bytes    = (std::max)( m_peak_bytes, other.m_peak_bytes );
+    m_leaked_blocks += other.m_leaked_blocks;
+    m_measured      = m_measured || other.m_measured;
+
+    return *this;
+}
+
+//____________________________________________________________________________//
+
+std::ostream&
+operator<<( std::ostream& ostr, alloc_stats const& as )
+{
+    return ostr << as.m_allocations     << (as.m_allocations == 1 ? " allocation, " : " allocations, ")
+                << as.m_bytes           << (as.m_bytes == 1 ? " byte, peak " : " bytes, peak ")
+                << as.m_peak_bytes      << (as.m_peak_bytes == 1 ? " byte, " : " bytes, ")
+                << as.m_leaked_blocks   << (as.m_leaked_blocks == 1 ? " leaked block" : " leaked blocks");
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                 alloc_measure                ************** //
+// ************************************************************************** //
+
+alloc_measure::alloc_measure()
+: m_allocations( 0 )
+, m_deallocations( 0 )
+, m_bytes( 0 )
+, m_live_bytes( 0 )
+, m_outer_peak( 0 )
+{}
+
+//____________________________________________________________________________//
+
+void
+alloc_measure::start()
+{
+#ifdef BOOST_TEST_SUPPORT_ALLOC_TRACKING
+    __atomic_add_fetch( &s_alloc_counters.m_tracking, 1, __ATOMIC_RELAXED );
+
+    m_allocations   = __atomic_load_n( &s_alloc_counters.m_allocations, __ATOMIC_RELAXED );
+    m_deallocations = __atomic_load_n( &s_alloc_counters.m_deallocations, __ATOMIC_RELAXED );
+    m_bytes         = __atomic_load_n( &s_alloc_counters.m_bytes, __ATOMIC_RELAXED );
+    m_live_bytes    = __atomic_load_n( &s_alloc_counters.m_live_bytes, __ATOMIC_RELAXED );
+
+    // the peak of this measure starts from the bytes in use now
+    m_outer_peak    = __atomic_exchange_n( &s_alloc_counters.m_peak_bytes, m_live_bytes, __ATOMIC_RELAXED );
+#endif
+}
+
+//____________________________________________________________________________//
+
+alloc_stats
+alloc_measure::stop()
+{
+    alloc_stats as;
+
+#ifdef BOOST_TEST_SUPPORT_ALLOC_TRACKING
+    boost::int64_t const allocations   = __atomic_load_n( &s_alloc_counters.m_allocations, __ATOMIC_RELAXED ) - m_allocations;
+    boost::int64_t const deallocations = __atomic_load_n( &s_alloc_counters.m_deallocations, __ATOMIC_RELAXED ) - m_deallocations;
+    boost::int64_t const bytes         = __atomic_load_n( &s_alloc_counters.m_bytes, __ATOMIC_RELAXED ) - m_bytes;
+    boost::int64_t const peak          = __atomic_load_n( &s_alloc_counters.m_peak_bytes, __ATOMIC_RELAXED ) - m_live_bytes;
+
+    // the enclosing measure keeps the highest of the two peaks
+    raise_peak( m_outer_peak );
+
+    __atomic_sub_fetch( &s_alloc_counters.m_tracking, 1, __ATOMIC_RELAXED );
+
+    as.m_allocations    = static_cast<counter_t>( allocations );
+    as.m_bytes          = static_cast<counter_t>( bytes );
+    as.m_peak_bytes     = peak > 0 ? static_cast<counter_t>( peak ) : 0;
+    as.m_leaked_blocks  = allocations > deallocations ? static_cast<counter_t>( allocations - deallocations ) : 0;
+    as.m_measured       = true;
+#endif
+
+    return as;
+}
+
+//____________________________________________________________________________//
+
+bool
+alloc_measure::is_supported()
+{
+#ifdef BOOST_TEST_SUPPORT_ALLOC_TRACKING
+    static int s_supported = -1;
+
+    // the operator new replaced by the test module does not count the allocations
+    if( s_supported < 0 ) {
+        alloc_measure m;
+        m.start();
+
+        int* volatile p = new int( 0 );
+        delete p;
+
+        s_supported = m.stop().m_allocations != 0 ? 1 : 0;
+    }
+
+    return s_supported != 0;
+#else
+    return false;
+#endif
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                 alloc_monitor                ************** //
+// ************************************************************************** //
+
+namespace {
+
+struct alloc_monitor_impl {
+    // allocations of a test case being executed
+    struct measure {
+        explicit measure( test_unit_id tc_id ) : m_tc_id( tc_id ), m_in_body( false ), m_executed( false ) {}
+
+        test_unit_id    m_tc_id;
+        alloc_measure   m_body;     // execution of the body in progress
+        alloc_stats     m_total;    // executions of the body so far
+        bool            m_in_body;
+        bool            m_executed;
+    };
+
+    // Constructor
+    alloc_monitor_impl()
+    : m_enabled( false )
+    , m_runs( 0 )
+    {}
+
+    // Data members
+    bool                    m_enabled;
+    unsigned                m_runs;             // nesting level of the test runs
+    std::vector<measure>    m_measures;         // test cases being executed, the innermost last
+};
+
+alloc_monitor_impl& s_am_impl() { static alloc_monitor_impl the_inst; return the_inst; }
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+void
+alloc_monitor_t::test_start( counter_t )
+{
+    // the tracking is set up by the outermost test run
+    if( s_am_impl().m_runs++ != 0 )
+        return;
+
+    if( runtime_config::get<unsigned>( runtime_config::btrt_parallel ) != 1 ||
+        runtime_config::get<isolation_mode>( runtime_config::btrt_isolation ) != ISOLATION_NONE ) {
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Allocations are not tracked when the test cases are executed "
+                                      "concurrently or in child processes" );
+        return;
+    }
+
+    s_am_impl().m_enabled = alloc_measure::is_supported();
+
+    if( !s_am_impl().m_enabled )
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Allocation tracking is not available in this build" );
+}
+
+//____________________________________________________________________________//
+
+void
+alloc_monitor_t::test_finish()
+{
+    if( s_am_impl().m_runs == 0 || --s_am_impl().m_runs != 0 )
+        return;
+
+    s_am_impl().m_enabled = false;
+    s_am_impl().m_measures.clear();
+}
+
+//____________________________________________________________________________//
+
+void
+alloc_monitor_t::test_unit_start( test_unit const& tu )
+{
+    if( tu.p_type != TUT_CASE || !s_am_impl().m_enabled )
+        return;
+
+    s_am_impl().m_measures.push_back( alloc_monitor_impl::measure( tu.p_id ) );
+}
+
+//____________________________________________________________________________//
+
+void
+alloc_monitor_t::test_body_start( test_case const& tc )
+{
+    if( s_am_impl().m_measures.empty() || s_am_impl().m_measures.back().m_tc_id != tc.p_id )
+        return;
+
+    s_am_impl().m_measures.back().m_in_body = true;
+
+    // started last, so that the allocations do not include the framework
+    s_am_impl().m_measures.back().m_body.start();
+}
+
+//____________________________________________________________________________//
+
+void
+alloc_monitor_t::test_body_finish( test_case const& tc )
+{
+    if( s_am_impl().m_measures.empty() || s_am_impl().m_measures.back().m_tc_id != tc.p_id ||
+        !s_am_impl().m_measures.back().m_in_body )
+        return;
+
+    alloc_monitor_impl::measure& m = s_am_impl().m_measures.back();
+
+    m.m_total   += m.m_body.stop();
+    m.m_in_body  = false;
+    m.m_executed = true;
+}
+
+//____________________________________________________________________________//
+
+void
+alloc_monitor_t::test_unit_finish( test_unit const& tu, unsigned long )
+{
+    if( tu.p_type != TUT_CASE || s_am_impl().m_measures.empty() || s_am_impl().m_measures.back().m_tc_id != tu.p_id )
+        return;
+
+    // the body interrupted by a signal is measured up to now
+    test_body_finish( static_cast<test_case const&>( tu ) );
+
+    alloc_monitor_impl::measure const m = s_am_impl().m_measures.back();
+
+    s_am_impl().m_measures.pop_back();
+
+    // the body was not executed if a fixture failed
+    if( !m.m_executed )
+        return;
+
+    framework::allocations_measured( static_cast<test_case const&>( tu ), m.m_total );
+}
+
+//____________________________________________________________________________//
+
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_ALLOC_MONITOR_IPP_101926GER
@@ -0,0 +1,886 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements OF_BINARY Log formatter and its decoder
+// ***************************************************************************
+
+#ifndef BOOST_TEST_BINARY_LOG_FORMATTER_IPP_110917GER
+#define BOOST_TEST_BINARY_LOG_FORMATTER_IPP_110917GER
+
+// Boost.Test
+#include <boost/test/output/binary_log_formatter.hpp>
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/visitor.hpp>
+#include <boost/test/utils/algorithm.hpp>
+
+// Boost
+#include <boost/function.hpp>
+
+// STL
+#include <deque>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace output {
+
+namespace {
+
+// "BTL" followed by the format version
+const char          s_log_header[]      = { 'B', 'T', 'L', 1 };
+const std::size_t   s_log_header_size   = sizeof(s_log_header);
+
+log_level
+exception_log_level( execution_exception::error_code code )
+{
+    return code <= execution_exception::cpp_exception_error ? log_cpp_exception_errors :
+           (code <= execution_exception::timeout_error      ? log_system_errors
+                                                            : log_fatal_errors );
+}
+
+} // local namespace
+
+// ************************************************************************** //
+// **************             binary_log_formatter             ************** //
+// ************************************************************************** //
+
+struct binary_log_formatter::subtree_declarer : test_tree_visitor {
+    subtree_declarer( binary_log_formatter& formatter, std::ostream& ostr )
+    : m_formatter( formatter )
+    , m_ostr( ostr )
+    {}
+
+    virtual void    visit( test_case const& tc )            { m_formatter.declare( m_ostr, tc ); }
+    virtual bool    test_suite_start( test_suite const& ts ){ m_formatter.declare( m_ostr, ts ); return true; }
+
+    binary_log_formatter&   m_formatter;
+    std::ostream&           m_ostr;
+};
+
+//____________________________________________________________________________//
+
+binary_log_formatter::binary_log_formatter()
+: m_entry_log_level( log_all_errors )
+, m_record_type( BLR_LOG_START )
+, m_entry_logged( false )
+, m_exception_logged( false )
+{
+    m_log_level = log_test_units;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_start( std::ostream& ostr, counter_t test_cases_amount )
+{
+    // each log is self contained
+    m_declared_suites.clear();
+    m_declared_cases.clear();
+    m_file_ids.clear();
+    m_entry_logged      = false;
+    m_exception_logged  = false;
+
+    ostr.write( s_log_header, s_log_header_size );
+
+    begin_record( BLR_LOG_START );
+    put( static_cast<unsigned long>( m_entry_log_level ) );
+    put( test_cases_amount );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_finish( std::ostream& ostr )
+{
+    begin_record( BLR_LOG_FINISH );
+    write_record( ostr );
+
+    ostr.flush();
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_build_info( std::ostream& ostr )
+{
+    begin_record( BLR_BUILD_INFO );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_start( std::ostream& ostr, test_unit const& tu )
+{
+    declare( ostr, tu );
+
+    // the test units of the subtree are known before the first of them is reported
+    if( tu.p_type == TUT_SUITE )
+        declare_subtree( ostr, tu );
+
+    begin_record( BLR_UNIT_START );
+    put( tu.p_id );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, unsigned long elapsed )
+{
+    declare( ostr, tu );
+
+    // the results collector is notified first
+    test_results const& tr = results_collector.results( tu.p_id );
+
+    begin_record( BLR_UNIT_FINISH );
+    put( tu.p_id );
+    put( elapsed );
+    put( tr.p_assertions_passed );
+    put( tr.p_assertions_failed );
+    put( tr.p_warnings_failed );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_skipped( std::ostream& ostr, test_unit const& tu, const_string reason )
+{
+    declare( ostr, tu );
+
+    begin_record( BLR_UNIT_SKIPPED );
+    put( tu.p_id );
+    put( reason );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::test_unit_aborted( std::ostream& ostr, test_unit const& tu )
+{
+    declare( ostr, tu );
+
+    begin_record( BLR_UNIT_ABORTED );
+    put( tu.p_id );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_exception_start( std::ostream& ostr, log_checkpoint_data const& checkpoint_data, execution_exception const& ex )
+{
+    m_exception_logged = exception_log_level( ex.code() ) >= m_entry_log_level;
+    if( !m_exception_logged )
+        return;
+
+    execution_exception::location const& loc = ex.where();
+
+    unsigned long file              = file_id( ostr, loc.m_file_name );
+    unsigned long checkpoint_file   = file_id( ostr, checkpoint_data.m_file_name );
+
+    test_unit_id tc_id = declare_current_test_case( ostr );
+
+    begin_record( BLR_EXCEPTION_START );
+    put( tc_id );
+    put( static_cast<unsigned long>( ex.code() ) );
+    put( ex.what() );
+    put( file );
+    put( loc.m_line_num );
+    put( loc.m_function );
+    put( checkpoint_file );
+    put( checkpoint_data.m_line_num );
+    put( checkpoint_data.m_message );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_exception_finish( std::ostream& ostr )
+{
+    if( !m_exception_logged )
+        return;
+
+    begin_record( BLR_EXCEPTION_FINISH );
+    write_record( ostr );
+
+    m_exception_logged = false;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_start( std::ostream& ostr, log_entry_data const& entry_data, log_entry_types let )
+{
+    m_entry_logged = entry_data.m_level >= m_entry_log_level;
+    if( !m_entry_logged )
+        return;
+
+    unsigned long file  = file_id( ostr, entry_data.m_file_name );
+    test_unit_id  tc_id = declare_current_test_case( ostr );
+
+    begin_record( BLR_ENTRY_START );
+    put( tc_id );
+    put( static_cast<unsigned long>( let ) );
+    put( static_cast<unsigned long>( entry_data.m_level ) );
+    put( file );
+    put( entry_data.m_line_num );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_value( std::ostream& ostr, const_string value )
+{
+    if( !m_entry_logged )
+        return;
+
+    begin_record( BLR_ENTRY_VALUE );
+    put( value );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_finish( std::ostream& ostr )
+{
+    if( !m_entry_logged )
+        return;
+
+    begin_record( BLR_ENTRY_FINISH );
+    write_record( ostr );
+
+    m_entry_logged = false;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::entry_context_start( std::ostream& ostr, log_level l )
+{
+    if( !m_entry_logged && !m_exception_logged )
+        return;
+
+    begin_record( BLR_CONTEXT_START );
+    put( static_cast<unsigned long>( l ) );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::log_entry_context( std::ostream& ostr, const_string context_descr )
+{
+    if( !m_entry_logged && !m_exception_logged )
+        return;
+
+    begin_record( BLR_CONTEXT_FRAME );
+    put( context_descr );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::entry_context_finish( std::ostream& ostr )
+{
+    if( !m_entry_logged && !m_exception_logged )
+        return;
+
+    begin_record( BLR_CONTEXT_FINISH );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::set_log_level( log_level ll )
+{
+    m_entry_log_level = ll;
+
+    // the events of the test units are needed to rebuild the test tree and its results
+    m_log_level = (std::min)( ll, log_test_units );
+}
+
+//____________________________________________________________________________//
+
+std::string
+binary_log_formatter::get_default_stream_description() const
+{
+    std::string name = framework::master_test_suite().p_name.value;
+
+    static const std::string to_replace[] =  { " ", "\"", "/", "\\", ":"};
+    static const std::string replacement[] = { "_", "_" , "_", "_" , "_"};
+
+    name = unit_test::utils::replace_all_occurrences_of(
+        name,
+        to_replace, to_replace + sizeof(to_replace)/sizeof(to_replace[0]),
+        replacement, replacement + sizeof(replacement)/sizeof(replacement[0]));
+
+    return name + ".btl";
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::declare( std::ostream& ostr, test_unit const& tu )
+{
+    std::vector<bool>& declared = tu.p_type == TUT_SUITE ? m_declared_suites : m_declared_cases;
+    std::size_t        idx      = tu.p_id - (tu.p_type == TUT_SUITE ? MIN_TEST_SUITE_ID : MIN_TEST_CASE_ID);
+
+    if( idx < declared.size() && declared[idx] )
+        return;
+
+    if( idx >= declared.size() )
+        declared.resize( idx + 1 );
+    declared[idx] = true;
+
+    // parents are declared first
+    if( tu.p_parent_id != INV_TEST_UNIT_ID )
+        declare( ostr, framework::get( tu.p_parent_id, TUT_SUITE ) );
+
+    unsigned long file = file_id( ostr, tu.p_file_name );
+
+    begin_record( BLR_UNIT );
+    put( tu.p_id );
+    put( tu.p_parent_id );
+    put( static_cast<unsigned long>( tu.p_type == TUT_CASE ? BLU_CASE : (tu.p_type_name == "module" ? BLU_MODULE : BLU_SUITE) ) );
+    put( tu.p_name.get() );
+    put( file );
+    put( tu.p_line_num );
+    put( tu.p_expected_failures );
+    put( tu.is_enabled() ? 1UL : 0UL );
+    write_record( ostr );
+}
+
+//____________________________________________________________________________//
+
+test_unit_id
+binary_log_formatter::declare_current_test_case( std::ostream& ostr )
+{
+    // the events reported outside of the test cases refer to the current test case of the enclosing test run, if any
+    test_unit_id tc_id = framework::current_test_case_id();
+
+    if( tc_id != INV_TEST_UNIT_ID )
+        declare( ostr, framework::get( tc_id, TUT_CASE ) );
+
+    return tc_id;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::declare_subtree( std::ostream& ostr, test_unit const& tu )
+{
+    subtree_declarer declarer( *this, ostr );
+
+    traverse_test_tree( tu, declarer, true );
+}
+
+//____________________________________________________________________________//
+
+unsigned long
+binary_log_formatter::file_id( std::ostream& ostr, const_string file_name )
+{
+    if( file_name.is_empty() )
+        return 0;
+
+    m_file_name.assign( file_name.begin(), file_name.end() );
+
+    std::map<std::string,unsigned long>::const_iterator it = m_file_ids.find( m_file_name );
+    if( it != m_file_ids.end() )
+        return it->second;
+
+    unsigned long id = static_cast<unsigned long>( m_file_ids.size() ) + 1;
+    m_file_ids[m_file_name] = id;
+
+    begin_record( BLR_FILE );
+    put( id );
+    put( file_name );
+    write_record( ostr );
+
+    return id;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::begin_record( record_type t )
+{
+    m_record_type = t;
+    m_record.clear();
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::write_record( std::ostream& ostr )
+{
+    char          size_buf[10];
+    std::size_t   size_len  = 0;
+    unsigned long size      = static_cast<unsigned long>( m_record.size() );
+
+    do {
+        size_buf[size_len++] = static_cast<char>( (size & 0x7f) | (size > 0x7f ? 0x80 : 0) );
+        size >>= 7;
+    } while( size != 0 );
+
+    ostr.put( static_cast<char>( m_record_type ) );
+    ostr.write( size_buf, size_len );
+    ostr.write( m_record.data(), m_record.size() );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::put( unsigned long value )
+{
+    do {
+        m_record += static_cast<char>( (value & 0x7f) | (value > 0x7f ? 0x80 : 0) );
+        value >>= 7;
+    } while( value != 0 );
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_formatter::put( const_string value )
+{
+    put( static_cast<unsigned long>( value.size() ) );
+    m_record.append( value.begin(), value.end() );
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************               decode_binary_log              ************** //
+// ************************************************************************** //
+
+namespace {
+
+void no_op_test() {}
+
+// test suite rebuilt from a module record
+struct decoded_module : test_suite {
+    explicit decoded_module( const_string module_name ) : test_suite( module_name ) {}
+};
+
+//____________________________________________________________________________//
+
+class binary_log_decoder {
+public:
+    binary_log_decoder( std::istream& input, unit_test_log_formatter& formatter, std::ostream& output )
+    : m_input( input )
+    , m_formatter( formatter )
+    , m_output( output )
+    , m_pos( 0 )
+    , m_recorded_level( log_all_errors )
+    , m_entry_logged( false )
+    , m_exception_logged( false )
+    {}
+
+    void            decode()
+    {
+        if( !read_header() )
+            throw std::runtime_error( "input is not a binary log" );
+
+        int type;
+        while( (type = m_input.get()) != std::char_traits<char>::eof() ) {
+            // logs of several test runs can follow each other
+            if( static_cast<char>( type ) == s_log_header[0] ) {
+                m_input.unget();
+                if( !read_header() )
+                    throw std::runtime_error( "corrupted binary log header" );
+                continue;
+            }
+
+            read_payload();
+            dispatch( static_cast<binary_log_formatter::record_type>( type ) );
+        }
+    }
+
+private:
+    bool            read_header()
+    {
+        char header[s_log_header_size];
+
+        if( !m_input.read( header, s_log_header_size ) || !std::equal( header, header + s_log_header_size, s_log_header ) )
+            return false;
+
+        // file and test unit ids are local to a log
+        m_files.clear();
+        m_units.clear();
+
+        return true;
+    }
+
+    void            read_payload()
+    {
+        unsigned long size = 0;
+        for( int shift = 0; ; shift += 7 ) {
+            int byte = m_input.get();
+            if( byte == std::char_traits<char>::eof() || shift > 63 )
+                throw std::runtime_error( "truncated binary log record" );
+
+            size |= static_cast<unsigned long>( byte & 0x7f ) << shift;
+            if( (byte & 0x80) == 0 )
+                break;
+        }
+
+        m_payload.resize( size );
+        if( size != 0 && !m_input.read( &m_payload[0], static_cast<std::streamsize>( size ) ) )
+            throw std::runtime_error( "truncated binary log record" );
+
+        m_pos = 0;
+    }
+
+    unsigned long   get_num()
+    {
+        unsigned long value = 0;
+        for( int shift = 0; ; shift += 7 ) {
+            if( m_pos >= m_payload.size() || shift > 63 )
+                throw std::runtime_error( "malformed binary log record" );
+
+            unsigned char byte = static_cast<unsigned char>( m_payload[m_pos++] );
+            value |= static_cast<unsigned long>( byte & 0x7f ) << shift;
+            if( (byte & 0x80) == 0 )
+                return value;
+        }
+    }
+
+    // refers to the payload, until the next record is read
+    const_string    get_string()
+    {
+        unsigned long size = get_num();
+        if( size > m_payload.size() - m_pos )
+            throw std::runtime_error( "malformed binary log record" );
+
+        const_string res( m_payload.data() + m_pos, size );
+        m_pos += size;
+
+        return res;
+    }
+
+    const_string    get_file()
+    {
+        unsigned long id = get_num();
+        if( id > m_files.size() )
+            throw std::runtime_error( "undefined file in binary log" );
+
+        return id == 0 ? const_string() : const_string( m_files[id-1] );
+    }
+
+    test_unit&      get_unit()
+    {
+        return framework::get( get_unit_id(), TUT_ANY );
+    }
+
+    test_unit_id    get_unit_id()
+    {
+        test_unit_id id = static_cast<test_unit_id>( get_num() );
+        if( id == INV_TEST_UNIT_ID )
+            return id;
+
+        std::map<test_unit_id,test_unit_id>::const_iterator it = m_units.find( id );
+        if( it == m_units.end() )
+            throw std::runtime_error( "undefined test unit in binary log" );
+
+        return it->second;
+    }
+
+    bool            units_logged() const    { return m_formatter.get_log_level() <= log_test_units; }
+    bool            logged( log_level l ) const
+    {
+        return l >= m_recorded_level && l >= m_formatter.get_log_level() && m_formatter.get_log_level() != log_nothing;
+    }
+
+    void            dispatch( binary_log_formatter::record_type type );
+    void            define_unit();
+
+    // Data members
+    std::istream&               m_input;
+    unit_test_log_formatter&    m_formatter;
+    std::ostream&               m_output;
+
+    std::string                 m_payload;
+    std::size_t                 m_pos;
+
+    std::deque<std::string>     m_files;        // referred to by the rebuilt test units
+    std::map<test_unit_id,test_unit_id> m_units;    // recorded id -> rebuilt id
+
+    log_level                   m_recorded_level;
+    bool                        m_entry_logged;
+    bool                        m_exception_logged;
+    log_entry_data              m_entry_data;
+    log_checkpoint_data         m_checkpoint_data;
+    std::string                 m_function;
+};
+
+//____________________________________________________________________________//
+
+void
+binary_log_decoder::define_unit()
+{
+    test_unit_id    id              = static_cast<test_unit_id>( get_num() );
+    test_unit_id    parent_id       = get_unit_id();
+    unsigned long   type            = get_num();
+    const_string    name            = get_string();
+    const_string    file            = get_file();
+    std::size_t     line            = get_num();
+    counter_t       exp_failures    = get_num();
+    bool            enabled         = get_num() != 0;
+
+    test_unit* tu;
+    if( type == binary_log_formatter::BLU_CASE )
+        tu = new test_case( name, file, line, boost::function<void ()>( &no_op_test ) );
+    else if( type != binary_log_formatter::BLU_MODULE )
+        tu = new test_suite( name, file, line );
+    else if( framework::master_test_suite().size() == 0 ) {
+        // the decoder has no test tree of its own: the test units are named relatively to the master test suite
+        tu = &framework::master_test_suite();
+        tu->p_name.value = std::string( name.begin(), name.end() );
+    }
+    else
+        tu = new decoded_module( name );
+
+    if( parent_id != INV_TEST_UNIT_ID )
+        static_cast<test_suite&>( framework::get( parent_id, TUT_SUITE ) ).add( tu );
+
+    tu->p_expected_failures.value   = exp_failures;
+    tu->p_run_status.value          = enabled ? test_unit::RS_ENABLED : test_unit::RS_DISABLED;
+
+    m_units[id] = tu->p_id;
+}
+
+//____________________________________________________________________________//
+
+void
+binary_log_decoder::dispatch( binary_log_formatter::record_type type )
+{
+    switch( type ) {
+    case binary_log_formatter::BLR_LOG_START: {
+        m_recorded_level = static_cast<log_level>( get_num() );
+        counter_t test_cases_amount = get_num();
+
+        results_collector.test_start( test_cases_amount );
+
+        if( m_formatter.get_log_level() != log_nothing )
+            m_formatter.log_start( m_output, test_cases_amount );
+        break;
+    }
+    case binary_log_formatter::BLR_LOG_FINISH:
+        if( m_formatter.get_log_level() != log_nothing ) {
+            m_formatter.log_finish( m_output );
+            m_output.flush();
+        }
+        break;
+    case binary_log_formatter::BLR_BUILD_INFO:
+        // the build information is the one of the decoder
+        if( m_formatter.get_log_level() != log_nothing )
+            m_formatter.log_build_info( m_output );
+        break;
+    case binary_log_formatter::BLR_FILE:
+        if( get_num() != m_files.size() + 1 )
+            throw std::runtime_error( "unexpected file id in binary log" );
+
+        {
+            const_string file_name = get_string();
+            m_files.push_back( std::string( file_name.begin(), file_name.end() ) );
+        }
+        break;
+    case binary_log_formatter::BLR_UNIT:
+        define_unit();
+        break;
+    case binary_log_formatter::BLR_UNIT_START: {
+        test_unit& tu = get_unit();
+
+        if( units_logged() )
+            m_formatter.test_unit_start( m_output, tu );
+
+        results_collector.test_unit_start( tu );
+        break;
+    }
+    case binary_log_formatter::BLR_UNIT_FINISH: {
+        test_unit&      tu                  = get_unit();
+        unsigned long   elapsed             = get_num();
+        counter_t       assertions_passed   = get_num();
+        counter_t       assertions_failed   = get_num();
+        counter_t       warnings_failed     = get_num();
+
+        // the assertions of the test suites are the ones of their test cases
+        if( tu.p_type == TUT_CASE ) {
+            framework::impl::set_thread_test_case( tu.p_id );
+
+            for( counter_t i = 0; i < assertions_passed; ++i )
+                results_collector.assertion_result( AR_PASSED );
+            for( counter_t i = 0; i < assertions_failed; ++i )
+                results_collector.assertion_result( AR_FAILED );
+            for( counter_t i = 0; i < warnings_failed; ++i )
+                results_collector.assertion_result( AR_TRIGGERED );
+        }
+
+        results_collector.test_unit_finish( tu, elapsed );
+
+        if( units_logged() )
+            m_formatter.test_unit_finish( m_output, tu, elapsed );
+        break;
+    }
+    case binary_log_formatter::BLR_UNIT_SKIPPED: {
+        test_unit&   tu     = get_unit();
+        const_string reason = get_string();
+
+        if( units_logged() )
+            m_formatter.test_unit_skipped( m_output, tu, reason );
+
+        results_collector.test_unit_skipped( tu, reason );
+        break;
+    }
+    case binary_log_formatter::BLR_UNIT_ABORTED: {
+        test_unit& tu = get_unit();
+
+        if( units_logged() )
+            m_formatter.test_unit_aborted( m_output, tu );
+
+        results_collector.test_unit_aborted( tu );
+        break;
+    }
+    case binary_log_formatter::BLR_EXCEPTION_START: {
+        test_unit_id    tc_id           = get_unit_id();
+        execution_exception::error_code code = static_cast<execution_exception::error_code>( get_num() );
+        const_string    what            = get_string();
+        const_string    file            = get_file();
+        std::size_t     line            = get_num();
+        const_string    function        = get_string();
+
+        m_checkpoint_data.m_file_name   = get_file();
+        m_checkpoint_data.m_line_num    = get_num();
+        assign_op( m_checkpoint_data.m_message, get_string(), 0 );
+
+        m_exception_logged = logged( exception_log_level( code ) );
+        if( !m_exception_logged )
+            break;
+
+        // the location refers to null terminated strings
+        m_function.assign( function.begin(), function.end() );
+
+        framework::impl::set_thread_test_case( tc_id );
+        m_formatter.log_exception_start( m_output, m_checkpoint_data,
+            execution_exception( code, what,
+                execution_exception::location( file.is_empty() ? 0 : file.begin(), line, m_function.empty() ? 0 : m_function.c_str() ) ) );
+        break;
+    }
+    case binary_log_formatter::BLR_EXCEPTION_FINISH:
+        if( m_exception_logged )
+            m_formatter.log_exception_finish( m_output );
+        m_exception_logged = false;
+        break;
+    case binary_log_formatter::BLR_ENTRY_START: {
+        test_unit_id    tc_id   = get_unit_id();
+        unit_test_log_formatter::log_entry_types let = static_cast<unit_test_log_formatter::log_entry_types>( get_num() );
+
+        m_entry_data.clear();
+        m_entry_data.m_level    = static_cast<log_level>( get_num() );
+        assign_op( m_entry_data.m_file_name, get_file(), 0 );
+        m_entry_data.m_line_num = get_num();
+
+        m_entry_logged = logged( m_entry_data.m_level );
+        if( !m_entry_logged )
+            break;
+
+        framework::impl::set_thread_test_case( tc_id );
+        m_formatter.log_entry_start( m_output, m_entry_data, let );
+        break;
+    }
+    case binary_log_formatter::BLR_ENTRY_VALUE:
+        if( m_entry_logged )
+            m_formatter.log_entry_value( m_output, get_string() );
+        break;
+    case binary_log_formatter::BLR_ENTRY_FINISH:
+        if( m_entry_logged )
+            m_formatter.log_entry_finish( m_output );
+        m_entry_logged = false;
+        break;
+    case binary_log_formatter::BLR_CONTEXT_START:
+        if( m_entry_logged || m_exception_logged )
+            m_formatter.entry_context_start( m_output, static_cast<log_level>( get_num() ) );
+        break;
+    case binary_log_formatter::BLR_CONTEXT_FRAME:
+        if( m_entry_logged || m_exception_logged )
+            m_formatter.log_entry_context( m_output, get_string() );
+        break;
+    case binary_log_formatter::BLR_CONTEXT_FINISH:
+        if( m_entry_logged || m_exception_logged )
+            m_formatter.entry_context_finish( m_output );
+        break;
+    default:
+        // records of later versions of the format are skipped
+        break;
+    }
+}
+
+//____________________________________________________________________________//
+
+// the events are reported as during the execution of the test tree, by its current test case
+struct replay_guard {
+    replay_guard()
+    : m_was_in_progress( framework::test_in_progress() )
+    , m_curr_test_case( framework::current_test_case_id() )
+    {
+        framework::impl::set_test_in_progress( true );
+    }
+    ~replay_guard()
+    {
+        framework::impl::set_thread_test_case( m_curr_test_case );
+        framework::impl::set_test_in_progress( m_was_in_progress );
+    }
+
+    bool            m_was_in_progress;
+    test_unit_id    m_curr_test_case;
+};
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+void
+decode_binary_log( std::istream& input, unit_test_log_formatter& formatter, std::ostream& output )
+{
+    replay_guard G;
+
+    binary_log_decoder( input, formatter, output ).decode();
+}
+
+//____________________________________________________________________________//
+
+} // namespace output
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_BINARY_LOG_FORMATTER_IPP_110917GER
@@ -162,6 +162,14 @@ compiler_log_formatter::log_exception_start( std::ostream& output, log_checkpoin
         if( !checkpoint_data.m_message.empty() )
             output << ": " << checkpoint_data.m_message;
     }
+
+    if( !ex.backtrace().empty() ) {
+        std::vector<std::string> const frames = ex.backtrace().symbolize();
+
+        output << "\ncall stack:";
+        for( std::size_t i = 0; i < frames.size(); ++i )
+            output << "\n    #" << i << ' ' << frames[i];
+    }
 }
 
 //____________________________________________________________________________//
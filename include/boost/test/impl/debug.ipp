@@ -54,6 +54,7 @@ namespace std { using ::memset; using ::sprintf; }
 
 // STL
 #include <cstring>  // std::memcpy
+#include <algorithm>
 #include <map>
 #include <cstdio>
 #include <stdarg.h> // !! ?? cstdarg
@@ -88,6 +89,7 @@ namespace std { using ::memset; using ::sprintf; }
 #    define BOOST_LINUX_BASED_DEBUG
 
 #    include <sys/ptrace.h>
+#    include <sys/resource.h>
 
 #    ifndef BOOST_TEST_STAT_LINE_MAX
 #      define BOOST_TEST_STAT_LINE_MAX 500
@@ -1000,6 +1002,85 @@ break_memory_alloc( long mem_alloc_order_num )
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************             process memory usage             ************** //
+// ************************************************************************** //
+
+bool
+memory_usage( process_memory_usage& usage )
+{
+#if defined(BOOST_LINUX_BASED_DEBUG) // ************************ LINUX
+    std::size_t const page_size = static_cast<std::size_t>( ::sysconf( _SC_PAGESIZE ) );
+
+    // resident pages are the second field of statm
+    char buff[1024];
+    fd_holder statm_fd( ::open( "/proc/self/statm", O_RDONLY ) );
+    if( statm_fd == -1 )
+        return false;
+
+    ssize_t num_read = ::read( statm_fd, buff, sizeof(buff)-1 );
+    if( num_read <= 0 )
+        return false;
+    buff[num_read] = 0;
+
+    unsigned long resident_pages = 0;
+    if( std::sscanf( buff, "%*u %lu", &resident_pages ) != 1 )
+        return false;
+
+    usage.m_resident_bytes      = resident_pages * page_size;
+    usage.m_peak_resident_bytes = usage.m_resident_bytes;
+
+    // the peak is the VmHWM line of status, in kB
+    std::FILE* status = std::fopen( "/proc/self/status", "r" );
+    if( status ) {
+        unsigned long peak_kb = 0;
+        while( std::fgets( buff, sizeof(buff), status ) ) {
+            if( std::sscanf( buff, "VmHWM: %lu kB", &peak_kb ) == 1 ) {
+                usage.m_peak_resident_bytes = (std::max)( usage.m_resident_bytes, static_cast<std::size_t>( peak_kb ) * 1024 );
+                break;
+            }
+        }
+        std::fclose( status );
+    }
+
+    struct rusage ru;
+    if( ::getrusage( RUSAGE_SELF, &ru ) != 0 )
+        return false;
+
+    usage.m_minor_page_faults = static_cast<unsigned long>( ru.ru_minflt );
+    usage.m_major_page_faults = static_cast<unsigned long>( ru.ru_majflt );
+
+    return true;
+#else // ****************************************************** default
+    unit_test::ut_detail::ignore_unused_variable_warning( usage );
+
+    return false;
+#endif
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************           reset peak memory usage            ************** //
+// ************************************************************************** //
+
+bool
+reset_peak_memory_usage()
+{
+#if defined(BOOST_LINUX_BASED_DEBUG) // ************************ LINUX
+    // "5" resets the peak resident memory of the process since Linux 4.0
+    fd_holder clear_refs_fd( ::open( "/proc/self/clear_refs", O_WRONLY ) );
+    if( clear_refs_fd == -1 )
+        return false;
+
+    return ::write( clear_refs_fd, "5", 1 ) == 1;
+#else // ****************************************************** default
+    return false;
+#endif
+}
+
+//____________________________________________________________________________//
+
 } // namespace debug
 } // namespace boost
 
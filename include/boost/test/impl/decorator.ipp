@@ -105,6 +105,9 @@ expected_failures::apply( test_unit& tu )
 void
 timeout::apply( test_unit& tu )
 {
+    BOOST_TEST_SETUP_ASSERT( m_timeout >= 0,
+                             "timeout decorator of " + tu.full_name() + " requires a non negative number of seconds" );
+
     tu.p_timeout.value = m_timeout;
 }
 
@@ -193,6 +196,101 @@ precondition::apply( test_unit& tu )
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************          decorator::max_regression           ************** //
+// ************************************************************************** //
+
+void
+max_regression::apply( test_unit& tu )
+{
+    BOOST_TEST_SETUP_ASSERT( tu.p_type == TUT_CASE,
+                             "max_regression decorator can only be applied to test cases, not to " + tu.full_name() );
+    BOOST_TEST_SETUP_ASSERT( m_max_ratio > 0 && m_repeats > 0,
+                             "max_regression decorator of " + tu.full_name() + " requires a positive ratio and number of repeats" );
+
+    tu.p_max_regression.value     = m_max_ratio;
+    tu.p_regression_repeats.value = m_repeats;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************          decorator::max_allocations          ************** //
+// ************************************************************************** //
+
+void
+max_allocations::apply( test_unit& tu )
+{
+    BOOST_TEST_SETUP_ASSERT( tu.p_type == TUT_CASE,
+                             "max_allocations decorator can only be applied to test cases, not to " + tu.full_name() );
+    BOOST_TEST_SETUP_ASSERT( m_max_count != NO_ALLOCATION_LIMIT,
+                             "max_allocations decorator of " + tu.full_name() + " requires a finite number of allocations" );
+
+    tu.p_max_allocations.value = m_max_count;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************           decorator::memory_budget           ************** //
+// ************************************************************************** //
+
+void
+memory_budget::apply( test_unit& tu )
+{
+    BOOST_TEST_SETUP_ASSERT( tu.p_type == TUT_CASE,
+                             "memory_budget decorator can only be applied to test cases, not to " + tu.full_name() );
+    BOOST_TEST_SETUP_ASSERT( m_max_bytes > 0,
+                             "memory_budget decorator of " + tu.full_name() + " requires a positive number of bytes" );
+
+    tu.p_memory_budget.value = m_max_bytes;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************              decorator::serial               ************** //
+// ************************************************************************** //
+
+void
+serial::apply( test_unit& tu )
+{
+    tu.p_serial.value = true;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************           decorator::lazy_samples            ************** //
+// ************************************************************************** //
+
+void
+lazy_samples::apply( test_unit& tu )
+{
+    // the data test case is made lazy when its generator is registered, which happens after the decorators are stored
+    BOOST_TEST_SETUP_ASSERT( tu.p_type == TUT_SUITE && static_cast<test_suite&>(tu).is_lazy(),
+                             "lazy_samples decorator can only be applied to data test cases, not to " + tu.full_name() );
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************           decorator::data_parallel           ************** //
+// ************************************************************************** //
+
+void
+data_parallel::apply( test_unit& tu )
+{
+    BOOST_TEST_SETUP_ASSERT( tu.p_type == TUT_SUITE,
+                             "data_parallel decorator can only be applied to data test cases and test suites, not to " + tu.full_name() );
+    BOOST_TEST_SETUP_ASSERT( m_workers > 0,
+                             "data_parallel decorator of " + tu.full_name() + " requires a positive number of threads" );
+
+    tu.p_data_parallel.value = m_workers;
+}
+
+//____________________________________________________________________________//
+
 } // namespace decorator
 } // namespace unit_test
 } // namespace boost
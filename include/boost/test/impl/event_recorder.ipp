@@ -0,0 +1,392 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements the recorder of the test events produced outside of the thread driving
+//                the test tree
+// ***************************************************************************
+
+#ifndef BOOST_TEST_EVENT_RECORDER_IPP_101826GER
+#define BOOST_TEST_EVENT_RECORDER_IPP_101826GER
+
+// Boost.Test
+#include <boost/test/tree/event_recorder.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/alloc_monitor.hpp>
+
+#include <boost/test/tree/test_unit.hpp>
+
+#include <boost/test/utils/foreach.hpp>
+#include <boost/test/utils/lazy_ostream.hpp>
+#include <boost/test/utils/wrap_stringstream.hpp>
+
+// STL
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace framework {
+namespace impl {
+
+// ************************************************************************** //
+// **************                event_recorder                ************** //
+// ************************************************************************** //
+
+event_recorder::event_recorder( unit_test::log_level threshold )
+: m_threshold( threshold )
+, m_entry_level( invalid_log_level )
+, m_entry_start( std::string::npos )
+, m_entry_has_values( false )
+, m_checkpoint( ET_CHECKPOINT )
+, m_has_checkpoint( false )
+{
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::log_begin( const_string file_name, std::size_t line_num )
+{
+    if( m_entry_start != std::string::npos )
+        log_end();
+
+    m_entry_start       = m_events.size();
+    m_entry_level       = invalid_log_level;
+    m_entry_has_values  = false;
+
+    m_events.push_back( event( ET_LOG_BEGIN ) );
+    m_events.back().m_file.assign( file_name.begin(), file_name.end() );
+    m_events.back().m_num = line_num;
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::log_level( unit_test::log_level l )
+{
+    m_entry_level = l;
+
+    m_events.push_back( event( ET_LOG_LEVEL ) );
+    m_events.back().m_code = l;
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::log_value( const_string value )
+{
+    // the entry is not going to be reported by any logger
+    if( m_entry_level < m_threshold || value.is_empty() )
+        return;
+
+    m_entry_has_values = true;
+
+    m_events.push_back( event( ET_LOG_VALUE ) );
+    m_events.back().m_text.assign( value.begin(), value.end() );
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::log_value( lazy_ostream const& value )
+{
+    if( m_entry_level < m_threshold || value.empty() )
+        return;
+
+    m_entry_has_values = true;
+
+    m_events.push_back( event( ET_LOG_VALUE ) );
+    m_events.back().m_text = (wrap_stringstream().ref() << value).str();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::log_end()
+{
+    if( m_entry_start == std::string::npos )
+        return;
+
+    // drop entries without any value
+    if( !m_entry_has_values )
+        m_events.erase( m_events.begin() + m_entry_start, m_events.end() );
+    else {
+        m_events.push_back( event( ET_LOG_END ) );
+        record_context( m_events.back() );
+    }
+
+    m_entry_start = std::string::npos;
+
+    release();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::set_checkpoint( const_string file_name, std::size_t line_num, const_string msg )
+{
+    // each assertion sets a checkpoint, while only the last one matters to the exception caught next
+    m_checkpoint.m_file.assign( file_name.begin(), file_name.end() );
+    m_checkpoint.m_num = line_num;
+    m_checkpoint.m_text.assign( msg.begin(), msg.end() );
+    m_has_checkpoint = true;
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::record_checkpoint()
+{
+    if( !m_has_checkpoint )
+        return;
+
+    m_events.push_back( m_checkpoint );
+    m_has_checkpoint = false;
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::assertion_result( unit_test::assertion_result ar )
+{
+    // consecutive identical results are recorded once
+    if( !m_events.empty() && m_events.back().m_type == ET_ASSERTION && m_events.back().m_code == ar ) {
+        ++m_events.back().m_num;
+        return;
+    }
+
+    m_events.push_back( event( ET_ASSERTION ) );
+    m_events.back().m_code = ar;
+    m_events.back().m_num  = 1;
+
+    release();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::exception_caught( execution_exception const& ex )
+{
+    record_checkpoint();
+
+    m_events.push_back( event( ET_EXCEPTION ) );
+
+    event& e = m_events.back();
+    e.m_code = ex.code();
+    e.m_text.assign( ex.what().begin(), ex.what().end() );
+    e.m_file.assign( ex.where().m_file_name.begin(), ex.where().m_file_name.end() );
+    e.m_num  = ex.where().m_line_num;
+    e.m_function.assign( ex.where().m_function.begin(), ex.where().m_function.end() );
+    for( std::size_t i = 0; i < ex.backtrace().size(); ++i )
+        e.m_backtrace.push_back( ex.backtrace().frame( i ) );
+    record_context( e );
+
+    release();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::test_unit_aborted( test_unit const& tu )
+{
+    m_events.push_back( event( ET_ABORTED ) );
+    m_events.back().m_num = tu.p_id;
+
+    release();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::perf_counters_measured( test_case const& tc, perf_counters const& pcs )
+{
+    m_events.push_back( event( ET_PERF_COUNTERS ) );
+    m_events.back().m_code = static_cast<int>( pcs.m_measured );
+    m_events.back().m_num  = tc.p_id;
+    m_events.back().m_values.assign( pcs.m_values, pcs.m_values + PC_COUNT );
+
+    release();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::allocations_measured( test_case const& tc, alloc_stats const& as )
+{
+    m_events.push_back( event( ET_ALLOCATIONS ) );
+    m_events.back().m_code = as.m_measured ? 1 : 0;
+    m_events.back().m_num  = tc.p_id;
+
+    std::vector<counter_t>& values = m_events.back().m_values;
+    values.push_back( as.m_allocations );
+    values.push_back( as.m_bytes );
+    values.push_back( as.m_peak_bytes );
+    values.push_back( as.m_leaked_blocks );
+
+    release();
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::record_context( event& e ) const
+{
+    context_generator const& context = framework::get_context();
+
+    const_string frame;
+    while( !(frame = context.next()).is_empty() )
+        e.m_context.push_back( std::string( frame.begin(), frame.end() ) );
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::replay() const
+{
+    BOOST_TEST_FOREACH( event const&, e, m_events ) {
+        switch( e.m_type ) {
+        case ET_LOG_BEGIN:
+            unit_test_log << log::begin( e.m_file, e.m_num );
+            break;
+        case ET_LOG_LEVEL:
+            unit_test_log << static_cast<unit_test::log_level>( e.m_code );
+            break;
+        case ET_LOG_VALUE:
+            unit_test_log << const_string( e.m_text );
+            break;
+        case ET_LOG_END:
+            BOOST_TEST_FOREACH( std::string const&, frame, e.m_context )
+                framework::add_context( BOOST_TEST_LAZY_MSG( frame ), false );
+
+            unit_test_log << log::end();
+            break;
+        case ET_CHECKPOINT:
+            unit_test_log.set_checkpoint( e.m_file, e.m_num, e.m_text );
+            break;
+        case ET_ASSERTION:
+            for( std::size_t i = 0; i < e.m_num; ++i )
+                framework::assertion_result( static_cast<unit_test::assertion_result>( e.m_code ) );
+            break;
+        case ET_EXCEPTION:
+            BOOST_TEST_FOREACH( std::string const&, frame, e.m_context )
+                framework::add_context( BOOST_TEST_LAZY_MSG( frame ), false );
+
+            framework::exception_caught( execution_exception(
+                static_cast<execution_exception::error_code>( e.m_code ),
+                e.m_text,
+                execution_exception::location( e.m_file.c_str(), e.m_num, e.m_function.empty() ? 0 : e.m_function.c_str() ),
+                stack_trace( e.m_backtrace.empty() ? 0 : &e.m_backtrace[0], e.m_backtrace.size() ) ) );
+
+            framework::clear_context();
+            break;
+        case ET_ABORTED:
+            framework::test_unit_aborted( framework::get( static_cast<test_unit_id>( e.m_num ), TUT_ANY ) );
+            break;
+        case ET_PERF_COUNTERS: {
+            perf_counters pcs;
+            std::copy( e.m_values.begin(), e.m_values.begin() + (std::min)( e.m_values.size(), std::size_t( PC_COUNT ) ),
+                       pcs.m_values );
+            pcs.m_measured = static_cast<unsigned>( e.m_code );
+
+            framework::perf_counters_measured( framework::get<test_case>( static_cast<test_unit_id>( e.m_num ) ), pcs );
+            break;
+        }
+        case ET_ALLOCATIONS: {
+            alloc_stats as;
+            if( e.m_values.size() == 4 ) {
+                as.m_allocations    = e.m_values[0];
+                as.m_bytes          = e.m_values[1];
+                as.m_peak_bytes     = e.m_values[2];
+                as.m_leaked_blocks  = e.m_values[3];
+            }
+            as.m_measured = e.m_code != 0;
+
+            framework::allocations_measured( framework::get<test_case>( static_cast<test_unit_id>( e.m_num ) ), as );
+            break;
+        }
+        }
+    }
+
+    if( m_has_checkpoint )
+        unit_test_log.set_checkpoint( m_checkpoint.m_file, m_checkpoint.m_num, m_checkpoint.m_text );
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::clear()
+{
+    m_events.clear();
+    m_entry_start = std::string::npos;
+    m_has_checkpoint = false;
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::release()
+{
+    if( !m_sink )
+        return;
+
+    // the log entry in progress is incomplete and the last passed assertion is likely to be repeated
+    std::size_t complete = m_entry_start != std::string::npos ? m_entry_start : m_events.size();
+    if( complete == m_events.size() && complete > 0 &&
+        m_events.back().m_type == ET_ASSERTION && m_events.back().m_code == AR_PASSED )
+        --complete;
+
+    if( complete == 0 )
+        return;
+
+    for( std::size_t i = 0; i < complete; ++i )
+        m_sink( m_events[i] );
+
+    m_events.erase( m_events.begin(), m_events.begin() + complete );
+
+    if( m_entry_start != std::string::npos )
+        m_entry_start -= complete;
+}
+
+//____________________________________________________________________________//
+
+void
+event_recorder::flush()
+{
+    log_end();
+    record_checkpoint();
+
+    if( !m_sink )
+        return;
+
+    BOOST_TEST_FOREACH( event const&, e, m_events )
+        m_sink( e );
+
+    m_events.clear();
+}
+
+//____________________________________________________________________________//
+
+} // namespace impl
+} // namespace framework
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_EVENT_RECORDER_IPP_101826GER
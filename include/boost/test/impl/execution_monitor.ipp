@@ -48,9 +48,15 @@
 #include <cstddef>              // for NULL
 #include <cstdio>               // for vsnprintf
 #include <cstdarg>              // for varargs
+#include <cmath>                // for std::ceil
+#include <cstdlib>              // for std::free
 
 #include <iostream>              // for varargs
 
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <mutex>
+#endif
+
 #ifdef BOOST_NO_STDC_NAMESPACE
 namespace std { using ::strerror; using ::strlen; using ::strncat; }
 #endif
@@ -128,6 +134,7 @@ namespace { void _set_se_translator( void* ) {} }
 #  include <unistd.h>
 #  include <signal.h>
 #  include <setjmp.h>
+#  include <sys/time.h>
 
 #  if defined(__FreeBSD__)
 
@@ -171,6 +178,30 @@ namespace { void _set_se_translator( void* ) {} }
 #    define BOOST_TEST_ALT_STACK_SIZE SIGSTKSZ
 #  endif
 
+// the timeouts are implemented with a timer per thread where the timer signals can be sent to a specific thread
+#  if defined(__linux__) && defined(SIGEV_THREAD_ID) && defined(SIGRTMIN)
+#    define BOOST_TEST_USE_THREAD_TIMER
+#    include <time.h>
+#    include <sys/syscall.h>
+#    ifndef sigev_notify_thread_id
+#      define sigev_notify_thread_id _sigev_un._tid
+#    endif
+#  endif
+
+#  if defined(__GLIBC__)
+#    define BOOST_TEST_USE_BACKTRACE
+#    include <execinfo.h>
+#    include <boost/core/demangle.hpp>
+#  endif
+
+// the call stack of the C++ exceptions is captured by the function of the GNU C++ library throwing them, on demand
+#  if defined(BOOST_TEST_USE_BACKTRACE) && defined(__GLIBCXX__) && !defined(BOOST_NO_EXCEPTIONS) && \
+      !defined(BOOST_NO_RTTI) && defined(BOOST_TEST_ENABLE_THROW_BACKTRACE)
+#    define BOOST_TEST_USE_THROW_BACKTRACE
+#    include <cxxabi.h>
+#    include <dlfcn.h>
+#  endif
+
 
 #else
 
@@ -216,6 +247,126 @@ namespace detail {
 #  define BOOST_TEST_VSNPRINTF( a1, a2, a3, a4 ) vsnprintf( (a1), (a2), (a3), (a4) )
 #endif
 
+// ************************************************************************** //
+// **************               failure_backtrace              ************** //
+// ************************************************************************** //
+
+// Call stack of the last failure of the thread, captured by the signal handler or where the last C++ exception was
+// thrown, while the capture is enabled. It is plain data, which the signal handler can write without allocating.
+struct failure_backtrace {
+    void*               m_frames[stack_trace::max_frames];
+    std::size_t         m_size;
+    bool                m_enabled;
+};
+
+static BOOST_TEST_THREAD_LOCAL failure_backtrace s_failure_backtrace;
+
+//____________________________________________________________________________//
+
+// captures the call stack of the caller, without the specified amount of innermost frames
+BOOST_NOINLINE static void
+capture_failure_backtrace( std::size_t skip )
+{
+#ifdef BOOST_TEST_USE_BACKTRACE
+    failure_backtrace& fb = s_failure_backtrace;
+    if( !fb.m_enabled )
+        return;
+
+    // this function is skipped as well
+    void*       frames[stack_trace::max_frames + 8];
+    std::size_t captured = static_cast<std::size_t>( ::backtrace( frames, stack_trace::max_frames + 8 ) );
+    std::size_t first    = (std::min)( skip + 1, captured );
+
+    fb.m_size = (std::min)( captured - first, static_cast<std::size_t>( stack_trace::max_frames ) );
+    std::memcpy( fb.m_frames, frames + first, fb.m_size * sizeof(void*) );
+#else
+    ignore_unused( skip );
+#endif
+}
+
+//____________________________________________________________________________//
+
+// the call stack captured for the failure being reported, if any; it is not attached to the next failures
+static stack_trace
+take_failure_backtrace()
+{
+    failure_backtrace& fb = s_failure_backtrace;
+
+    stack_trace res( fb.m_frames, fb.m_size );
+    fb.m_size = 0;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_USE_BACKTRACE
+
+static void
+load_unwinder()
+{
+    void* frame;
+    ::backtrace( &frame, 1 );
+}
+
+#endif
+
+// The first call of backtrace may allocate and load the unwinder, which can't be done safely from the signal
+// handler: it is done once, by the first thread monitoring a function, before the handlers are installed
+static void
+preload_unwinder()
+{
+#ifdef BOOST_TEST_USE_BACKTRACE
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    static std::once_flag s_loaded;
+    std::call_once( s_loaded, &load_unwinder );
+#else
+    static bool s_loaded = false;
+    if( !s_loaded ) {
+        load_unwinder();
+        s_loaded = true;
+    }
+#endif
+#endif
+}
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_USE_THROW_BACKTRACE
+
+typedef void (*cxa_throw_t)( void*, std::type_info*, void (_GLIBCXX_CDTOR_CALLABI*)( void* ) );
+
+// the function of the C++ library throwing the exceptions, if it can be found after the interposed one
+static cxa_throw_t
+next_cxa_throw()
+{
+    static cxa_throw_t const s_next = reinterpret_cast<cxa_throw_t>( ::dlsym( RTLD_NEXT, "__cxa_throw" ) );
+
+    return s_next;
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+// enables the capture of the call stack while a function is monitored
+struct backtrace_capture_guard {
+    explicit backtrace_capture_guard( bool enabled )
+    : m_was_enabled( s_failure_backtrace.m_enabled )
+    {
+        s_failure_backtrace.m_enabled   = enabled;
+        s_failure_backtrace.m_size      = 0;
+    }
+    ~backtrace_capture_guard()
+    {
+        s_failure_backtrace.m_enabled   = m_was_enabled;
+    }
+
+    bool m_was_enabled;
+};
+
+//____________________________________________________________________________//
+
 #ifndef BOOST_NO_EXCEPTIONS
 
 template <typename ErrorInfo>
@@ -236,7 +387,7 @@ static void
 report_error( execution_exception::error_code ec, boost::exception const* be, char const* format, va_list* args )
 {
     static const int REPORT_ERROR_BUFFER_SIZE = 4096;
-    static char buf[REPORT_ERROR_BUFFER_SIZE];
+    static BOOST_TEST_THREAD_LOCAL char buf[REPORT_ERROR_BUFFER_SIZE];
 
     BOOST_TEST_VSNPRINTF( buf, sizeof(buf)-1, format, *args );
     buf[sizeof(buf)-1] = 0;
@@ -245,7 +396,8 @@ report_error( execution_exception::error_code ec, boost::exception const* be, ch
 
     BOOST_TEST_I_THROW(execution_exception( ec, buf, execution_exception::location( extract<throw_file>( be ),
                                                                                     (size_t)extract<throw_line>( be ),
-                                                                                    extract<throw_function>( be ) ) ));
+                                                                                    extract<throw_function>( be ) ),
+                                            take_failure_backtrace() ));
 }
 
 //____________________________________________________________________________//
@@ -328,6 +480,19 @@ typeid_name( T const& t )
 
 namespace detail {
 
+// the signal raised when the timeout of a monitored function expires: the timers of the threads use a real-time
+// signal, which leaves SIGALRM to the monitored functions and is not mistaken for the first real-time signals that
+// some libraries use
+static int
+timeout_signal()
+{
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+    return SIGRTMIN + 3;
+#else
+    return SIGALRM;
+#endif
+}
+
 // ************************************************************************** //
 // **************    boost::detail::system_signal_exception    ************** //
 // ************************************************************************** //
@@ -362,6 +527,12 @@ system_signal_exception::report() const
     if( !m_sig_info )
         return; // no error actually occur?
 
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+    if( m_sig_info->si_signo == timeout_signal() && m_sig_info->si_code == SI_TIMER )
+        report_error( execution_exception::timeout_error,
+                      "signal: SIGRTMIN+%d (timeout while executing function)", timeout_signal() - SIGRTMIN );
+#endif
+
     switch( m_sig_info->si_code ) {
     case SI_USER:
         report_error( execution_exception::system_error,
@@ -614,8 +785,71 @@ system_signal_exception::report() const
 extern "C" {
 static void boost_execution_monitor_jumping_signal_handler( int sig, siginfo_t* info, void* context );
 static void boost_execution_monitor_attaching_signal_handler( int sig, siginfo_t* info, void* context );
+static void boost_execution_monitor_terminating_signal_handler( int sig, siginfo_t* info, void* context );
+}
+
+// ************************************************************************** //
+// **************        boost::detail::termination_hook       ************** //
+// ************************************************************************** //
+
+typedef void (*termination_hook_ptr)();
+
+static termination_hook_ptr&
+s_termination_hook() { static termination_hook_ptr the_inst = 0; return the_inst; }
+
+static bool
+is_terminating_signal( int sig )
+{
+    return sig == SIGILL || sig == SIGFPE || sig == SIGSEGV || sig == SIGBUS || sig == SIGABRT;
+}
+
+//____________________________________________________________________________//
+
+static bool
+is_terminating_action( struct sigaction const& action )
+{
+    return (action.sa_flags & SA_SIGINFO) != 0 && action.sa_sigaction == &boost_execution_monitor_terminating_signal_handler;
+}
+
+//____________________________________________________________________________//
+
+// outside of the monitored functions, the default action of the terminating signals is preceded by the termination hook
+static void
+restore_signal_action( int sig, struct sigaction const& old_action )
+{
+    struct sigaction action = old_action;
+
+    if( s_termination_hook() && is_terminating_signal( sig ) &&
+        (old_action.sa_flags & SA_SIGINFO) == 0 && old_action.sa_handler == SIG_DFL ) {
+        std::memset( &action, 0, sizeof(struct sigaction) );
+
+        action.sa_flags     = SA_SIGINFO;
+        action.sa_sigaction = &boost_execution_monitor_terminating_signal_handler;
+        sigemptyset( &action.sa_mask );
+    }
+
+    ::sigaction( sig, &action, 0 );
 }
 
+#ifdef BOOST_TEST_SUPPORT_THREADS
+
+// Signal actions are process wide, while the functions may be monitored by several threads at once:
+// the first thread installs the action and the last one restores the previous action
+struct shared_signal_actions {
+    shared_signal_actions() { std::memset( m_users, 0, sizeof(m_users) ); }
+
+    std::mutex          m_mutex;
+    int                 m_users[NSIG];
+    struct sigaction    m_old_actions[NSIG];
+};
+
+static shared_signal_actions&
+s_shared_signal_actions() { static shared_signal_actions the_inst; return the_inst; }
+
+#endif
+
+//____________________________________________________________________________//
+
 class signal_action {
     typedef struct sigaction* sigaction_ptr;
 public:
@@ -647,11 +881,21 @@ signal_action::signal_action( int sig, bool install, bool attach_dbg, char* alt_
     if( !install )
         return;
 
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    shared_signal_actions& shared = s_shared_signal_actions();
+    std::lock_guard<std::mutex> guard( shared.m_mutex );
+
+    if( shared.m_users[m_sig] > 0 ) {
+        ++shared.m_users[m_sig];
+        return;
+    }
+#endif
+
     std::memset( &m_new_action, 0, sizeof(struct sigaction) );
 
     BOOST_TEST_SYS_ASSERT( ::sigaction( m_sig , sigaction_ptr(), &m_new_action ) != -1 );
 
-    if( m_new_action.sa_sigaction || m_new_action.sa_handler ) {
+    if( (m_new_action.sa_sigaction || m_new_action.sa_handler) && !is_terminating_action( m_new_action ) ) {
         m_installed = false;
         return;
     }
@@ -667,14 +911,29 @@ signal_action::signal_action( int sig, bool install, bool attach_dbg, char* alt_
 #endif
 
     BOOST_TEST_SYS_ASSERT( ::sigaction( m_sig, &m_new_action, &m_old_action ) != -1 );
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    shared.m_users[m_sig]       = 1;
+    shared.m_old_actions[m_sig] = m_old_action;
+#endif
 }
 
 //____________________________________________________________________________//
 
 signal_action::~signal_action()
 {
-    if( m_installed )
-        ::sigaction( m_sig, &m_old_action , sigaction_ptr() );
+    if( !m_installed )
+        return;
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    shared_signal_actions& shared = s_shared_signal_actions();
+    std::lock_guard<std::mutex> guard( shared.m_mutex );
+
+    if( --shared.m_users[m_sig] == 0 )
+        restore_signal_action( m_sig, shared.m_old_actions[m_sig] );
+#else
+    restore_signal_action( m_sig, m_old_action );
+#endif
 }
 
 //____________________________________________________________________________//
@@ -686,7 +945,7 @@ signal_action::~signal_action()
 class signal_handler {
 public:
     // Constructor
-    explicit signal_handler( bool catch_system_errors, bool detect_fpe, unsigned timeout, bool attach_dbg, char* alt_stack );
+    explicit signal_handler( bool catch_system_errors, bool detect_fpe, double timeout, timeout_action on_timeout, bool attach_dbg, char* alt_stack );
 
     // Destructor
     ~signal_handler();
@@ -706,10 +965,18 @@ public:
         return s_active_handler->m_sys_sig;
     }
 
+    // called by the signal handler when the timeout expires; returns if the timeout is to be reported
+    static void             timeout_expired();
+
 private:
     // Data members
     signal_handler*         m_prev_handler;
-    unsigned                m_timeout;
+    double                  m_timeout;
+    timeout_action          m_on_timeout;
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+    timer_t                 m_timer;
+    bool                    m_timer_created;
+#endif
 
     // Note: We intentionality do not catch SIGCHLD. Users have to deal with it themselves
     signal_action           m_ILL_action;
@@ -719,23 +986,27 @@ private:
     signal_action           m_CHLD_action;
     signal_action           m_POLL_action;
     signal_action           m_ABRT_action;
-    signal_action           m_ALRM_action;
+    signal_action           m_timer_action;
 
     sigjmp_buf              m_sigjmp_buf;
     system_signal_exception m_sys_sig;
 
-    static signal_handler*  s_active_handler;
+    static BOOST_TEST_THREAD_LOCAL signal_handler*  s_active_handler;
 };
 
-// !! need to be placed in thread specific storage
+// each thread executing monitored functions has its own active handler
 typedef signal_handler* signal_handler_ptr;
-signal_handler* signal_handler::s_active_handler = signal_handler_ptr();
+BOOST_TEST_THREAD_LOCAL signal_handler* signal_handler::s_active_handler = signal_handler_ptr();
 
 //____________________________________________________________________________//
 
-signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, unsigned timeout, bool attach_dbg, char* alt_stack )
+signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, double timeout, timeout_action on_timeout, bool attach_dbg, char* alt_stack )
 : m_prev_handler( s_active_handler )
 , m_timeout( timeout )
+, m_on_timeout( on_timeout )
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+, m_timer_created( false )
+#endif
 , m_ILL_action ( SIGILL , catch_system_errors, attach_dbg, alt_stack )
 , m_FPE_action ( SIGFPE , detect_fpe         , attach_dbg, alt_stack )
 , m_SEGV_action( SIGSEGV, catch_system_errors, attach_dbg, alt_stack )
@@ -744,13 +1015,39 @@ signal_handler::signal_handler( bool catch_system_errors, bool detect_fpe, unsig
 , m_POLL_action( SIGPOLL, catch_system_errors, attach_dbg, alt_stack )
 #endif
 , m_ABRT_action( SIGABRT, catch_system_errors, attach_dbg, alt_stack )
-, m_ALRM_action( SIGALRM, timeout > 0        , attach_dbg, alt_stack )
+, m_timer_action( timeout_signal(), timeout > 0, attach_dbg, alt_stack )
 {
     s_active_handler = this;
 
     if( m_timeout > 0 ) {
-        ::alarm( 0 );
-        ::alarm( timeout );
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+        // the timer of this thread only interrupts this thread, the other threads can monitor functions at the same time
+        struct sigevent     sev;
+        std::memset( &sev, 0, sizeof(sev) );
+        sev.sigev_notify            = SIGEV_THREAD_ID;
+        sev.sigev_signo             = timeout_signal();
+        sev.sigev_notify_thread_id  = static_cast<pid_t>( ::syscall( SYS_gettid ) );
+
+        BOOST_TEST_SYS_ASSERT( ::timer_create( CLOCK_MONOTONIC, &sev, &m_timer ) != -1 );
+        m_timer_created = true;
+
+        double const        nsec = std::ceil( m_timeout * 1e9 );
+        ::itimerspec        its;
+        std::memset( &its, 0, sizeof(its) );
+        its.it_value.tv_sec  = static_cast<time_t>( nsec / 1e9 );
+        its.it_value.tv_nsec = static_cast<long>( nsec - static_cast<double>( its.it_value.tv_sec ) * 1e9 );
+
+        BOOST_TEST_SYS_ASSERT( ::timer_settime( m_timer, 0, &its, 0 ) != -1 );
+#else
+        // the real time interval timer raises SIGALRM, like alarm() but with a microsecond precision
+        double const        usec = std::ceil( m_timeout * 1e6 );
+        ::itimerval         it;
+        std::memset( &it, 0, sizeof(it) );
+        it.it_value.tv_sec  = static_cast<time_t>( usec / 1e6 );
+        it.it_value.tv_usec = static_cast<suseconds_t>( usec - static_cast<double>( it.it_value.tv_sec ) * 1e6 );
+
+        ::setitimer( ITIMER_REAL, &it, 0 );
+#endif
     }
 
 #ifdef BOOST_TEST_USE_ALT_STACK
@@ -776,8 +1073,17 @@ signal_handler::~signal_handler()
 {
     assert( s_active_handler == this );
 
-    if( m_timeout > 0 )
-        ::alarm( 0 );
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+    if( m_timer_created )
+        ::timer_delete( m_timer );
+#else
+    if( m_timeout > 0 ) {
+        ::itimerval it;
+        std::memset( &it, 0, sizeof(it) );
+
+        ::setitimer( ITIMER_REAL, &it, 0 );
+    }
+#endif
 
 #ifdef BOOST_TEST_USE_ALT_STACK
 #ifdef __GNUC__
@@ -804,6 +1110,42 @@ signal_handler::~signal_handler()
 
 //____________________________________________________________________________//
 
+void
+signal_handler::timeout_expired()
+{
+    assert( !!s_active_handler );
+
+    timeout_action const on_timeout = s_active_handler->m_on_timeout;
+    if( on_timeout == TIMEOUT_REPORT )
+        return;
+
+    // only the async-signal-safe functions are used
+    static char const   header[] = "\n******** timeout expired, stack of the monitored function:\n";
+    ssize_t             written = ::write( STDERR_FILENO, header, sizeof(header) - 1 );
+
+#ifdef BOOST_TEST_USE_BACKTRACE
+    void*               frames[64];
+    int const           size = ::backtrace( frames, sizeof(frames) / sizeof(frames[0]) );
+    ::backtrace_symbols_fd( frames, size, STDERR_FILENO );
+#else
+    static char const   unavailable[] = "the stack can't be written on this platform\n";
+    written = ::write( STDERR_FILENO, unavailable, sizeof(unavailable) - 1 );
+#endif
+    ignore_unused( written );
+
+    if( on_timeout != TIMEOUT_ABORT )
+        return;
+
+    if( termination_hook_ptr hook = s_termination_hook() )
+        hook();
+
+    // SIGABRT is caught by the monitored functions
+    ::signal( SIGABRT, SIG_DFL );
+    ::abort();
+}
+
+//____________________________________________________________________________//
+
 // ************************************************************************** //
 // **************       execution_monitor_signal_handler       ************** //
 // ************************************************************************** //
@@ -814,6 +1156,12 @@ static void boost_execution_monitor_jumping_signal_handler( int sig, siginfo_t*
 {
     signal_handler::sys_sig()( info, context );
 
+    // skips this function and the frame of the signal delivery
+    capture_failure_backtrace( 2 );
+
+    if( sig == timeout_signal() )
+        signal_handler::timeout_expired();
+
     siglongjmp( signal_handler::jump_buffer(), sig );
 }
 
@@ -830,6 +1178,18 @@ static void boost_execution_monitor_attaching_signal_handler( int sig, siginfo_t
 
 //____________________________________________________________________________//
 
+static void boost_execution_monitor_terminating_signal_handler( int sig, siginfo_t*, void* )
+{
+    if( termination_hook_ptr hook = s_termination_hook() )
+        hook();
+
+    // the default action of the signal terminates the process once the handler returns
+    ::signal( sig, SIG_DFL );
+    ::raise( sig );
+}
+
+//____________________________________________________________________________//
+
 }
 
 } // namespace detail
@@ -857,6 +1217,7 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
     signal_handler local_signal_handler( p_catch_system_errors,
                                          p_catch_system_errors || (p_detect_fp_exceptions != fpe::BOOST_FPE_OFF),
                                          p_timeout,
+                                         p_timeout_action,
                                          p_auto_start_dbg,
                                          !p_use_alt_stack ? 0 : m_alt_stack.get() );
 
@@ -868,6 +1229,34 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::set_termination_hook( void (*hook)() )
+{
+    using namespace detail;
+
+    s_termination_hook() = hook;
+
+    int const signals[] = { SIGILL, SIGFPE, SIGSEGV, SIGBUS, SIGABRT };
+
+    // signals handled by the monitored functions get the hook once their action is restored
+    for( std::size_t i = 0; i < sizeof(signals)/sizeof(signals[0]); ++i ) {
+        struct sigaction current;
+        std::memset( &current, 0, sizeof(struct sigaction) );
+
+        if( ::sigaction( signals[i], 0, &current ) == -1 )
+            continue;
+
+        if( is_terminating_action( current ) ) {
+            if( !hook )
+                ::signal( signals[i], SIG_DFL );
+        }
+        else if( (current.sa_flags & SA_SIGINFO) == 0 && current.sa_handler == SIG_DFL )
+            restore_signal_action( signals[i], current );
+    }
+}
+
+//____________________________________________________________________________//
+
 #elif defined(BOOST_SEH_BASED_SIGNAL_HANDLING)
 
 // ************************************************************************** //
@@ -1155,6 +1544,14 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::set_termination_hook( void (*)() )
+{
+    // the termination is not intercepted on this platform
+}
+
+//____________________________________________________________________________//
+
 #else  // default signal handler
 
 namespace detail {
@@ -1174,6 +1571,14 @@ execution_monitor::catch_signals( boost::function<int ()> const& F )
 
 //____________________________________________________________________________//
 
+void
+execution_monitor::set_termination_hook( void (*)() )
+{
+    // the termination is not intercepted on this platform
+}
+
+//____________________________________________________________________________//
+
 #endif  // choose signal handler
 
 // ************************************************************************** //
@@ -1184,12 +1589,26 @@ execution_monitor::execution_monitor()
 : p_catch_system_errors( true )
 , p_auto_start_dbg( false )
 , p_timeout( 0 )
+, p_timeout_action( TIMEOUT_REPORT )
 , p_use_alt_stack( true )
 , p_detect_fp_exceptions( fpe::BOOST_FPE_OFF )
+, p_capture_backtrace( false )
 {}
 
 //____________________________________________________________________________//
 
+bool
+execution_monitor::thread_timeouts_supported()
+{
+#ifdef BOOST_TEST_USE_THREAD_TIMER
+    return true;
+#else
+    return false;
+#endif
+}
+
+//____________________________________________________________________________//
+
 int
 execution_monitor::execute( boost::function<int ()> const& F )
 {
@@ -1200,6 +1619,13 @@ execution_monitor::execute( boost::function<int ()> const& F )
         detail::fpe_except_guard G( p_detect_fp_exceptions );
         unit_test::ut_detail::ignore_unused_variable_warning( G );
 
+        // the signal handlers installed by catch_signals may capture the call stack
+        if( p_capture_backtrace || (p_timeout > 0 && p_timeout_action != TIMEOUT_REPORT) )
+            detail::preload_unwinder();
+
+        detail::backtrace_capture_guard BG( p_capture_backtrace );
+        unit_test::ut_detail::ignore_unused_variable_warning( BG );
+
         return catch_signals( F );
     }
 
@@ -1328,10 +1754,11 @@ system_error::system_error( char const* exp )
 // **************              execution_exception             ************** //
 // ************************************************************************** //
 
-execution_exception::execution_exception( error_code ec_, const_string what_msg_, location const& location_ )
+execution_exception::execution_exception( error_code ec_, const_string what_msg_, location const& location_, stack_trace const& backtrace_ )
 : m_error_code( ec_ )
 , m_what( what_msg_.empty() ? BOOST_TEST_L( "uncaught exception, system error or abort requested" ) : what_msg_ )
 , m_location( location_ )
+, m_backtrace( backtrace_ )
 {}
 
 //____________________________________________________________________________//
@@ -1344,6 +1771,105 @@ execution_exception::location::location( char const* file_name, size_t line_num,
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************                  stack_trace                 ************** //
+// ************************************************************************** //
+
+stack_trace::stack_trace( void* const* frames, std::size_t size )
+: m_size( (std::min)( size, static_cast<std::size_t>( max_frames ) ) )
+{
+    std::memcpy( m_frames, frames, m_size * sizeof(void*) );
+}
+
+//____________________________________________________________________________//
+
+namespace detail {
+
+#ifdef BOOST_TEST_USE_BACKTRACE
+
+// turns the description of a frame by backtrace_symbols, "binary(mangled+offset) [address]", into
+// "function+offset in binary [address]"
+static std::string
+describe_frame( char const* symbol )
+{
+    std::string desc( symbol );
+
+    std::string::size_type open  = desc.find( '(' );
+    std::string::size_type plus  = desc.find( '+', open );
+    std::string::size_type close = desc.find( ')', open );
+    if( open == std::string::npos || close == std::string::npos || plus > close )
+        return desc;
+
+    std::string binary  = desc.substr( 0, open );
+    std::string name    = desc.substr( open + 1, plus - open - 1 );
+    std::string offset  = desc.substr( plus, close - plus );
+    std::string address = desc.substr( close + 1 );
+
+    // the functions which are not exported have no name
+    if( name.empty() )
+        return binary + offset + address;
+
+    return boost::core::demangle( name.c_str() ) + offset + " in " + binary + address;
+}
+
+#endif
+
+} // namespace detail
+
+//____________________________________________________________________________//
+
+std::vector<std::string>
+stack_trace::symbolize() const
+{
+    std::vector<std::string> res;
+
+#ifdef BOOST_TEST_USE_BACKTRACE
+    char** symbols = empty() ? 0 : ::backtrace_symbols( m_frames, static_cast<int>( m_size ) );
+    if( symbols ) {
+        for( std::size_t i = 0; i < m_size; ++i )
+            res.push_back( detail::describe_frame( symbols[i] ) );
+
+        std::free( symbols );
+        return res;
+    }
+#endif
+
+    for( std::size_t i = 0; i < m_size; ++i ) {
+        char buf[32];
+        std::sprintf( buf, "[%p]", m_frames[i] );
+        res.push_back( buf );
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+bool
+stack_trace::is_supported()
+{
+#ifdef BOOST_TEST_USE_BACKTRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+//____________________________________________________________________________//
+
+bool
+stack_trace::is_supported_for_exceptions()
+{
+#ifdef BOOST_TEST_USE_THROW_BACKTRACE
+    // the interposed function is only used with a shared C++ library
+    return detail::next_cxa_throw() != 0;
+#else
+    return false;
+#endif
+}
+
+//____________________________________________________________________________//
+
 // ************************************************************************** //
 // **************Floating point exception management interface ************** //
 // ************************************************************************** //
@@ -1427,6 +1953,60 @@ disable( unsigned mask )
 
 } // namespace boost
 
+#ifdef BOOST_TEST_USE_THROW_BACKTRACE
+
+namespace boost {
+namespace detail {
+
+// captures the call stack where a C++ exception is thrown, except the exceptions used by the execution monitor
+// itself, which keep the call stack of the failure they report
+BOOST_NOINLINE static void
+capture_thrown_backtrace( std::type_info const& type )
+{
+    if( !s_failure_backtrace.m_enabled ||
+        type == typeid(system_signal_exception) ||
+        type == typeid(execution_exception) ||
+        type == typeid(execution_aborted) )
+        return;
+
+    // skips this function and __cxa_throw
+    capture_failure_backtrace( 2 );
+}
+
+} // namespace detail
+} // namespace boost
+
+// ************************************************************************** //
+// **************                  __cxa_throw                 ************** //
+// ************************************************************************** //
+
+// Every C++ exception is thrown by this function of the C++ ABI, which is interposed in order to capture the call
+// stack before it is unwound. The function of the C++ library is called afterwards. The definition is weak: when the
+// C++ library is linked statically, its own function is used and the call stack of the exceptions isn't captured.
+namespace __cxxabiv1 {
+
+extern "C" __attribute__((weak)) void
+__cxa_throw( void* ex, std::type_info* type, void (_GLIBCXX_CDTOR_CALLABI* dest)( void* ) )
+{
+    boost::detail::cxa_throw_t next_cxa_throw = boost::detail::next_cxa_throw();
+
+    // without the function of the C++ library, this definition is only chosen when none other is linked
+    if( !next_cxa_throw )
+        std::terminate();
+
+    if( type )
+        boost::detail::capture_thrown_backtrace( *type );
+
+    next_cxa_throw( ex, type, dest );
+
+    // the exception is never returned from
+    std::terminate();
+}
+
+} // namespace __cxxabiv1
+
+#endif // BOOST_TEST_USE_THROW_BACKTRACE
+
 #include <boost/test/detail/enable_warnings.hpp>
 
 #endif // BOOST_TEST_EXECUTION_MONITOR_IPP_012205GER
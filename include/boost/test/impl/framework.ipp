@@ -26,6 +26,8 @@
 #include <boost/test/unit_test_monitor.hpp>
 #include <boost/test/results_collector.hpp>
 #include <boost/test/progress_monitor.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/alloc_monitor.hpp>
 #include <boost/test/results_reporter.hpp>
 
 #include <boost/test/tree/observer.hpp>
@@ -33,12 +35,16 @@
 #include <boost/test/tree/visitor.hpp>
 #include <boost/test/tree/traverse.hpp>
 #include <boost/test/tree/test_case_counter.hpp>
+#include <boost/test/tree/event_recorder.hpp>
 
 #if BOOST_TEST_SUPPORT_TOKEN_ITERATOR
 #include <boost/test/utils/iterator/token_iterator.hpp>
 #endif
 
 #include <boost/test/utils/foreach.hpp>
+#include <boost/test/utils/wrap_stringstream.hpp>
+#include <boost/test/utils/timer.hpp>
+#include <boost/test/utils/string_cast.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
 #include <boost/test/utils/basic_cstring/compare.hpp>
 
@@ -46,8 +52,9 @@
 #include <boost/test/detail/throw_exception.hpp>
 
 // Boost
-#include <boost/timer.hpp>
 #include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/cstdint.hpp>
 
 // STL
 #include <limits>
@@ -56,6 +63,22 @@
 #include <cstdlib>
 #include <ctime>
 #include <numeric>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cmath>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#endif
+
+#ifdef BOOST_TEST_SUPPORT_FORK
+#include <unistd.h>
+#endif
 
 #ifdef BOOST_NO_STDC_NAMESPACE
 namespace std { using ::time; using ::srand; }
@@ -187,6 +210,7 @@ invoke_init_func( init_unit_test_func init_func )
 // ************************************************************************** //
 
 class name_filter : public test_tree_visitor {
+public:
     struct component {
         component( const_string name ) // has to be implicit
         {
@@ -212,8 +236,10 @@ class name_filter : public test_tree_visitor {
 
         bool            pass( test_unit const& tu ) const
         {
-            const_string name( tu.p_name );
-
+            return matches( tu.p_name.get() );
+        }
+        bool            matches( const_string name ) const
+        {
             switch( m_kind ) {
             default:
             case SFK_ALL:
@@ -225,7 +251,7 @@ class name_filter : public test_tree_visitor {
             case SFK_SUBSTR:
                 return name.find( m_name ) != const_string::npos;
             case SFK_MATCH:
-                return m_name == tu.p_name.get();
+                return m_name == name;
             }
         }
         enum kind { SFK_ALL, SFK_LEADING, SFK_TRAILING, SFK_SUBSTR, SFK_MATCH };
@@ -234,9 +260,14 @@ class name_filter : public test_tree_visitor {
         const_string    m_name;
     };
 
-public:
+    // Name filters of the test cases generated on demand, per test suite generating them
+    typedef std::multimap<test_unit_id,std::vector<component> > sample_filters;
+
     // Constructor
-    name_filter( test_unit_id_list& targ_list, const_string filter_expr ) : m_targ_list( targ_list ), m_depth( 0 )
+    name_filter( test_unit_id_list& targ_list, const_string filter_expr, sample_filters* samples = 0 )
+    : m_targ_list( targ_list )
+    , m_samples( samples )
+    , m_depth( 0 )
     {
 #ifdef BOOST_TEST_SUPPORT_TOKEN_ITERATOR
         utils::string_token_iterator tit( filter_expr, (utils::dropped_delimeters = "/",
@@ -281,6 +312,14 @@ private:
             return false;
 
         if( m_depth < m_components.size() ) {
+            // the last component matches the test cases which this test suite generates on demand
+            if( ts.is_lazy() ) {
+                if( m_samples && m_depth + 1 == m_components.size() )
+                    m_samples->insert( std::make_pair( ts.p_id, m_components[m_depth] ) );
+
+                return false;
+            }
+
             ++m_depth;
             return true;
         }
@@ -299,9 +338,12 @@ private:
 
     components_per_level    m_components;
     test_unit_id_list&      m_targ_list;
+    sample_filters*         m_samples;
     unsigned                m_depth;
 };
 
+typedef name_filter::sample_filters sample_filters;
+
 // ************************************************************************** //
 // **************                 label_filter                 ************** //
 // ************************************************************************** //
@@ -374,7 +416,7 @@ private:
 // ************************************************************************** //
 
 static void
-add_filtered_test_units( test_unit_id master_tu_id, const_string filter, test_unit_id_list& targ )
+add_filtered_test_units( test_unit_id master_tu_id, const_string filter, test_unit_id_list& targ, sample_filters& samples )
 {
     // Choose between two kinds of filters
     if( filter[0] == '@' ) {
@@ -383,7 +425,7 @@ add_filtered_test_units( test_unit_id master_tu_id, const_string filter, test_un
         traverse_test_tree( master_tu_id, lf, true );
     }
     else {
-        name_filter nf( targ, filter );
+        name_filter nf( targ, filter, &samples );
         traverse_test_tree( master_tu_id, nf, true );
     }
 }
@@ -391,7 +433,9 @@ add_filtered_test_units( test_unit_id master_tu_id, const_string filter, test_un
 //____________________________________________________________________________//
 
 static bool
-parse_filters( test_unit_id master_tu_id, test_unit_id_list& tu_to_enable, test_unit_id_list& tu_to_disable )
+parse_filters( test_unit_id master_tu_id,
+               test_unit_id_list& tu_to_enable, test_unit_id_list& tu_to_disable,
+               sample_filters& samples_to_enable, sample_filters& samples_to_disable )
 {
     // 10. collect tu to enable and disable based on filters
     bool had_selector_filter = false;
@@ -422,8 +466,8 @@ parse_filters( test_unit_id master_tu_id, test_unit_id_list& tu_to_enable, test_
             // 12. Add test units to corresponding list
             switch( filter_type ) {
             case SELECTOR:
-            case ENABLER:  add_filtered_test_units( master_tu_id, filter_token, tu_to_enable ); break;
-            case DISABLER: add_filtered_test_units( master_tu_id, filter_token, tu_to_disable ); break;
+            case ENABLER:  add_filtered_test_units( master_tu_id, filter_token, tu_to_enable, samples_to_enable ); break;
+            case DISABLER: add_filtered_test_units( master_tu_id, filter_token, tu_to_disable, samples_to_disable ); break;
             }
 
             ++t_filter_it;
@@ -435,41 +479,494 @@ parse_filters( test_unit_id master_tu_id, test_unit_id_list& tu_to_enable, test_
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************                 lazy_samples                 ************** //
+// ************************************************************************** //
+
+// Collects the test suites generating their test cases on demand
+class lazy_suite_collector : public test_tree_visitor {
+public:
+    explicit lazy_suite_collector( test_unit_id_list& targ ) : m_targ( targ ) {}
+
+private:
+    virtual bool    test_suite_start( test_suite const& ts )
+    {
+        if( ts.is_lazy() )
+            m_targ.push_back( ts.p_id );
+
+        return true;
+    }
+
+    // Data members
+    test_unit_id_list&  m_targ;
+};
+
+//____________________________________________________________________________//
+
+// Checks whether the name of a test case generated on demand by the test suite matches any of the filters
+static bool
+match_sample( sample_filters const& filters, test_unit_id ts_id, const_string name )
+{
+    typedef sample_filters::const_iterator it_type;
+    std::pair<it_type,it_type> range = filters.equal_range( ts_id );
+
+    for( it_type it = range.first; it != range.second; ++it ) {
+        BOOST_TEST_FOREACH( name_filter::component const&, c, it->second ) {
+            if( c.matches( name ) )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+//____________________________________________________________________________//
+
+// Looks up the test cases generated on demand by the test suite, when all the filters enabling them are exact
+// names: these are found by the source without going through the names of all of its test cases
+static bool
+find_exact_samples( sample_filters const& filters, test_unit_id ts_id, test_case_source const& source,
+                    std::vector<counter_t>& indexes )
+{
+    typedef sample_filters::const_iterator it_type;
+    std::pair<it_type,it_type> range = filters.equal_range( ts_id );
+
+    for( it_type it = range.first; it != range.second; ++it ) {
+        BOOST_TEST_FOREACH( name_filter::component const&, c, it->second ) {
+            if( c.m_kind != name_filter::component::SFK_MATCH )
+                return false;
+        }
+    }
+
+    for( it_type it = range.first; it != range.second; ++it ) {
+        BOOST_TEST_FOREACH( name_filter::component const&, c, it->second ) {
+            counter_t index = source.find( c.m_name );
+
+            if( index != source.size() )
+                indexes.push_back( index );
+        }
+    }
+
+    std::sort( indexes.begin(), indexes.end() );
+    indexes.erase( std::unique( indexes.begin(), indexes.end() ), indexes.end() );
+
+    return true;
+}
+
+//____________________________________________________________________________//
+
+} // namespace impl
+} // namespace framework
+} // namespace unit_test
+} // namespace boost
+
+// test durations, shards, longest test units first and rerun of the failed test cases
+#include <boost/test/impl/test_schedule.ipp>
+
+namespace boost {
+namespace unit_test {
+namespace framework {
+namespace impl {
+
+// ************************************************************************** //
+// **************               benchmark_runner               ************** //
+// ************************************************************************** //
+
+// Whether the name matches the pattern, where '*' matches any sequence of characters
+static bool
+matches_pattern( const_string name, const_string pattern )
+{
+    std::size_t n = 0, p = 0, resume_n = 0, resume_p = 0;
+    bool has_star = false;
+
+    while( n < name.size() ) {
+        if( p < pattern.size() && pattern[p] == '*' ) {
+            has_star = true;
+            resume_p = ++p;
+            resume_n = n;
+        }
+        else if( p < pattern.size() && pattern[p] == name[n] ) {
+            ++p;
+            ++n;
+        }
+        else if( has_star ) {
+            // the last star swallows one more character
+            p = resume_p;
+            n = ++resume_n;
+        }
+        else
+            return false;
+    }
+
+    while( p < pattern.size() && pattern[p] == '*' )
+        ++p;
+
+    return p == pattern.size();
+}
+
+//____________________________________________________________________________//
+
+// Whether the benchmark test case is selected by the comma separated patterns of the benchmark filter
+static bool
+is_benchmark_selected( test_case const& tc )
+{
+    if( !runtime_config::has( runtime_config::btrt_benchmark_filter ) )
+        return true;
+
+    std::string const& filter = runtime_config::get<std::string>( runtime_config::btrt_benchmark_filter );
+    std::string const  name   = tc.full_name();
+
+    std::string::size_type pos = 0;
+    for( ;; ) {
+        std::string::size_type end = filter.find( ',', pos );
+        if( end == std::string::npos )
+            end = filter.size();
+
+        if( matches_pattern( name, const_string( filter.data() + pos, end - pos ) ) )
+            return true;
+
+        if( end == filter.size() )
+            return false;
+
+        pos = end + 1;
+    }
+}
+
+//____________________________________________________________________________//
+
+// Measures the body of a benchmark test case. The amount of iterations per sample is calibrated so that a sample
+// lasts about one hundredth of the minimal time, then samples are taken until the minimal time is spent
+class benchmark_runner {
+public:
+    benchmark_runner( test_case const& tc, double min_time )
+    : m_tc( tc )
+    , m_min_time( min_time > 0 ? static_cast<boost::uint64_t>( min_time * 1e9 ) : 0 )
+    {
+        m_data.clear();
+    }
+
+    void            run()
+    {
+        boost::uint64_t const sample_time = m_min_time / 100;
+
+        // the last calibration run is the first sample
+        counter_t       iterations  = 1;
+        boost::uint64_t elapsed     = measure( iterations );
+
+        while( elapsed < sample_time ) {
+            // aims at a bit more than the sample time, growing tenfold at most
+            double const factor = elapsed > 0 ? 1.4 * static_cast<double>( sample_time ) / static_cast<double>( elapsed ) : 10.;
+
+            iterations  = (std::max)( static_cast<counter_t>( static_cast<double>( iterations ) * (std::min)( factor, 10. ) ), iterations + 1 );
+            elapsed     = measure( iterations );
+        }
+
+        std::vector<double> samples;   // mean durations of an iteration
+        boost::uint64_t     total = 0;
+
+        for( ;; ) {
+            samples.push_back( static_cast<double>( elapsed ) / static_cast<double>( iterations ) );
+            total += elapsed;
+
+            if( total >= m_min_time )
+                break;
+
+            elapsed = measure( iterations );
+        }
+
+        std::sort( samples.begin(), samples.end() );
+        std::size_t const size = samples.size();
+
+        m_data.m_iterations = iterations * static_cast<counter_t>( size );
+        m_data.m_samples    = static_cast<counter_t>( size );
+        m_data.m_mean       = static_cast<double>( total ) / static_cast<double>( m_data.m_iterations );
+        m_data.m_median     = size % 2 != 0 ? samples[size/2] : (samples[size/2 - 1] + samples[size/2]) / 2;
+        m_data.m_p99        = samples[static_cast<std::size_t>( std::ceil( 0.99 * static_cast<double>( size ) ) ) - 1];
+        m_data.m_rate       = total > 0 ? static_cast<double>( m_data.m_iterations ) * 1e9 / static_cast<double>( total ) : 0;
+    }
+
+    benchmark_data const& data() const { return m_data; }
+
+private:
+    boost::uint64_t measure( counter_t iterations )
+    {
+        boost::uint64_t start = utils::steady_clock_ns();
+
+        m_tc.p_benchmark_func.get()( iterations );
+
+        return utils::steady_clock_ns() - start;
+    }
+
+    // Data members
+    test_case const&    m_tc;
+    boost::uint64_t     m_min_time;     // in nanoseconds
+    benchmark_data      m_data;
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                 measured_body                ************** //
+// ************************************************************************** //
+
+// Executes the body of the test case measured by the monitors, so that their measures do not include the fixtures,
+// the observers nor the execution monitor
+class measured_body {
+public:
+    measured_body( test_case const& tc, boost::function<void ()> const& body )
+    : m_tc( tc )
+    , m_body( body )
+    {}
+
+    void            operator()() const
+    {
+        measure m( m_tc );
+
+        m_body();
+    }
+
+private:
+    // stops the measures whether the body returns or throws
+    struct measure {
+        explicit measure( test_case const& tc )
+        : m_tc( tc )
+        {
+            alloc_monitor.test_body_start( m_tc );
+            perf_monitor.test_body_start( m_tc );
+        }
+        ~measure()
+        {
+            perf_monitor.test_body_finish( m_tc );
+            alloc_monitor.test_body_finish( m_tc );
+        }
+
+        test_case const&    m_tc;
+    };
+
+    // Data members, small enough for the body not to be allocated
+    test_case const&                m_tc;
+    boost::function<void ()> const& m_body;
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************             regression_baseline              ************** //
+// ************************************************************************** //
+
+// Performance baseline of the test cases decorated with max_regression. These are stored in a text file with one
+// line per test case: the duration in nanoseconds followed by a space and the full name of the test case. The
+// duration is the one of the test case body, or the median duration of an iteration for the benchmark test cases
+class regression_baseline {
+public:
+    typedef std::map<std::string,double> store;
+
+    // Missing file is the same as empty one: the baseline is saved by a first run
+    void            load( std::string const& file_name )
+    {
+        m_durations.clear();
+
+        std::ifstream in( file_name.c_str() );
+
+        std::string line;
+        while( std::getline( in, line ) ) {
+            std::string::size_type sep = line.find( ' ' );
+            if( sep == std::string::npos || sep == 0 )
+                continue;
+
+            m_durations[line.substr( sep + 1 )] = std::strtod( line.c_str(), 0 );
+        }
+    }
+
+    // Baseline of the test case, or 0 if it is unknown
+    double          get( std::string const& full_name ) const
+    {
+        store::const_iterator it = m_durations.find( full_name );
+
+        return it != m_durations.end() ? it->second : 0;
+    }
+
+    void            set( std::string const& full_name, double duration ) { m_durations[full_name] = duration; }
+
+    bool            save( std::string const& file_name ) const
+    {
+        std::ofstream out( file_name.c_str() );
+        out.precision( 10 );
+
+        BOOST_TEST_FOREACH( store::value_type const&, d, m_durations )
+            out << d.second << ' ' << d.first << '\n';
+
+        return static_cast<bool>( out.flush() );
+    }
+
+private:
+    // Data members
+    store           m_durations;
+};
+
+//____________________________________________________________________________//
+
+// Median of the durations of the repeated executions of a test case, reordering them
+static double
+median_duration( std::vector<double>& durations )
+{
+    std::sort( durations.begin(), durations.end() );
+    std::size_t const size = durations.size();
+
+    return size % 2 != 0 ? durations[size/2] : (durations[size/2 - 1] + durations[size/2]) / 2;
+}
+
+//____________________________________________________________________________//
+
+// Whether the recorded execution failed an assertion or was aborted by an exception
+static bool
+has_failed( event_recorder const& recorder )
+{
+    BOOST_TEST_FOREACH( event_recorder::event const&, e, recorder.events() ) {
+        if( (e.m_type == event_recorder::ET_ASSERTION && e.m_code == AR_FAILED) || e.m_type == event_recorder::ET_EXCEPTION )
+            return true;
+    }
+
+    return false;
+}
+
+//____________________________________________________________________________//
+
+} // namespace impl
+} // namespace framework
+} // namespace unit_test
+} // namespace boost
+
+// test case runners: worker threads and child processes
+#include <boost/test/impl/test_case_runner.ipp>
+
+namespace boost {
+namespace unit_test {
+namespace framework {
+namespace impl {
+
+// ************************************************************************** //
+// **************                test_unit_store               ************** //
+// ************************************************************************** //
+
+// Registered test units indexed by their ids. The ids are allocated sequentially from two separate ranges,
+// one for the test suites and one for the test cases, so each range is stored in a dense vector
+class test_unit_store {
+public:
+    test_unit_store() : m_size( 0 ) {}
+
+    void            insert( test_unit_id id, test_unit* tu )
+    {
+        std::vector<test_unit*>& units = range( id );
+        std::size_t              idx   = index( id );
+
+        if( idx >= units.size() )
+            units.resize( idx + 1, 0 );
+
+        if( !units[idx] )
+            ++m_size;
+
+        units[idx] = tu;
+    }
+
+    void            erase( test_unit_id id )
+    {
+        std::vector<test_unit*>& units = range( id );
+        std::size_t              idx   = index( id );
+
+        if( idx < units.size() && units[idx] ) {
+            units[idx] = 0;
+            --m_size;
+        }
+    }
+
+    // Registered test unit with specified id, or 0 if there is none
+    test_unit*      find( test_unit_id id ) const
+    {
+        std::vector<test_unit*> const& units = ut_detail::test_id_2_unit_type( id ) == TUT_SUITE ? m_test_suites : m_test_cases;
+        std::size_t                    idx   = index( id );
+
+        return idx < units.size() ? units[idx] : 0;
+    }
+
+    // Positional access to the test suites followed by the test cases; unused positions hold 0
+    std::size_t     slots() const               { return m_test_suites.size() + m_test_cases.size(); }
+    test_unit*      at( std::size_t pos ) const
+    {
+        return pos < m_test_suites.size() ? m_test_suites[pos] : m_test_cases[pos - m_test_suites.size()];
+    }
+
+    void            clear()
+    {
+        m_test_suites.clear();
+        m_test_cases.clear();
+        m_size = 0;
+    }
+
+    bool            empty() const   { return m_size == 0; }
+
+private:
+    std::vector<test_unit*>&    range( test_unit_id id )
+    {
+        return ut_detail::test_id_2_unit_type( id ) == TUT_SUITE ? m_test_suites : m_test_cases;
+    }
+    static std::size_t          index( test_unit_id id )
+    {
+        return id - (ut_detail::test_id_2_unit_type( id ) == TUT_SUITE ? MIN_TEST_SUITE_ID : MIN_TEST_CASE_ID);
+    }
+
+    // Data members
+    std::vector<test_unit*>     m_test_suites;
+    std::vector<test_unit*>     m_test_cases;
+    std::size_t                 m_size;
+};
+
+//____________________________________________________________________________//
+
 } // namespace impl
 
 // ************************************************************************** //
 // **************               framework::state               ************** //
 // ************************************************************************** //
 
-unsigned const TIMEOUT_EXCEEDED = static_cast<unsigned>( -1 );
+double const TIMEOUT_EXCEEDED = -1;
+
+// Number of test cases generated at once by the test suites generating them on demand
+counter_t const LAZY_BATCH_SIZE = 256;
 
 class state {
 public:
     state()
-    : m_curr_test_case( INV_TEST_UNIT_ID )
-    , m_next_test_case_id( MIN_TEST_CASE_ID )
+    : m_next_test_case_id( MIN_TEST_CASE_ID )
     , m_next_test_suite_id( MIN_TEST_SUITE_ID )
     , m_test_in_progress( false )
-    , m_context_idx( 0 )
+    , m_test_case_runner( 0 )
     , m_log_sinks( )
     , m_report_sink( std::cerr )
     {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        m_driver_thread = std::this_thread::get_id();
+#endif
     }
 
     ~state() { clear(); }
 
     void            clear()
     {
-        while( !m_test_units.empty() ) {
-            test_unit_store::value_type const& tu     = *m_test_units.begin();
-            test_unit const*                   tu_ptr = tu.second;
+        // the delete erases the test unit from the store
+        for( std::size_t i = 0; i < m_test_units.slots(); ++i ) {
+            test_unit const* tu_ptr = m_test_units.at( i );
+
+            if( !tu_ptr )
+                continue;
 
-            // the delete will erase this element from map
-            if( ut_detail::test_id_2_unit_type( tu.second->p_id ) == TUT_SUITE )
+            if( ut_detail::test_id_2_unit_type( tu_ptr->p_id ) == TUT_SUITE )
                 delete static_cast<test_suite const*>(tu_ptr);
             else
                 delete static_cast<test_case const*>(tu_ptr);
         }
+
+        m_test_units.clear();
     }
 
     void            set_tu_id( test_unit& tu, test_unit_id id ) { tu.p_id.value = id; }
@@ -515,8 +1012,11 @@ public:
 
         // go through list of children
         if( tu.p_type == TUT_SUITE ) {
-            bool has_enabled_child = false;
-            BOOST_TEST_FOREACH( test_unit_id, chld_id, static_cast<test_suite const&>(tu).m_children )
+            test_suite const& ts = static_cast<test_suite const&>(tu);
+
+            // the test cases generated on demand are enabled along with their test suite
+            bool has_enabled_child = ts.is_lazy() && ts.m_source->size() != 0 && tu.p_default_status == test_suite::RS_ENABLED;
+            BOOST_TEST_FOREACH( test_unit_id, chld_id, ts.m_children )
                 has_enabled_child |= finalize_default_run_status( chld_id, tu.p_default_status );
 
             tu.p_default_status.value = has_enabled_child ? test_suite::RS_ENABLED : test_suite::RS_DISABLED;
@@ -533,8 +1033,11 @@ public:
 
         // go through list of children
         if( tu.p_type == TUT_SUITE ) {
-            bool has_enabled_child = false;
-            BOOST_TEST_FOREACH( test_unit_id, chld_id, static_cast<test_suite const&>(tu).m_children)
+            test_suite const& ts = static_cast<test_suite const&>(tu);
+
+            // the test cases generated on demand are selected by select_samples
+            bool has_enabled_child = ts.is_lazy() && tu.is_enabled();
+            BOOST_TEST_FOREACH( test_unit_id, chld_id, ts.m_children)
                 has_enabled_child |= finalize_run_status( chld_id );
 
             tu.p_run_status.value = has_enabled_child ? test_suite::RS_ENABLED : test_suite::RS_DISABLED;
@@ -550,10 +1053,23 @@ public:
         using namespace framework::impl;
         test_unit_id_list tu_to_enable;
         test_unit_id_list tu_to_disable;
+        sample_filters    samples_to_enable;
+        sample_filters    samples_to_disable;
 
-        // 10. If there are any filters supplied, figure out lists of test units to enable/disable
-        bool had_selector_filter = !runtime_config::get<std::vector<std::string> >( runtime_config::btrt_run_filters ).empty() &&
-                                   parse_filters( master_tu_id, tu_to_enable, tu_to_disable );
+        // 5. Release the test cases generated on demand which the previous runs kept for their reports
+        test_unit_id_list lazy_suites;
+        lazy_suite_collector lsc( lazy_suites );
+        traverse_test_tree( master_tu_id, lsc, true );
+
+        BOOST_TEST_FOREACH( test_unit_id, ts_id, lazy_suites ) {
+            test_suite& ts = framework::get<test_suite>( ts_id );
+
+            release_samples( ts, test_unit_id_list( ts.m_children ), false );
+        }
+
+        // 10. If there are any filters supplied, figure out lists of test units to enable/disable
+        bool had_selector_filter = !runtime_config::get<std::vector<std::string> >( runtime_config::btrt_run_filters ).empty() &&
+                                   parse_filters( master_tu_id, tu_to_enable, tu_to_disable, samples_to_enable, samples_to_disable );
 
         // 20. Set the stage: either use default run status or disable all test units
         set_run_status initial_setter( had_selector_filter ? test_unit::RS_DISABLED : test_unit::RS_INVALID );
@@ -588,8 +1104,48 @@ public:
             traverse_test_tree( tu.p_id, disabler, true );
         }
 
+        // 42. Select the test cases generated on demand: all of them if their test suite is enabled, the ones
+        // matching the filters otherwise, except the ones matching the disablers
+        BOOST_TEST_FOREACH( test_unit_id, ts_id, lazy_suites )
+            select_samples( framework::get<test_suite>( ts_id ), samples_to_enable, samples_to_disable );
+
+        // 45. Keep only the test cases which failed in the previous runs, if requested, and the ones assigned
+        // to this shard, if any
+        test_durations durations;
+        if( runtime_config::has( runtime_config::btrt_durations ) )
+            durations.load( runtime_config::get<std::string>( runtime_config::btrt_durations ) );
+
+        rerun_mode rerun = runtime_config::get<rerun_mode>( runtime_config::btrt_rerun );
+        if( rerun == RERUN_FAILED )
+            select_failed( master_tu_id, durations );
+
+        unsigned shard_count = runtime_config::get<unsigned>( runtime_config::btrt_shard_count );
+        if( shard_count > 1 ) {
+            unsigned shard_index = runtime_config::get<unsigned>( runtime_config::btrt_shard_index );
+
+            BOOST_TEST_SETUP_ASSERT( shard_index < shard_count, "Shard index should be lower than shard count" );
+
+            select_shard( master_tu_id, shard_index, shard_count, durations );
+        }
+
         // 50. Make sure parents of enabled test units are also enabled
         finalize_run_status( master_tu_id );
+
+        // 60. Estimate the durations of the test units to execute the longest ones first
+        m_expected_durations.clear();
+        if( runtime_config::get<schedule_order>( runtime_config::btrt_schedule ) == SCHEDULE_LONGEST_FIRST ) {
+            test_unit_id_list tcs;
+            enabled_test_case_collector tcc( tcs );
+            traverse_test_tree( master_tu_id, tcc );
+
+            expected_duration_collector edc( durations, durations.average( tcs ), m_expected_durations );
+            traverse_test_tree( master_tu_id, edc );
+        }
+
+        // 70. Find the test units holding the test cases which failed in the previous runs to execute them first
+        m_failed_units.clear();
+        if( rerun == RERUN_FAILED_FIRST )
+            collect_failed( master_tu_id, durations, m_failed_units );
     }
 
     //////////////////////////////////////////////////////////////////
@@ -605,7 +1161,7 @@ public:
 
       // Executed the test tree with the root at specified test unit
     execution_result execute_test_tree( test_unit_id tu_id,
-                                        unsigned timeout = 0,
+                                        double timeout = 0,
                                         random_generator_helper const * const p_random_generator = 0)
     {
         test_unit const& tu = framework::get( tu_id, TUT_ANY );
@@ -648,20 +1204,37 @@ public:
         }
 
         // This is the time we are going to spend executing the test unit
-        unsigned long elapsed = 0;
-
-        if( result == unit_test_monitor_t::test_ok ) {
-            // 40. We are going to time the execution
-            boost::timer tu_timer;
+        utils::elapsed_time elapsed;
+        bool                executed = result == unit_test_monitor_t::test_ok;
+
+        if( executed ) {
+            // 40. We are going to time the execution. The test units executed by the thread driving the test tree are
+            // executed alone: the CPU time of the process includes the threads they start
+#ifdef BOOST_TEST_SUPPORT_THREADS
+            utils::timer tu_timer( std::this_thread::get_id() == m_driver_thread );
+#else
+            utils::timer tu_timer( true );
+#endif
 
             if( tu.p_type == TUT_SUITE ) {
                 test_suite const& ts = static_cast<test_suite const&>( tu );
 
-                if( runtime_config::get<unsigned>( runtime_config::btrt_random_seed ) == 0 ) {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+                // the test cases of a test suite decorated with data_parallel are executed by its own threads
+                impl::data_parallel_scope data_parallel( m_test_case_runner, ts );
+#endif
+
+                if( ts.is_lazy() ) {
+                    const random_generator_helper& rand_gen = p_random_generator ? *p_random_generator : random_generator_helper();
+
+                    result = execute_lazy_suite( framework::get<test_suite>( tu_id ), timeout, tu_timer, rand_gen );
+                }
+                else if( runtime_config::get<unsigned>( runtime_config::btrt_random_seed ) == 0 && !active_runner() &&
+                    m_expected_durations.empty() && m_failed_units.empty() ) {
                     typedef std::pair<counter_t,test_unit_id> value_type;
 
                     BOOST_TEST_FOREACH( value_type, chld, ts.m_ranked_children ) {
-                        unsigned chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+                        double chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
 
                         result = (std::min)( result, execute_test_tree( chld.second, chld_timeout ) );
 
@@ -671,7 +1244,8 @@ public:
                 }
                 else {
                     // Go through ranges of chldren with the same dependency rank and shuffle them
-                    // independently. Execute each subtree in this order
+                    // independently (or put the longest or the failed ones first, or execute them
+                    // concurrently). Execute each subtree in this order
                     test_unit_id_list children_with_the_same_rank;
 
                     typedef test_suite::children_per_rank::const_iterator it_type;
@@ -688,77 +1262,633 @@ public:
 
                         const random_generator_helper& rand_gen = p_random_generator ? *p_random_generator : random_generator_helper();
 
-                        std::random_shuffle( children_with_the_same_rank.begin(), children_with_the_same_rank.end(), rand_gen );
+                        if( runtime_config::get<unsigned>( runtime_config::btrt_random_seed ) != 0 )
+                            std::random_shuffle( children_with_the_same_rank.begin(), children_with_the_same_rank.end(), rand_gen );
+
+                        if( !m_expected_durations.empty() )
+                            std::stable_sort( children_with_the_same_rank.begin(), children_with_the_same_rank.end(),
+                                              impl::longest_expected_first( m_expected_durations ) );
+
+                        if( !m_failed_units.empty() )
+                            std::stable_partition( children_with_the_same_rank.begin(), children_with_the_same_rank.end(),
+                                                   impl::failed_first( m_failed_units ) );
+
+                        if( active_runner() ) {
+                            result = (std::min)( result, execute_concurrently( children_with_the_same_rank, timeout, tu_timer, rand_gen ) );
+                            continue;
+                        }
 
                         BOOST_TEST_FOREACH( test_unit_id, chld, children_with_the_same_rank ) {
-                            unsigned chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+                            double chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+
+                            result = (std::min)( result, execute_test_tree( chld, chld_timeout, &rand_gen ) );
+
+                            if( unit_test_monitor.is_critical_error( result ) )
+                                break;
+                        }
+                    }
+                }
+
+                elapsed = tu_timer.elapsed_times();
+            }
+            else { // TUT_CASE
+                test_case const& tc = static_cast<test_case const&>( tu );
+                thread_state& ths = curr_thread_state();
+
+                // setup contexts
+                ths.m_context_idx = 0;
+
+                // setup current test case
+                test_unit_id bkup = ths.m_curr_test_case;
+                ths.m_curr_test_case = tc.p_id;
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+                test_case_started( tc.p_id );
+#endif
+
+                // execute the test case body, repeatedly if its performance is checked against the baseline
+                bool const      checked = is_regression_checked( tc );
+                unsigned const  repeats = checked ? tc.p_regression_repeats.get() : 1;
+
+                // count the allocations of each execution if they are checked against a budget
+                bool const      budgeted = is_allocation_checked( tc );
+                bool const      tracked  = budgeted && alloc_measure::is_supported();
+                counter_t       allocations = 0;
+
+                // sample the growth of the resident memory of each execution if it is checked against a budget
+                bool const      memory_checked = is_memory_checked( tc );
+                bool            peak_reset     = memory_checked;
+                counter_t       memory_growth  = 0;
+
+                // only the first execution is reported: the assertions and the log entries of the next ones are
+                // recorded, and replayed only if one of them fails
+                struct repeat_guard {
+                    explicit repeat_guard( thread_state& ths ) : m_ths( ths ), m_recorder( ths.m_recorder ) {}
+                    ~repeat_guard() { m_ths.m_recorder = m_recorder; }
+
+                    thread_state&           m_ths;
+                    impl::event_recorder*   m_recorder;
+                };
+
+                bool const              measured = is_measured( tc );
+                impl::event_recorder    repeated_run( unit_test_log.get_min_threshold_level() );
+                bool                    repeat_failed = false;
+
+                // the recorded events are not counted as allocations of the test case
+                repeated_run.events().reserve( 64 );
+
+                std::vector<double>         durations;
+                std::vector<benchmark_data> benchmarks;
+
+                for( unsigned r = 0; r < repeats && result == unit_test_monitor_t::test_ok && !repeat_failed; ++r ) {
+                    repeat_guard guard( ths );
+                    if( r > 0 ) {
+                        repeated_run.clear();
+                        ths.m_recorder = &repeated_run;
+                    }
+
+                    if( measured ) {
+                        impl::benchmark_runner runner( tc, runtime_config::get<double>( runtime_config::btrt_benchmark_min_time ) );
+
+                        result = unit_test_monitor.execute_and_translate(
+                            impl::measured_body( tc, boost::bind( &impl::benchmark_runner::run, &runner ) ), timeout );
+
+                        benchmarks.push_back( runner.data() );
+                        durations.push_back( runner.data().m_median );
+                    }
+                    else {
+                        alloc_measure am;
+                        if( tracked )
+                            am.start();
+
+                        debug::process_memory_usage memory_at_start;
+                        if( peak_reset )
+                            peak_reset = debug::reset_peak_memory_usage() && debug::memory_usage( memory_at_start );
+
+                        boost::uint64_t start = utils::steady_clock_ns();
+
+                        result = unit_test_monitor.execute_and_translate( impl::measured_body( tc, tc.p_test_func ), timeout );
+
+                        boost::uint64_t const duration = utils::steady_clock_ns() - start;
+
+                        if( tracked )
+                            allocations = (std::max)( allocations, am.stop().m_allocations );
+
+                        debug::process_memory_usage memory_at_finish;
+                        if( peak_reset && debug::memory_usage( memory_at_finish ) &&
+                            memory_at_finish.m_peak_resident_bytes > memory_at_start.m_resident_bytes )
+                            memory_growth = (std::max)( memory_growth, static_cast<counter_t>(
+                                memory_at_finish.m_peak_resident_bytes - memory_at_start.m_resident_bytes ) );
+
+                        durations.push_back( static_cast<double>( duration ) );
+                    }
+
+                    repeat_failed = r > 0 && impl::has_failed( repeated_run );
+                }
+
+                if( repeat_failed )
+                    repeated_run.replay();
+
+                if( result == unit_test_monitor_t::test_ok ) {
+                    // the measures of the median execution are reported
+                    if( !benchmarks.empty() ) {
+                        std::nth_element( benchmarks.begin(), benchmarks.begin() + benchmarks.size() / 2, benchmarks.end(), median_less() );
+
+                        BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                            to->benchmark_result( tc, benchmarks[benchmarks.size() / 2] );
+                    }
+
+                    if( checked )
+                        check_regression( tc, impl::median_duration( durations ), !benchmarks.empty() );
+
+                    if( budgeted )
+                        check_allocations( tc, allocations, tracked, repeats );
+
+                    if( memory_checked )
+                        check_memory( tc, memory_growth, peak_reset, repeats );
+                }
+                elapsed = tu_timer.elapsed_times();
+
+                // cleanup leftover context
+                ths.m_context.clear();
+
+                // restore state and abort if necessary
+                ths.m_curr_test_case = bkup;
+            }
+        }
+
+        // if run error is critical skip teardown, who knows what the state of the program at this point
+        if( !unit_test_monitor.is_critical_error( result ) ) {
+            // execute teardown fixtures if any in reverse order
+            BOOST_TEST_REVERSE_FOREACH( test_unit_fixture_ptr, F, tu.p_fixtures.get() ) {
+                result = (std::min)( result, unit_test_monitor.execute_and_translate( boost::bind( &test_unit_fixture::teardown, F ), 0 ) );
+
+                if( unit_test_monitor.is_critical_error( result ) )
+                    break;
+            }
+        }
+
+        // notify all observers about abortion
+        if( unit_test_monitor.is_critical_error( result ) ) {
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_aborted();
+        }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        if( tu.p_type == TUT_CASE )
+            merge_foreign_threads( tu.p_id );
+#endif
+
+        // notify all observers about the durations of the test case body, and about completion
+        if( tu.p_type == TUT_CASE && executed ) {
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->durations_measured( static_cast<test_case const&>( tu ), elapsed );
+        }
+
+        BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_observers )
+            to->test_unit_finish( tu, static_cast<unsigned long>( elapsed.m_wall_ns / 1000 ) );
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    double child_timeout( double tu_timeout, double elapsed )
+    {
+      if( tu_timeout == 0 )
+          return 0;
+
+      return tu_timeout > elapsed ? tu_timeout - elapsed : TIMEOUT_EXCEEDED;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Benchmark test case selected by the benchmark filter, unless it is executed on behalf of another thread
+    bool            is_measured( test_case const& tc )
+    {
+        return !tc.p_benchmark_func.get().empty() && !curr_thread_state().m_recorder && impl::is_benchmark_selected( tc );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Test case is compared with its performance baseline: it is decorated with max_regression and a baseline file is given
+    bool            is_regression_checked( test_case const& tc )
+    {
+        return tc.p_max_regression > 0 && !curr_thread_state().m_recorder &&
+               runtime_config::has( runtime_config::btrt_regression_baseline ) &&
+               !runtime_config::get<std::string>( runtime_config::btrt_regression_baseline ).empty();
+    }
+
+    struct median_less {
+        bool operator()( benchmark_data const& lhs, benchmark_data const& rhs ) const { return lhs.m_median < rhs.m_median; }
+    };
+
+    //////////////////////////////////////////////////////////////////
+
+    // Reports the median duration of the test case against its baseline as an assertion of the test case, or keeps
+    // it as the new baseline if the baseline is saved
+    void            check_regression( test_case const& tc, double duration, bool per_iteration )
+    {
+        std::string const name = tc.full_name();
+
+        if( runtime_config::save_pattern() ) {
+            m_regression_baseline.set( name, duration );
+            return;
+        }
+
+        double const baseline = m_regression_baseline.get( name );
+        if( baseline <= 0 ) {
+            unit_test_log << log::begin( tc.p_file_name, tc.p_line_num ) << log_messages
+                          << "no performance baseline for this test case, it is saved with --"
+                          << runtime_config::btrt_save_test_pattern << log::end();
+            return;
+        }
+
+        double const regression = duration / baseline - 1;
+        bool const   passed     = regression <= tc.p_max_regression;
+
+        std::ostringstream text;
+        text.precision( 3 );
+        text << (passed ? "performance check has passed" : "performance check has failed")
+             << ": median duration" << (per_iteration ? " of an iteration " : " ");
+        ut_detail::print_duration( text, duration );
+        text << " over " << tc.p_regression_repeats << (tc.p_regression_repeats > 1 ? " executions is " : " execution is ")
+             << std::fabs( regression ) * 100 << (regression >= 0 ? "% above" : "% below") << " the baseline ";
+        ut_detail::print_duration( text, baseline );
+        text << " [maximum " << tc.p_max_regression * 100 << "%]";
+
+        report_check( tc, passed, text.str() );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Reports the outcome of a check of the test case body as an assertion of the test case
+    void            report_check( test_case const& tc, bool passed, std::string const& text )
+    {
+        unit_test_log << log::begin( tc.p_file_name, tc.p_line_num ) << (passed ? log_successful_tests : log_all_errors)
+                      << text << log::end();
+
+        framework::assertion_result( passed ? AR_PASSED : AR_FAILED );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Reports the highest measure of the executions of the test case body against its limit, in the given unit
+    void            check_limit( test_case const& tc, const_string check, const_string measure,
+                                 counter_t value, counter_t limit, const_string unit, unsigned repeats )
+    {
+        bool const passed = value <= limit;
+
+        std::ostringstream text;
+        text << check << (passed ? " check has passed: " : " check has failed: ")
+             << measure << value << ' ' << unit << (value != 1 ? "s" : "")
+             << (repeats > 1 ? " in the worst execution" : "")
+             << " [maximum " << limit << "]";
+
+        report_check( tc, passed, text.str() );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Test case body is checked against its allocation budget: it is decorated with max_allocations and is not
+    // measured as a benchmark
+    bool            is_allocation_checked( test_case const& tc )
+    {
+        return tc.p_max_allocations != NO_ALLOCATION_LIMIT && !curr_thread_state().m_recorder && !is_measured( tc );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Reports the highest number of allocations of the executions of the test case body against its budget as an
+    // assertion of the test case
+    void            check_allocations( test_case const& tc, counter_t allocations, bool tracked, unsigned repeats )
+    {
+        if( !tracked ) {
+            unit_test_log << log::begin( tc.p_file_name, tc.p_line_num ) << log_messages
+                          << "allocations are not tracked in this build, the allocation budget of this test case is not checked"
+                          << log::end();
+            return;
+        }
+
+        check_limit( tc, "allocation", "", allocations, tc.p_max_allocations, "allocation", repeats );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Test case body is checked against its memory budget: it is decorated with memory_budget and is not measured as
+    // a benchmark
+    bool            is_memory_checked( test_case const& tc )
+    {
+        return tc.p_memory_budget > 0 && !curr_thread_state().m_recorder && !is_measured( tc );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Reports the highest growth of the resident memory during the executions of the test case body against its
+    // budget as an assertion of the test case
+    void            check_memory( test_case const& tc, counter_t growth, bool sampled, unsigned repeats )
+    {
+        if( !sampled ) {
+            unit_test_log << log::begin( tc.p_file_name, tc.p_line_num ) << log_messages
+                          << "the peak resident memory can't be sampled on this system, the memory budget of this test case is not checked"
+                          << log::end();
+            return;
+        }
+
+        check_limit( tc, "memory", "peak resident memory grew by ", growth, tc.p_memory_budget, "byte", repeats );
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Test case can be executed by the test case runner: neither it nor its parents are decorated as serial,
+    // it is not measured as a benchmark nor checked against a baseline or a budget, the runner can handle its timeout
+    // if any and it is not going to be skipped
+    bool            is_concurrent( test_unit const& tu, double timeout )
+    {
+        if( tu.p_type != TUT_CASE || timeout == TIMEOUT_EXCEEDED )
+            return false;
+
+        // the measures are not disturbed by the other test cases
+        if( is_measured( static_cast<test_case const&>( tu ) ) || is_regression_checked( static_cast<test_case const&>( tu ) ) ||
+            is_allocation_checked( static_cast<test_case const&>( tu ) ) || is_memory_checked( static_cast<test_case const&>( tu ) ) )
+            return false;
+
+        if( (timeout != 0 || tu.p_timeout != 0) && !m_test_case_runner->supports_timeout() )
+            return false;
+
+        for( test_unit const* curr = &tu; ; curr = &framework::get( curr->p_parent_id, TUT_SUITE ) ) {
+            if( curr->p_serial )
+                return false;
+
+            if( curr->p_parent_id == INV_TEST_UNIT_ID )
+                break;
+        }
+
+        return tu.check_preconditions();
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Selects the test cases the test suite generates on demand in this run
+    void            select_samples( test_suite& ts, impl::sample_filters const& to_enable, impl::sample_filters const& to_disable )
+    {
+        bool const whole = ts.is_enabled();
+
+        ts.m_all_samples = whole && to_disable.count( ts.p_id ) == 0;
+        ts.m_selected_samples.clear();
+
+        std::vector<counter_t> exact;
+
+        if( !whole && impl::find_exact_samples( to_enable, ts.p_id, *ts.m_source, exact ) ) {
+            BOOST_TEST_FOREACH( counter_t, i, exact ) {
+                if( !impl::match_sample( to_disable, ts.p_id, ts.m_source->name( i ) ) )
+                    ts.m_selected_samples.push_back( i );
+            }
+        }
+        else if( !ts.m_all_samples && (whole || to_enable.count( ts.p_id ) != 0) ) {
+            for( counter_t i = 0; i < ts.m_source->size(); ++i ) {
+                std::string const name = ts.m_source->name( i );
+
+                if( (whole || impl::match_sample( to_enable, ts.p_id, name )) && !impl::match_sample( to_disable, ts.p_id, name ) )
+                    ts.m_selected_samples.push_back( i );
+            }
+        }
+
+        ts.p_run_status.value = ts.lazy_size() != 0 ? test_unit::RS_ENABLED : test_unit::RS_DISABLED;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Removes the test cases generated on demand from their test suite and deletes them. The failed ones may be
+    // kept for the reports
+    void            release_samples( test_suite& ts, test_unit_id_list const& samples, bool keep_failed )
+    {
+        bool drained = false;
+
+        BOOST_TEST_FOREACH( test_unit_id, tc_id, samples ) {
+            if( keep_failed && !results_collector.results( tc_id ).passed() )
+                continue;
+
+            // the events of the asynchronous log still refer to the test cases
+            if( !drained ) {
+                unit_test_log.drain();
+                drained = true;
+            }
+
+            test_case* tc = &framework::get<test_case>( tc_id );
+
+            ts.remove( tc_id );
+            delete tc;
+        }
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Generates the selected test cases of the test suite in batches and executes each batch like siblings of
+    // the same rank. The test cases which passed are released right after their batch, so that the memory used
+    // does not grow with the size of the dataset
+    execution_result execute_lazy_suite( test_suite& ts,
+                                         double timeout,
+                                         utils::timer const& tu_timer,
+                                         random_generator_helper const& rand_gen )
+    {
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        counter_t const size = ts.lazy_size();
+        for( counter_t start = 0; start < size && !unit_test_monitor.is_critical_error( result ); start += LAZY_BATCH_SIZE ) {
+            test_unit_id_list batch;
+
+            for( counter_t i = start; i < size && i < start + LAZY_BATCH_SIZE; ++i ) {
+                test_case* tc = ts.m_source->make( ts.m_all_samples ? i : ts.m_selected_samples[i] );
+
+                ts.add( tc );
+                tc->p_default_status.value  = test_unit::RS_ENABLED;
+                tc->p_run_status.value      = test_unit::RS_ENABLED;
+
+                batch.push_back( tc->p_id );
+            }
+
+            if( runtime_config::get<unsigned>( runtime_config::btrt_random_seed ) != 0 )
+                std::random_shuffle( batch.begin(), batch.end(), rand_gen );
+
+            if( active_runner() )
+                result = (std::min)( result, execute_concurrently( batch, timeout, tu_timer, rand_gen ) );
+            else {
+                BOOST_TEST_FOREACH( test_unit_id, chld, batch ) {
+                    double chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+
+                    result = (std::min)( result, execute_test_tree( chld, chld_timeout, &rand_gen ) );
+
+                    if( unit_test_monitor.is_critical_error( result ) )
+                        break;
+                }
+            }
+
+            release_samples( ts, batch, true );
+        }
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the siblings with the same rank. Each run of consecutive test cases which can be executed concurrently
+    // is dispatched to the test case runner, the other test units are executed in this thread in between
+    execution_result execute_concurrently( test_unit_id_list const& siblings,
+                                           double timeout,
+                                           utils::timer const& tu_timer,
+                                           random_generator_helper const& rand_gen )
+    {
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        std::size_t pos = 0;
+        while( pos < siblings.size() && !unit_test_monitor.is_critical_error( result ) ) {
+            double chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+
+            impl::parallel_batch batch;
+            for( ; pos < siblings.size(); ++pos ) {
+                test_unit const& chld = framework::get( siblings[pos], TUT_ANY );
+
+                if( !chld.is_enabled() )
+                    continue;
+
+                if( !is_concurrent( chld, chld_timeout ) )
+                    break;
+
+                // same as the timeout deduced by execute_test_tree
+                double tc_timeout = chld_timeout == 0 || chld_timeout > chld.p_timeout ? chld.p_timeout.get() : chld_timeout;
+
+                batch.push_back( impl::parallel_job( chld.p_id, unit_test_log.get_min_threshold_level(), tc_timeout ) );
+            }
+
+            if( !batch.empty() )
+                result = (std::min)( result, execute_batch( batch ) );
+
+            if( pos < siblings.size() && !unit_test_monitor.is_critical_error( result ) ) {
+                chld_timeout = child_timeout( timeout, tu_timer.elapsed() );
+
+                result = (std::min)( result, execute_test_tree( siblings[pos++], chld_timeout, &rand_gen ) );
+            }
+        }
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the batch by the test case runner and reports the test cases in order
+    execution_result execute_batch( impl::parallel_batch& batch )
+    {
+        struct batch_guard {
+            explicit batch_guard( impl::test_case_runner& runner ) : m_runner( runner ) {}
+            ~batch_guard() { m_runner.finish(); }
+
+            impl::test_case_runner& m_runner;
+        };
+
+        execution_result result = unit_test_monitor_t::test_ok;
+
+        m_test_case_runner->start( batch );
+        batch_guard guard( *m_test_case_runner );
+
+        BOOST_TEST_FOREACH( impl::parallel_job&, job, batch ) {
+            m_test_case_runner->wait( job );
+
+            result = (std::min)( result, report_parallel_job( job ) );
+        }
+
+        return result;
+    }
+
+    //////////////////////////////////////////////////////////////////
+
+    // Executes the test case along with its fixtures in the calling worker thread or child process
+    void            execute_parallel_job( impl::parallel_job& job, execution_monitor& em )
+    {
+        test_case const& tc = framework::get<test_case>( job.m_tc_id );
 
-                            result = (std::min)( result, execute_test_tree( chld, chld_timeout, &rand_gen ) );
+        thread_state ths;
+        ths.m_curr_test_case = tc.p_id;
+        ths.m_recorder       = &job.m_recorder;
+        thread_state_ptr()   = &ths;
 
-                            if( unit_test_monitor.is_critical_error( result ) )
-                                break;
-                        }
-                    }
-                }
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        test_case_started( tc.p_id );
+#endif
 
-                elapsed = static_cast<unsigned long>( tu_timer.elapsed() * 1e6 );
-            }
-            else { // TUT_CASE
-                test_case const& tc = static_cast<test_case const&>( tu );
+        execution_result result = unit_test_monitor_t::test_ok;
 
-                // setup contexts
-                m_context_idx = 0;
+        BOOST_TEST_FOREACH( test_unit_fixture_ptr, F, tc.p_fixtures.get() ) {
+            result = unit_test_monitor_t::execute_and_translate( em, boost::bind( &test_unit_fixture::setup, F ) );
+            if( result != unit_test_monitor_t::test_ok )
+                break;
+        }
 
-                // setup current test case
-                test_unit_id bkup = m_curr_test_case;
-                m_curr_test_case = tc.p_id;
+        utils::elapsed_time elapsed;
+        bool                executed = result == unit_test_monitor_t::test_ok;
 
-                // execute the test case body
-                result = unit_test_monitor.execute_and_translate( tc.p_test_func, timeout );
-                elapsed = static_cast<unsigned long>( tu_timer.elapsed() * 1e6 );
+        if( executed ) {
+            // the CPU time is the one of the worker thread
+            utils::timer tc_timer;
 
-                // cleanup leftover context
-                m_context.clear();
+            result = unit_test_monitor_t::execute_and_translate( em, tc.p_test_func, job.m_timeout );
 
-                // restore state and abort if necessary
-                m_curr_test_case = bkup;
-            }
+            elapsed = tc_timer.elapsed_times();
         }
 
-        // if run error is critical skip teardown, who knows what the state of the program at this point
         if( !unit_test_monitor.is_critical_error( result ) ) {
-            // execute teardown fixtures if any in reverse order
-            BOOST_TEST_REVERSE_FOREACH( test_unit_fixture_ptr, F, tu.p_fixtures.get() ) {
-                result = (std::min)( result, unit_test_monitor.execute_and_translate( boost::bind( &test_unit_fixture::teardown, F ), 0 ) );
+            BOOST_TEST_REVERSE_FOREACH( test_unit_fixture_ptr, F, tc.p_fixtures.get() ) {
+                result = (std::min)( result, unit_test_monitor_t::execute_and_translate( em, boost::bind( &test_unit_fixture::teardown, F ), 0 ) );
 
                 if( unit_test_monitor.is_critical_error( result ) )
                     break;
             }
         }
 
-        // notify all observers about abortion
-        if( unit_test_monitor.is_critical_error( result ) ) {
-            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
-                to->test_aborted();
-        }
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        merge_foreign_threads( tc.p_id );
+#endif
 
-        // notify all observers about completion
-        BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_observers )
-            to->test_unit_finish( tu, elapsed );
+        thread_state_ptr() = 0;
 
-        return result;
+        job.m_result    = result;
+        job.m_elapsed   = elapsed;
+        job.m_executed  = executed;
     }
 
     //////////////////////////////////////////////////////////////////
 
-    unsigned child_timeout( unsigned tu_timeout, double elapsed )
+    // Notifies the observers about the test case executed by the test case runner, as if it was executed in this thread
+    execution_result report_parallel_job( impl::parallel_job const& job )
     {
-      if( tu_timeout == 0U )
-          return 0U;
+        test_case const& tc = framework::get<test_case>( job.m_tc_id );
+
+        BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+            to->test_unit_start( tc );
+
+        thread_state& ths = curr_thread_state();
+        test_unit_id bkup = ths.m_curr_test_case;
+        ths.m_curr_test_case = tc.p_id;
+
+        job.m_recorder.replay();
+
+        ths.m_context.clear();
+        ths.m_curr_test_case = bkup;
+
+        if( unit_test_monitor.is_critical_error( job.m_result ) ) {
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->test_aborted();
+        }
 
-      unsigned elpsed_sec = static_cast<unsigned>(elapsed); // rounding to number of whole seconds
+        if( job.m_executed ) {
+            BOOST_TEST_FOREACH( test_observer*, to, m_observers )
+                to->durations_measured( tc, job.m_elapsed );
+        }
+
+        BOOST_TEST_REVERSE_FOREACH( test_observer*, to, m_observers )
+            to->test_unit_finish( tc, static_cast<unsigned long>( job.m_elapsed.m_wall_ns / 1000 ) );
 
-      return tu_timeout > elpsed_sec ? tu_timeout - elpsed_sec : TIMEOUT_EXCEEDED;
+        return job.m_result;
     }
 
     struct priority_order {
@@ -769,7 +1899,7 @@ public:
     };
 
     // Data members
-    typedef std::map<test_unit_id,test_unit*>       test_unit_store;
+    typedef impl::test_unit_store                   test_unit_store;
     typedef std::set<test_observer*,priority_order> observer_store;
     struct context_frame {
         context_frame( std::string const& d, int id, bool sticky )
@@ -784,10 +1914,211 @@ public:
     };
     typedef std::vector<context_frame> context_data;
 
+    // Test execution state specific to the thread executing the test case
+    struct thread_state {
+        thread_state()
+        : m_curr_test_case( INV_TEST_UNIT_ID )
+        , m_context_idx( 0 )
+        , m_recorder( 0 )
+        {}
+
+        test_unit_id            m_curr_test_case;
+        context_data            m_context;
+        int                     m_context_idx;
+        impl::event_recorder*   m_recorder;
+    };
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    // State of a thread started by a test case, which uses the testing tools without any synchronization
+    //
+    // The log entries of the thread are recorded and its assertions are only counted; both are merged by the
+    // thread executing the test case which started it, once this test case is finished.
+    struct foreign_thread_state : thread_state {
+        foreign_thread_state( test_unit_id tc_id, test_unit_id origin )
+        : m_origin( origin )
+        , m_events( unit_test_log.get_min_threshold_level() )
+        , m_exited( false )
+        {
+            m_curr_test_case = tc_id;
+            m_recorder       = &m_events;
+            m_events.set_sink( boost::bind( &foreign_thread_state::keep, this, _1 ) );
+
+            for( int ar = AR_FAILED; ar <= AR_TRIGGERED; ++ar ) {
+                m_counts[ar] = 0;
+                m_merged[ar] = 0;
+            }
+        }
+
+        void            keep( impl::event_recorder::event const& e )
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            m_kept.push_back( e );
+        }
+
+        void            count( unit_test::assertion_result ar )
+        {
+            // the counters are written by the owning thread only
+            m_counts[ar].store( m_counts[ar].load( std::memory_order_relaxed ) + 1, std::memory_order_release );
+        }
+
+        test_unit_id                        m_origin;   // test case which started the thread, if it is known
+        impl::event_recorder                m_events;
+        std::mutex                          m_mutex;    // guards m_kept and m_exited
+        impl::event_recorder::event_list    m_kept;     // complete events not merged yet
+        bool                                m_exited;
+        std::atomic<counter_t>              m_counts[AR_TRIGGERED+1];
+        counter_t                           m_merged[AR_TRIGGERED+1];  // part of the counts merged already
+    };
+
+    // Reports the end of the foreign thread, which keeps the events recorded in the thread for the merge
+    struct foreign_thread_exit {
+        foreign_thread_exit() : m_state( 0 ) {}
+        ~foreign_thread_exit()
+        {
+            if( !m_state )
+                return;
+
+            m_state->m_events.flush();
+
+            std::lock_guard<std::mutex> lock( m_state->m_mutex );
+            m_state->m_exited = true;
+
+            thread_state_ptr()  = 0;
+            foreign_state_ptr() = 0;
+        }
+
+        foreign_thread_state* m_state;
+    };
+
+    static foreign_thread_state*& foreign_state_ptr() { static BOOST_TEST_THREAD_LOCAL foreign_thread_state* the_inst = 0; return the_inst; }
+
+    // Attaches the state of the foreign thread calling the framework for the first time
+    thread_state*   attach_foreign_thread()
+    {
+        static BOOST_TEST_THREAD_LOCAL foreign_thread_exit s_exit;
+
+        foreign_thread_state* fts;
+        {
+            std::lock_guard<std::mutex> lock( m_foreign_mutex );
+
+            // the thread was started by the test case being executed, which is unknown if several test cases are
+            // executed concurrently
+            test_unit_id origin = m_running_test_cases.size() == 1 ? m_running_test_cases.front() : INV_TEST_UNIT_ID;
+
+            fts = new foreign_thread_state( origin != INV_TEST_UNIT_ID ? origin : m_main_thread_state.m_curr_test_case, origin );
+            m_foreign_threads.push_back( fts );
+        }
+
+        s_exit.m_state      = fts;
+        foreign_state_ptr() = fts;
+        thread_state_ptr()  = fts;
+
+        return fts;
+    }
+
+    // Records the start of the test case, whose thread is the origin of the foreign threads attached meanwhile
+    void            test_case_started( test_unit_id tc_id )
+    {
+        std::lock_guard<std::mutex> lock( m_foreign_mutex );
+
+        m_running_test_cases.push_back( tc_id );
+    }
+
+    // Merges what the foreign threads started by the test case reported so far into its results, once it is finished.
+    // The threads whose origin is unknown, including the ones which outlived their test case, are merged into the
+    // results of the next test case finishing
+    void            merge_foreign_threads( test_unit_id tc_id )
+    {
+        std::lock_guard<std::mutex> lock( m_foreign_mutex );
+
+        std::vector<test_unit_id>::iterator running = std::find( m_running_test_cases.begin(), m_running_test_cases.end(), tc_id );
+        if( running != m_running_test_cases.end() )
+            m_running_test_cases.erase( running );
+
+        if( m_foreign_threads.empty() )
+            return;
+
+        thread_state& ths = curr_thread_state();
+        test_unit_id bkup = ths.m_curr_test_case;
+        ths.m_curr_test_case = tc_id;
+
+        std::vector<foreign_thread_state*>::iterator it = m_foreign_threads.begin();
+        while( it != m_foreign_threads.end() ) {
+            foreign_thread_state* fts = *it;
+
+            if( fts->m_origin != tc_id && fts->m_origin != INV_TEST_UNIT_ID ) {
+                ++it;
+                continue;
+            }
+
+            impl::event_recorder kept;
+            bool exited;
+            {
+                std::lock_guard<std::mutex> thread_lock( fts->m_mutex );
+
+                kept.events().swap( fts->m_kept );
+                exited = fts->m_exited;
+            }
+
+            // the log entries of each thread are reported together
+            kept.replay();
+
+            for( int ar = AR_FAILED; ar <= AR_TRIGGERED; ++ar ) {
+                counter_t count = fts->m_counts[ar].load( std::memory_order_acquire );
+
+                for( ; fts->m_merged[ar] < count; ++fts->m_merged[ar] )
+                    framework::assertion_result( static_cast<unit_test::assertion_result>( ar ) );
+            }
+
+            if( exited ) {
+                delete fts;
+                it = m_foreign_threads.erase( it );
+                continue;
+            }
+
+            // the thread outlives the test case
+            fts->m_origin = INV_TEST_UNIT_ID;
+            ++it;
+        }
+
+        ths.m_context.clear();
+        ths.m_curr_test_case = bkup;
+    }
+
+    // the child process executing a test case inherits the records of the threads of the parent process only
+    void            forget_foreign_threads()
+    {
+        m_foreign_threads.clear();
+        m_running_test_cases.clear();
+    }
+#endif
+
+    // test cases of a test tree executed by a test case running concurrently are executed in sequence
+    impl::test_case_runner* active_runner() { return thread_state_ptr() ? 0 : m_test_case_runner; }
+
+    // the calling thread reports the events on behalf of the main thread, with its own current test case and context
+    void            attach_thread_state()   { thread_state_ptr() = new thread_state; }
+    void            detach_thread_state()   { delete thread_state_ptr(); thread_state_ptr() = 0; }
+
+    // state of the worker thread; the main thread uses m_main_thread_state
+    static thread_state*&   thread_state_ptr() { static BOOST_TEST_THREAD_LOCAL thread_state* the_inst = 0; return the_inst; }
+    thread_state&           curr_thread_state()
+    {
+        thread_state* ths = thread_state_ptr();
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        // the threads started by the test cases get their own state the first time they use the framework
+        if( !ths && std::this_thread::get_id() != m_driver_thread )
+            ths = attach_foreign_thread();
+#endif
+
+        return ths ? *ths : m_main_thread_state;
+    }
+
     master_test_suite_t* m_master_test_suite;
     std::vector<test_suite*> m_auto_test_suites;
 
-    test_unit_id    m_curr_test_case;
     test_unit_store m_test_units;
 
     test_unit_id    m_next_test_case_id;
@@ -796,8 +2127,26 @@ public:
     bool            m_test_in_progress;
 
     observer_store  m_observers;
-    context_data    m_context;
-    int             m_context_idx;
+    thread_state    m_main_thread_state;
+
+    impl::test_case_runner* m_test_case_runner;
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    // thread executing the test tree, along with the threads started by the test cases
+    std::thread::id                     m_driver_thread;
+    std::mutex                          m_foreign_mutex;
+    std::vector<foreign_thread_state*>  m_foreign_threads;
+    std::vector<test_unit_id>           m_running_test_cases;   // test cases whose threads may start foreign ones
+#endif
+
+    // expected durations of the test units, if the longest ones are executed first
+    impl::expected_durations m_expected_durations;
+
+    // test units holding the test cases which failed in the previous runs, if these are executed first
+    std::set<test_unit_id>  m_failed_units;
+
+    // performance baseline of the test cases decorated with max_regression
+    impl::regression_baseline m_regression_baseline;
 
     boost::execution_monitor m_aux_em;
 
@@ -818,12 +2167,128 @@ framework::state& s_frk_state() { static framework::state the_inst; return the_i
 
 } // local namespace
 
+#if defined(BOOST_TEST_SUPPORT_THREADS) || defined(BOOST_TEST_SUPPORT_FORK)
+static void
+execute_parallel_job( parallel_job& job, execution_monitor& em )
+{
+    s_frk_state().execute_parallel_job( job, em );
+}
+#endif
+
+#if defined(BOOST_TEST_SUPPORT_THREADS) && defined(BOOST_TEST_SUPPORT_FORK)
+static void
+forget_foreign_threads()
+{
+    s_frk_state().forget_foreign_threads();
+}
+#endif
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************            event_recorder::active            ************** //
+// ************************************************************************** //
+
+// recorder of the calling thread, kept along with its other state
+event_recorder*
+event_recorder::active()
+{
+    return s_frk_state().curr_thread_state().m_recorder;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************           parallel_execution_scope           ************** //
+// ************************************************************************** //
+
+// Sets up the test case runner requested by the parallel and isolation parameters, unless it is already set up
+class parallel_execution_scope {
+public:
+    parallel_execution_scope()
+    {
+        if( s_frk_state().m_test_case_runner )
+            return;
+
+        unsigned workers = runtime_config::get<unsigned>( runtime_config::btrt_parallel );
+
+        if( runtime_config::get<isolation_mode>( runtime_config::btrt_isolation ) == ISOLATION_FORK ) {
+#ifdef BOOST_TEST_SUPPORT_FORK
+            if( workers == 0 )
+                workers = static_cast<unsigned>( (std::max)( ::sysconf( _SC_NPROCESSORS_ONLN ), 1L ) );
+
+            m_runner.reset( new process_pool( workers ) );
+#else
+            BOOST_TEST_FRAMEWORK_MESSAGE( "Isolation of the test cases is not supported in this configuration; test cases are executed in the test module process" );
+#endif
+        }
+
+        if( !m_runner && workers != 1 ) {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+            if( workers == 0 )
+                workers = std::thread::hardware_concurrency();
+
+            if( workers > 1 )
+                m_runner.reset( new test_case_pool( workers ) );
+#else
+            BOOST_TEST_FRAMEWORK_MESSAGE( "Parallel execution is not supported in this configuration; test cases are executed sequentially" );
+#endif
+        }
+
+        s_frk_state().m_test_case_runner = m_runner.get();
+    }
+
+    ~parallel_execution_scope()
+    {
+        if( m_runner )
+            s_frk_state().m_test_case_runner = 0;
+    }
+
+private:
+    // Data members
+    boost::scoped_ptr<test_case_runner> m_runner;
+};
+
+//____________________________________________________________________________//
+
 void
 setup_for_execution( test_unit const& tu )
 {
     s_frk_state().deduce_run_status( tu.p_id );
 }
 
+//____________________________________________________________________________//
+
+void
+attach_thread_state()
+{
+    s_frk_state().attach_thread_state();
+}
+
+//____________________________________________________________________________//
+
+void
+detach_thread_state()
+{
+    s_frk_state().detach_thread_state();
+}
+
+//____________________________________________________________________________//
+
+void
+set_thread_test_case( test_unit_id tc_id )
+{
+    s_frk_state().curr_thread_state().m_curr_test_case = tc_id;
+}
+
+//____________________________________________________________________________//
+
+void
+set_test_in_progress( bool in_progress )
+{
+    s_frk_state().m_test_in_progress = in_progress;
+}
+
 struct sum_to_first_only {
     sum_to_first_only() : is_first(true) {}
     template <class T, class U>
@@ -838,6 +2303,15 @@ struct sum_to_first_only {
     bool is_first;
 };
 
+// binary logs are not subject to the newline translation
+static std::ios_base::openmode
+log_sink_mode( output_format format )
+{
+    return format == OF_BINARY ? std::ios_base::out | std::ios_base::binary : std::ios_base::out;
+}
+
+//____________________________________________________________________________//
+
 void
 setup_loggers()
 {
@@ -858,7 +2332,7 @@ setup_loggers()
 
             runtime_config::stream_holder& stream_logger = s_frk_state().m_log_sinks[format];
             if( runtime_config::has( runtime_config::btrt_log_sink ) )
-                stream_logger.setup( runtime_config::get<std::string>( runtime_config::btrt_log_sink ) );
+                stream_logger.setup( runtime_config::get<std::string>( runtime_config::btrt_log_sink ), log_sink_mode( format ) );
             unit_test_log.set_stream( stream_logger.ref() );
         }
         else
@@ -884,7 +2358,8 @@ setup_loggers()
                 std::make_pair( "HRF"  , OF_CLF ),
                 std::make_pair( "CLF"  , OF_CLF ),
                 std::make_pair( "XML"  , OF_XML ),
-                std::make_pair( "JUNIT", OF_JUNIT )
+                std::make_pair( "JUNIT", OF_JUNIT ),
+                std::make_pair( "BINARY", OF_BINARY )
             };
 
 
@@ -987,10 +2462,10 @@ setup_loggers()
                     runtime_config::stream_holder& stream_logger = s_frk_state().m_log_sinks[format];
                     if( ++current_format_specs != utils::string_token_iterator() &&
                         current_format_specs->size() ) {
-                        stream_logger.setup( *current_format_specs );
+                        stream_logger.setup( *current_format_specs, log_sink_mode( format ) );
                     }
                     else {
-                        stream_logger.setup( formatter->get_default_stream_description() );
+                        stream_logger.setup( formatter->get_default_stream_description(), log_sink_mode( format ) );
                     }
                     unit_test_log.set_stream( format, stream_logger.ref() );
                 }
@@ -1049,6 +2524,12 @@ init( init_unit_test_func init_func, int argc, char* argv[] )
         register_observer( progress_monitor );
     }
 
+    if( runtime_config::get<bool>( runtime_config::btrt_perf_counters ) )
+        register_observer( perf_monitor );
+
+    if( runtime_config::get<bool>( runtime_config::btrt_track_allocations ) )
+        register_observer( alloc_monitor );
+
     // 50. Set up memory leak detection
     unsigned long detect_mem_leak = runtime_config::get<unsigned long>( runtime_config::btrt_detect_mem_leaks );
     if( detect_mem_leak > 0 ) {
@@ -1154,9 +2635,7 @@ register_test_unit( test_case* tc )
 
     BOOST_TEST_SETUP_ASSERT( new_id != MAX_TEST_CASE_ID, BOOST_TEST_L( "too many test cases" ) );
 
-    typedef state::test_unit_store::value_type map_value_type;
-
-    impl::s_frk_state().m_test_units.insert( map_value_type( new_id, tc ) );
+    impl::s_frk_state().m_test_units.insert( new_id, tc );
     impl::s_frk_state().m_next_test_case_id++;
 
     impl::s_frk_state().set_tu_id( *tc, new_id );
@@ -1177,9 +2656,7 @@ register_test_unit( test_suite* ts )
 
     BOOST_TEST_SETUP_ASSERT( new_id != MAX_TEST_SUITE_ID, BOOST_TEST_L( "too many test suites" ) );
 
-    typedef state::test_unit_store::value_type map_value_type;
-
-    impl::s_frk_state().m_test_units.insert( map_value_type( new_id, ts ) );
+    impl::s_frk_state().m_test_units.insert( new_id, ts );
     impl::s_frk_state().m_next_test_suite_id++;
 
     impl::s_frk_state().set_tu_id( *ts, new_id );
@@ -1244,9 +2721,11 @@ add_context( ::boost::unit_test::lazy_ostream const& context_descr, bool sticky
 {
     std::stringstream buffer;
     context_descr( buffer );
-    int res_idx  = impl::s_frk_state().m_context_idx++;
 
-    impl::s_frk_state().m_context.push_back( state::context_frame( buffer.str(), res_idx, sticky ) );
+    state::thread_state& ths = impl::s_frk_state().curr_thread_state();
+    int res_idx  = ths.m_context_idx++;
+
+    ths.m_context.push_back( state::context_frame( buffer.str(), res_idx, sticky ) );
 
     return res_idx;
 }
@@ -1272,18 +2751,20 @@ struct frame_with_id {
 void
 clear_context( int frame_id )
 {
+    state::context_data& context = impl::s_frk_state().curr_thread_state().m_context;
+
     if( frame_id == -1 ) {   // clear all non sticky frames
-        for( int i=static_cast<int>(impl::s_frk_state().m_context.size())-1; i>=0; i-- )
-            if( !impl::s_frk_state().m_context[i].is_sticky )
-                impl::s_frk_state().m_context.erase( impl::s_frk_state().m_context.begin()+i );
+        for( int i=static_cast<int>(context.size())-1; i>=0; i-- )
+            if( !context[i].is_sticky )
+                context.erase( context.begin()+i );
     }
 
     else { // clear specific frame
         state::context_data::iterator it =
-            std::find_if( impl::s_frk_state().m_context.begin(), impl::s_frk_state().m_context.end(), frame_with_id( frame_id ) );
+            std::find_if( context.begin(), context.end(), frame_with_id( frame_id ) );
 
-        if( it != impl::s_frk_state().m_context.end() ) // really an internal error if this is not true
-            impl::s_frk_state().m_context.erase( it );
+        if( it != context.end() ) // really an internal error if this is not true
+            context.erase( it );
     }
 }
 
@@ -1308,7 +2789,7 @@ get_context()
 bool
 context_generator::is_empty() const
 {
-    return impl::s_frk_state().m_context.empty();
+    return impl::s_frk_state().curr_thread_state().m_context.empty();
 }
 
 //____________________________________________________________________________//
@@ -1316,7 +2797,9 @@ context_generator::is_empty() const
 const_string
 context_generator::next() const
 {
-    return m_curr_frame < impl::s_frk_state().m_context.size() ? impl::s_frk_state().m_context[m_curr_frame++].descr : const_string();
+    state::context_data const& context = impl::s_frk_state().curr_thread_state().m_context;
+
+    return m_curr_frame < context.size() ? context[m_curr_frame++].descr : const_string();
 }
 
 //____________________________________________________________________________//
@@ -1363,7 +2846,7 @@ current_auto_test_suite( test_suite* ts, bool push_or_pop )
 test_case const&
 current_test_case()
 {
-    return get<test_case>( impl::s_frk_state().m_curr_test_case );
+    return get<test_case>( impl::s_frk_state().curr_thread_state().m_curr_test_case );
 }
 
 //____________________________________________________________________________//
@@ -1371,7 +2854,7 @@ current_test_case()
 test_unit_id
 current_test_case_id()
 {
-    return impl::s_frk_state().m_curr_test_case;
+    return impl::s_frk_state().curr_thread_state().m_curr_test_case;
 }
 
 //____________________________________________________________________________//
@@ -1383,8 +2866,9 @@ current_test_case_id()
 test_unit&
 get( test_unit_id id, test_unit_type t )
 {
-    test_unit* res = impl::s_frk_state().m_test_units[id];
+    test_unit* res = impl::s_frk_state().m_test_units.find( id );
 
+    BOOST_TEST_I_ASSRT( res != 0, internal_error( "Invalid test unit id" ) );
     BOOST_TEST_I_ASSRT( (res->p_type & t) != 0, internal_error( "Invalid test unit type" ) );
 
     return *res;
@@ -1408,7 +2892,9 @@ run( test_unit_id id, bool continue_test )
     test_case_counter tcc;
     traverse_test_tree( id, tcc );
 
-    BOOST_TEST_SETUP_ASSERT( tcc.p_count != 0 , runtime_config::get<std::vector<std::string> >( runtime_config::btrt_run_filters ).empty()
+    // shard may legitimately get no test cases if there are more shards than test cases
+    BOOST_TEST_SETUP_ASSERT( tcc.p_count != 0 || runtime_config::get<unsigned>( runtime_config::btrt_shard_count ) > 1,
+        runtime_config::get<std::vector<std::string> >( runtime_config::btrt_run_filters ).empty()
         ? BOOST_TEST_L( "test tree is empty" )
         : BOOST_TEST_L( "no test cases matching filter or all test cases were disabled" ) );
 
@@ -1417,6 +2903,11 @@ run( test_unit_id id, bool continue_test )
 
     impl::s_frk_state().m_test_in_progress = true;
 
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( !was_in_progress )
+        impl::s_frk_state().m_driver_thread = std::this_thread::get_id();
+#endif
+
     if( call_start_finish ) {
         BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers ) {
             BOOST_TEST_I_TRY {
@@ -1439,7 +2930,30 @@ run( test_unit_id id, bool continue_test )
         std::srand( seed );
     }
 
-    impl::s_frk_state().execute_test_tree( id );
+    std::string const baseline_file = call_start_finish && runtime_config::has( runtime_config::btrt_regression_baseline )
+                                    ? runtime_config::get<std::string>( runtime_config::btrt_regression_baseline )
+                                    : std::string();
+    if( !baseline_file.empty() )
+        impl::s_frk_state().m_regression_baseline.load( baseline_file );
+
+    {
+        // worker threads are kept for the duration of the outermost run
+        impl::parallel_execution_scope scope;
+
+        impl::s_frk_state().execute_test_tree( id );
+    }
+
+    if( call_start_finish && runtime_config::has( runtime_config::btrt_durations ) ) {
+        std::string const& durations_file = runtime_config::get<std::string>( runtime_config::btrt_durations );
+
+        if( !durations_file.empty() )
+            impl::save_durations( id, durations_file );
+    }
+
+    if( !baseline_file.empty() && runtime_config::save_pattern() ) {
+        if( !impl::s_frk_state().m_regression_baseline.save( baseline_file ) )
+            BOOST_TEST_FRAMEWORK_MESSAGE( "Performance baseline of the test cases can't be saved to " << baseline_file );
+    }
 
     if( call_start_finish ) {
         BOOST_TEST_REVERSE_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
@@ -1466,6 +2980,18 @@ run( test_unit const* tu, bool continue_test )
 void
 assertion_result( unit_test::assertion_result ar )
 {
+    if( impl::event_recorder* recorder = impl::event_recorder::active() ) {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        // the assertions of the threads started by the test cases are counted without any synchronization
+        if( state::foreign_thread_state* fts = state::foreign_state_ptr() ) {
+            fts->count( ar );
+            return;
+        }
+#endif
+        recorder->assertion_result( ar );
+        return;
+    }
+
     BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
         to->assertion_result( ar );
 }
@@ -1479,6 +3005,12 @@ assertion_result( unit_test::assertion_result ar )
 void
 exception_caught( execution_exception const& ex )
 {
+    if( impl::event_recorder* recorder = impl::event_recorder::active() ) {
+        recorder->exception_caught( ex );
+        clear_context();
+        return;
+    }
+
     BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
         to->exception_caught( ex );
 }
@@ -1492,12 +3024,53 @@ exception_caught( execution_exception const& ex )
 void
 test_unit_aborted( test_unit const& tu )
 {
+    if( impl::event_recorder* recorder = impl::event_recorder::active() ) {
+        recorder->test_unit_aborted( tu );
+        return;
+    }
+
     BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
         to->test_unit_aborted( tu );
 }
 
 //____________________________________________________________________________//
 
+// ************************************************************************** //
+// **************            perf_counters_measured            ************** //
+// ************************************************************************** //
+
+void
+perf_counters_measured( test_case const& tc, perf_counters const& pcs )
+{
+    if( impl::event_recorder* recorder = impl::event_recorder::active() ) {
+        recorder->perf_counters_measured( tc, pcs );
+        return;
+    }
+
+    BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
+        to->perf_counters_measured( tc, pcs );
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************             allocations_measured             ************** //
+// ************************************************************************** //
+
+void
+allocations_measured( test_case const& tc, alloc_stats const& as )
+{
+    if( impl::event_recorder* recorder = impl::event_recorder::active() ) {
+        recorder->allocations_measured( tc, as );
+        return;
+    }
+
+    BOOST_TEST_FOREACH( test_observer*, to, impl::s_frk_state().m_observers )
+        to->allocations_measured( tc, as );
+}
+
+//____________________________________________________________________________//
+
 } // namespace framework
 } // namespace unit_test
 } // namespace boost
@@ -16,6 +16,7 @@
 #include <boost/test/output/junit_log_formatter.hpp>
 #include <boost/test/execution_monitor.hpp>
 #include <boost/test/framework.hpp>
+#include <boost/test/unit_test_parameters.hpp>
 #include <boost/test/tree/test_unit.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
 #include <boost/test/utils/xml_printer.hpp>
@@ -26,6 +27,8 @@
 #include <boost/test/tree/test_case_counter.hpp>
 #include <boost/test/tree/traverse.hpp>
 #include <boost/test/results_collector.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/alloc_monitor.hpp>
 
 #include <boost/test/utils/algorithm.hpp>
 #include <boost/test/utils/string_cast.hpp>
@@ -40,6 +43,7 @@
 #include <iostream>
 #include <fstream>
 #include <set>
+#include <sstream>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -91,6 +95,10 @@ junit_log_formatter::log_start( std::ostream& ostr, counter_t test_cases_amount)
     map_tests.clear();
     list_path_to_root.clear();
     runner_log_entry.clear();
+
+    m_streaming = runtime_config::get<bool>( runtime_config::btrt_junit_streaming );
+    m_streamed_root = INV_TEST_UNIT_ID;
+    m_skipped.clear();
 }
 
 //____________________________________________________________________________//
@@ -371,6 +379,13 @@ public:
           << " time"      << utils::attr_value() << (tr.p_duration_microseconds * 1E-6)
           << ">" << std::endl;
 
+        write_properties();
+
+        return true; // indicates that the children should also be parsed
+    }
+
+    void    write_properties() const
+    {
         if(m_display_build_info)
         {
             m_stream  << "<properties>" << std::endl;
@@ -383,8 +398,6 @@ public:
             m_stream  << "<property name=\"boost\" value" << utils::attr_value() << o.str() << std::endl;
             m_stream  << "</properties>" << std::endl;
         }
-
-        return true; // indicates that the children should also be parsed
     }
 
     virtual void    test_suite_finish( test_suite const& ts )
@@ -392,10 +405,14 @@ public:
         if( m_ts.p_id != ts.p_id )
             return;
 
+        write_runner_log();
+        m_stream << "</testsuite>";
+    }
+
+    void    write_runner_log() const
+    {
         write_testcase_system_out(runner_log, 0, false, 0);
         write_testcase_system_err(runner_log, 0, 0);
-
-        m_stream << "</testsuite>";
     }
 
 private:
@@ -410,9 +427,134 @@ private:
 
 
 
+// writes out the test cases under the disabled children of a test suite, as the framework
+// does not notify the log about the disabled test units
+class junit_disabled_children_helper : public test_tree_visitor {
+public:
+    junit_disabled_children_helper( junit_result_helper& ch, test_unit_id parent_id )
+    : m_result_helper( ch )
+    , m_parent_id( parent_id )
+    {}
+
+    void    visit( test_case const& tc )
+    {
+        if( !tc.is_enabled() )
+            m_result_helper.visit( tc );
+    }
+
+    bool    test_suite_start( test_suite const& ts )
+    {
+        if( ts.p_id == m_parent_id )
+            return true;
+
+        if( !ts.is_enabled() )
+            traverse_test_tree( ts, m_result_helper, true );
+
+        return false;
+    }
+
+private:
+    // Data members
+    junit_result_helper& m_result_helper;
+    test_unit_id m_parent_id;
+};
+
+//____________________________________________________________________________//
+
+// room left in the opening tag of the streamed test suite for its totals
+static const std::size_t junit_totals_width = 128;
+
+void
+junit_log_formatter::stream_root_start( std::ostream& ostr, test_unit const& tu )
+{
+    m_streamed_root = tu.p_id;
+
+    ostr << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
+    if( tu.p_type != TUT_SUITE )
+        return;
+
+    // the totals are not known yet: they are written in the room left after the tag name
+    ostr << "<testsuite";
+    m_totals_pos = ostr.tellp();
+
+    ostr << std::string( junit_totals_width, ' ' )
+         << " id"   << utils::attr_value() << 0
+         << " name" << utils::attr_value() << tu_name_normalize(tu.p_name)
+         << ">" << std::endl;
+
+    junit_result_helper ch( ostr, tu, map_tests, this->runner_log_entry, m_display_build_info );
+    ch.write_properties();
+}
+
+//____________________________________________________________________________//
+
+void
+junit_log_formatter::stream_root_finish( std::ostream& ostr )
+{
+    test_unit const& root = framework::get( m_streamed_root, TUT_ANY );
+    if( root.p_type != TUT_SUITE )
+        return;
+
+    junit_result_helper ch( ostr, root, map_tests, this->runner_log_entry, m_display_build_info );
+    ch.write_runner_log();
+    ostr << "</testsuite>";
+
+    test_results const& tr = results_collector.results( root.p_id );
+    std::ostringstream totals;
+    totals << " tests"     << utils::attr_value() << tr.p_test_cases_passed
+           << " skipped"   << utils::attr_value() << tr.p_test_cases_skipped
+           << " errors"    << utils::attr_value() << tr.p_test_cases_aborted
+           << " failures"  << utils::attr_value() << tr.p_test_cases_failed
+           << " time"      << utils::attr_value() << (tr.p_duration_microseconds * 1E-6);
+
+    std::streampos end_pos = ostr.tellp();
+    if( m_totals_pos != std::streampos( -1 ) && end_pos != std::streampos( -1 ) &&
+        totals.str().size() <= junit_totals_width && ostr.seekp( m_totals_pos ) ) {
+        ostr << totals.str();
+        ostr.seekp( end_pos );
+    }
+    else {
+        // the sink cannot be repositioned: the totals are trailing the test suite
+        ostr.clear();
+        ostr << std::endl << "<!-- testsuite" << totals.str() << " -->";
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+junit_log_formatter::stream_subtree( std::ostream& ostr, test_unit const& tu )
+{
+    junit_result_helper ch( ostr, framework::get( m_streamed_root, TUT_ANY ), map_tests, this->runner_log_entry, m_display_build_info );
+    traverse_test_tree( tu.p_id, ch, true );
+
+    map_tests.erase( tu.p_id );
+}
+
+//____________________________________________________________________________//
+
+void
+junit_log_formatter::stream_skipped( std::ostream& ostr )
+{
+    // the results collector is notified of a skipped test unit after the log
+    for( ; !m_skipped.empty(); m_skipped.pop_front() )
+        stream_subtree( ostr, framework::get( m_skipped.front(), TUT_ANY ) );
+}
+
+//____________________________________________________________________________//
+
 void
 junit_log_formatter::log_finish( std::ostream& ostr )
 {
+    if( m_streamed_root != INV_TEST_UNIT_ID ) {
+        stream_skipped( ostr );
+
+        // the test run has been interrupted
+        if( !list_path_to_root.empty() )
+            stream_root_finish( ostr );
+        return;
+    }
+
     ostr << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
 
     // getting the root test suite
@@ -449,6 +591,11 @@ junit_log_formatter::log_build_info( std::ostream& ostr )
 void
 junit_log_formatter::test_unit_start( std::ostream& ostr, test_unit const& tu )
 {
+    if( m_streaming && list_path_to_root.empty() )
+        stream_root_start( ostr, tu );
+    else if( m_streamed_root != INV_TEST_UNIT_ID )
+        stream_skipped( ostr );
+
     list_path_to_root.push_back( tu.p_id );
     map_tests.insert(std::make_pair(tu.p_id, junit_impl::junit_log_helper())); // current_test_case_id not working here
 }
@@ -463,6 +610,24 @@ junit_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu,
     // the time is already stored in the result_reporter
     assert( tu.p_id == list_path_to_root.back() );
     list_path_to_root.pop_back();
+
+    if( m_streamed_root == INV_TEST_UNIT_ID )
+        return;
+
+    stream_skipped( ostr );
+
+    if( tu.p_type == TUT_SUITE ) {
+        junit_result_helper ch( ostr, framework::get( m_streamed_root, TUT_ANY ), map_tests, this->runner_log_entry, m_display_build_info );
+        junit_disabled_children_helper dch( ch, tu.p_id );
+        traverse_test_tree( tu.p_id, dch, true );
+
+        if( tu.p_id == m_streamed_root )
+            stream_root_finish( ostr );
+
+        map_tests.erase( tu.p_id );
+    }
+    else
+        stream_subtree( ostr, tu );
 }
 
 void
@@ -482,6 +647,35 @@ junit_log_formatter::test_unit_skipped( std::ostream& ostr, test_unit const& tu,
     // The "skip" boolean is given by the boost.test framework
     junit_impl::junit_log_helper& v = map_tests[tu.p_id]; // not sure if we can use get_current_log_entry()
     v.skipping_reason.assign(reason.begin(), reason.end());
+
+    if( m_streamed_root != INV_TEST_UNIT_ID ) {
+        stream_skipped( ostr );
+        m_skipped.push_back( tu.p_id );
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+junit_log_formatter::log_perf_counters( std::ostream&, test_case const& tc, perf_counters const& pcs )
+{
+    std::ostringstream o;
+    o << "PERFORMANCE COUNTERS:" << std::endl
+      << "- " << pcs << "\n\n";
+
+    map_tests[tc.p_id].system_out.push_back( o.str() );
+}
+
+//____________________________________________________________________________//
+
+void
+junit_log_formatter::log_allocations( std::ostream&, test_case const& tc, alloc_stats const& as )
+{
+    std::ostringstream o;
+    o << "ALLOCATIONS:" << std::endl
+      << "- " << as << "\n\n";
+
+    map_tests[tc.p_id].system_out.push_back( o.str() );
 }
 
 //____________________________________________________________________________//
@@ -547,6 +741,15 @@ junit_log_formatter::log_exception_start( std::ostream& ostr, log_checkpoint_dat
         ;
     }
 
+    if( !ex.backtrace().empty() ) {
+        std::vector<std::string> const frames = ex.backtrace().symbolize();
+
+        o << std::endl << std::endl
+          << "CALL STACK:" << std::endl;
+        for( std::size_t i = 0; i < frames.size(); ++i )
+            o << "#" << i << " " << frames[i] << std::endl;
+    }
+
     entry.output = o.str();
 
     last_entry.assertion_entries.push_back(entry);
@@ -0,0 +1,337 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : implements the observer measuring the performance counters of the test cases
+// ***************************************************************************
+
+#ifndef BOOST_TEST_PERF_MONITOR_IPP_101826GER
+#define BOOST_TEST_PERF_MONITOR_IPP_101826GER
+
+// Boost.Test
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/framework.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+
+#include <boost/test/tree/test_unit.hpp>
+
+// STL
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_PERF_EVENTS
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                 perf_counters                ************** //
+// ************************************************************************** //
+
+namespace {
+
+char const* const s_pc_names[PC_COUNT]          = { "cycles", "instructions", "cache_misses", "branch_misses", "page_faults" };
+char const* const s_pc_descriptions[PC_COUNT]   = { "cycles", "instructions", "cache misses", "branch misses", "page faults" };
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+void
+perf_counters::clear()
+{
+    for( int pc = 0; pc < PC_COUNT; ++pc )
+        m_values[pc] = 0;
+
+    m_measured = 0;
+}
+
+//____________________________________________________________________________//
+
+perf_counters&
+perf_counters::operator+=( perf_counters const& other )
+{
+    for( int pc = 0; pc < PC_COUNT; ++pc )
+        m_values[pc] += other.m_values[pc];
+
+    m_measured |= other.m_measured;
+
+    return *this;
+}
+
+//____________________________________________________________________________//
+
+char const*
+perf_counters::name( perf_counter pc )
+{
+    return s_pc_names[pc];
+}
+
+//____________________________________________________________________________//
+
+std::ostream&
+operator<<( std::ostream& ostr, perf_counters const& pcs )
+{
+    char const* sep = "";
+
+    for( int pc = 0; pc < PC_COUNT; ++pc ) {
+        if( !pcs.is_measured( static_cast<perf_counter>( pc ) ) )
+            continue;
+
+        ostr << sep << pcs.m_values[pc] << ' ' << s_pc_descriptions[pc];
+        sep = ", ";
+    }
+
+    return ostr;
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                 perf_monitor                 ************** //
+// ************************************************************************** //
+
+namespace {
+
+struct perf_monitor_impl {
+    // values of the counters for a test case being executed
+    struct measure {
+        test_unit_id    m_tc_id;
+        counter_t       m_start[PC_COUNT];  // at the start of the execution of the body in progress
+        counter_t       m_total[PC_COUNT];  // during the executions of the body so far
+        bool            m_in_body;
+        bool            m_executed;
+    };
+
+    // Constructor
+    perf_monitor_impl()
+    : m_measured( 0 )
+    , m_runs( 0 )
+    {
+        for( int pc = 0; pc < PC_COUNT; ++pc )
+            m_fds[pc] = -1;
+    }
+    ~perf_monitor_impl() { close(); }
+
+    // Opens the counters available on this system, which count from now on in user space
+    void            open()
+    {
+#ifdef BOOST_TEST_SUPPORT_PERF_EVENTS
+        static const struct {
+            boost::uint32_t m_type;
+            boost::uint64_t m_config;
+        } s_events[PC_COUNT] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+        };
+
+        for( int pc = 0; pc < PC_COUNT; ++pc ) {
+            perf_event_attr attr;
+            std::memset( &attr, 0, sizeof(attr) );
+
+            attr.size           = sizeof(attr);
+            attr.type           = s_events[pc].m_type;
+            attr.config         = s_events[pc].m_config;
+            attr.exclude_kernel = 1;    // allowed to unprivileged processes
+            attr.exclude_hv     = 1;
+            attr.inherit        = 1;    // the threads started by the test cases are counted once they are joined
+
+            m_fds[pc] = static_cast<int>( ::syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 ) );
+
+            if( m_fds[pc] >= 0 )
+                m_measured |= 1u << pc;
+        }
+#endif
+    }
+
+    void            close()
+    {
+#ifdef BOOST_TEST_SUPPORT_PERF_EVENTS
+        for( int pc = 0; pc < PC_COUNT; ++pc ) {
+            if( m_fds[pc] >= 0 )
+                ::close( m_fds[pc] );
+
+            m_fds[pc] = -1;
+        }
+#endif
+        m_measured = 0;
+        m_measures.clear();
+    }
+
+    void            read( counter_t (&values)[PC_COUNT] ) const
+    {
+        for( int pc = 0; pc < PC_COUNT; ++pc ) {
+            values[pc] = 0;
+#ifdef BOOST_TEST_SUPPORT_PERF_EVENTS
+            boost::uint64_t value = 0;
+
+            if( m_fds[pc] >= 0 && ::read( m_fds[pc], &value, sizeof(value) ) == static_cast<ssize_t>( sizeof(value) ) )
+                values[pc] = static_cast<counter_t>( value );
+#endif
+        }
+    }
+
+    // Data members
+    int                     m_fds[PC_COUNT];    // -1 for the counters which are not available
+    unsigned                m_measured;         // bit mask of the opened counters
+    unsigned                m_runs;             // nesting level of the test runs
+    std::vector<measure>    m_measures;         // test cases being executed, the innermost last
+};
+
+perf_monitor_impl& s_pfm_impl() { static perf_monitor_impl the_inst; return the_inst; }
+
+} // local namespace
+
+//____________________________________________________________________________//
+
+void
+perf_monitor_t::test_start( counter_t )
+{
+    // the counters are opened by the outermost test run
+    if( s_pfm_impl().m_runs++ != 0 )
+        return;
+
+    if( runtime_config::get<unsigned>( runtime_config::btrt_parallel ) != 1 ||
+        runtime_config::get<isolation_mode>( runtime_config::btrt_isolation ) != ISOLATION_NONE ) {
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Performance counters are not measured when the test cases are executed "
+                                      "concurrently or in child processes" );
+        return;
+    }
+
+    s_pfm_impl().open();
+
+    if( s_pfm_impl().m_measured == 0 )
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Performance counters are not available on this system" );
+}
+
+//____________________________________________________________________________//
+
+void
+perf_monitor_t::test_finish()
+{
+    if( s_pfm_impl().m_runs == 0 || --s_pfm_impl().m_runs != 0 )
+        return;
+
+    s_pfm_impl().close();
+}
+
+//____________________________________________________________________________//
+
+void
+perf_monitor_t::test_unit_start( test_unit const& tu )
+{
+    if( tu.p_type != TUT_CASE || s_pfm_impl().m_measured == 0 )
+        return;
+
+    perf_monitor_impl::measure m;
+    m.m_tc_id       = tu.p_id;
+    m.m_in_body     = false;
+    m.m_executed    = false;
+    for( int pc = 0; pc < PC_COUNT; ++pc )
+        m.m_total[pc] = 0;
+
+    s_pfm_impl().m_measures.push_back( m );
+}
+
+//____________________________________________________________________________//
+
+void
+perf_monitor_t::test_body_start( test_case const& tc )
+{
+    if( s_pfm_impl().m_measures.empty() || s_pfm_impl().m_measures.back().m_tc_id != tc.p_id )
+        return;
+
+    s_pfm_impl().m_measures.back().m_in_body = true;
+
+    // read last, so that the counters do not include the framework
+    s_pfm_impl().read( s_pfm_impl().m_measures.back().m_start );
+}
+
+//____________________________________________________________________________//
+
+void
+perf_monitor_t::test_body_finish( test_case const& tc )
+{
+    if( s_pfm_impl().m_measures.empty() || s_pfm_impl().m_measures.back().m_tc_id != tc.p_id ||
+        !s_pfm_impl().m_measures.back().m_in_body )
+        return;
+
+    counter_t values[PC_COUNT];
+    s_pfm_impl().read( values );
+
+    perf_monitor_impl::measure& m = s_pfm_impl().m_measures.back();
+    for( int pc = 0; pc < PC_COUNT; ++pc )
+        m.m_total[pc] += values[pc] - m.m_start[pc];
+    m.m_in_body     = false;
+    m.m_executed    = true;
+}
+
+//____________________________________________________________________________//
+
+void
+perf_monitor_t::test_unit_finish( test_unit const& tu, unsigned long )
+{
+    if( tu.p_type != TUT_CASE || s_pfm_impl().m_measures.empty() || s_pfm_impl().m_measures.back().m_tc_id != tu.p_id )
+        return;
+
+    // the body interrupted by a signal is measured up to now
+    test_body_finish( static_cast<test_case const&>( tu ) );
+
+    perf_monitor_impl::measure const m = s_pfm_impl().m_measures.back();
+
+    s_pfm_impl().m_measures.pop_back();
+
+    // the body was not executed if a fixture failed
+    if( !m.m_executed )
+        return;
+
+    perf_counters pcs;
+    std::copy( m.m_total, m.m_total + PC_COUNT, pcs.m_values );
+    pcs.m_measured = s_pfm_impl().m_measured;
+
+    framework::perf_counters_measured( static_cast<test_case const&>( tu ), pcs );
+}
+
+//____________________________________________________________________________//
+
+bool
+perf_monitor_t::is_supported()
+{
+    if( s_pfm_impl().m_measured != 0 )
+        return true;
+
+    perf_monitor_impl probe;
+    probe.open();
+
+    return probe.m_measured != 0;
+}
+
+//____________________________________________________________________________//
+
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_PERF_MONITOR_IPP_101826GER
@@ -19,6 +19,8 @@
 #include <boost/test/output/plain_report_formatter.hpp>
 #include <boost/test/utils/custom_manip.hpp>
 #include <boost/test/results_collector.hpp>
+#include <boost/test/results_reporter.hpp>
+#include <boost/test/unit_test_log_formatter.hpp>
 #include <boost/test/unit_test_parameters.hpp>
 
 #include <boost/test/tree/test_unit.hpp>
@@ -28,6 +30,7 @@
 
 // STL
 #include <iomanip>
+#include <sstream>
 #include <boost/config/no_tr1/cmath.hpp>
 #include <iostream>
 
@@ -125,7 +128,12 @@ plain_report_formatter::test_unit_report_start( test_unit const& tu, std::ostrea
     counter_t total_assertions  = tr.p_assertions_passed + tr.p_assertions_failed;
     counter_t total_tc          = tr.p_test_cases_passed + tr.p_test_cases_warned + tr.p_test_cases_failed + tr.p_test_cases_skipped;
 
-    if( total_assertions > 0 || total_tc > 0 || tr.p_warnings_failed > 0)
+    // the measurements of the test units are only written to the detailed report
+    bool const detailed         = results_reporter::get_level() == DETAILED_REPORT;
+    bool const measured         = detailed && (tr.p_duration_nanoseconds > 0 || !tr.p_perf_counters.get().empty() ||
+                                               !tr.p_alloc_stats.get().empty() || tr.p_peak_resident_bytes > 0);
+
+    if( total_assertions > 0 || total_tc > 0 || tr.p_warnings_failed > 0 || measured )
         ostr << " with:";
 
     ostr << '\n';
@@ -141,6 +149,27 @@ plain_report_formatter::test_unit_report_start( test_unit const& tu, std::ostrea
     print_stat_value( ostr, tr.p_warnings_failed   , m_indent, 0               , "warning"  , "failed" );
     print_stat_value( ostr, tr.p_expected_failures , m_indent, 0               , "failure"  , "expected" );
 
+    if( detailed && tr.p_duration_nanoseconds > 0 ) {
+        std::ostringstream times;
+        times.precision( 3 );
+        times << "wall time: ";
+        ut_detail::print_duration( times, static_cast<double>( tr.p_duration_nanoseconds ) );
+        times << ", CPU time: ";
+        ut_detail::print_duration( times, static_cast<double>( tr.p_cpu_time_nanoseconds ) );
+
+        ostr << std::setw( static_cast<int>(m_indent) ) << "" << times.str() << '\n';
+    }
+
+    if( detailed && !tr.p_perf_counters.get().empty() )
+        ostr << std::setw( static_cast<int>(m_indent) ) << "" << "performance counters: " << tr.p_perf_counters.get() << '\n';
+
+    if( detailed && !tr.p_alloc_stats.get().empty() )
+        ostr << std::setw( static_cast<int>(m_indent) ) << "" << "allocations: " << tr.p_alloc_stats.get() << '\n';
+
+    if( detailed && tr.p_peak_resident_bytes > 0 )
+        ostr << std::setw( static_cast<int>(m_indent) ) << "" << "peak resident memory: " << tr.p_peak_resident_bytes / 1024 << " kB, "
+             << tr.p_minor_page_faults << " minor and " << tr.p_major_page_faults << " major page faults\n";
+
     ostr << '\n';
 }
 
@@ -19,17 +19,22 @@
 #include <boost/test/unit_test_log.hpp>
 #include <boost/test/results_collector.hpp>
 #include <boost/test/framework.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/debug.hpp>
 
 #include <boost/test/tree/test_unit.hpp>
 #include <boost/test/tree/visitor.hpp>
 #include <boost/test/tree/test_case_counter.hpp>
 #include <boost/test/tree/traverse.hpp>
 
+#include <boost/test/utils/timer.hpp>
+
 // Boost
 #include <boost/cstdlib.hpp>
 
 // STL
-#include <map>
+#include <algorithm>
+#include <vector>
 
 #include <boost/test/detail/suppress_warnings.hpp>
 
@@ -84,6 +89,13 @@ test_results::operator+=( test_results const& tr )
     p_test_cases_skipped.value  += tr.p_test_cases_skipped;
     p_test_cases_aborted.value  += tr.p_test_cases_aborted;
     p_duration_microseconds.value += tr.p_duration_microseconds;
+    p_duration_nanoseconds.value += tr.p_duration_nanoseconds;
+    p_cpu_time_nanoseconds.value += tr.p_cpu_time_nanoseconds;
+    p_perf_counters.value       += tr.p_perf_counters.get();
+    p_alloc_stats.value         += tr.p_alloc_stats.get();
+    p_peak_resident_bytes.value = (std::max)( p_peak_resident_bytes.get(), tr.p_peak_resident_bytes.get() );
+    p_minor_page_faults.value   += tr.p_minor_page_faults;
+    p_major_page_faults.value   += tr.p_major_page_faults;
 }
 
 //____________________________________________________________________________//
@@ -101,6 +113,13 @@ test_results::clear()
     p_test_cases_skipped.value  = 0;
     p_test_cases_aborted.value  = 0;
     p_duration_microseconds.value= 0;
+    p_duration_nanoseconds.value = 0;
+    p_cpu_time_nanoseconds.value = 0;
+    p_perf_counters.value.clear();
+    p_alloc_stats.value.clear();
+    p_peak_resident_bytes.value = 0;
+    p_minor_page_faults.value   = 0;
+    p_major_page_faults.value   = 0;
     p_aborted.value             = false;
     p_skipped.value             = false;
 }
@@ -113,90 +132,174 @@ test_results::clear()
 
 namespace {
 
+// Results of the test units indexed by their ids. The ids of the test suites and of the test cases are allocated
+// sequentially from two separate ranges, so the results of each range are stored in a contiguous array
 struct results_collector_impl {
-    std::map<test_unit_id,test_results> m_results_store;
-};
+    struct entry {
+        entry() : m_open( false ), m_memory_at_start(), m_peak_reset( false ) {}
 
-results_collector_impl& s_rc_impl() { static results_collector_impl the_inst; return the_inst; }
+        test_results    m_results;
+        bool            m_open;     // the test unit is started and not finished yet
 
-} // local namespace
+        debug::process_memory_usage m_memory_at_start;  // memory usage sampled at the start of the test case
+        bool                        m_peak_reset;       // the peak resident memory is reset at its start
+    };
 
-//____________________________________________________________________________//
+    void            clear()
+    {
+        m_test_suites.clear();
+        m_test_cases.clear();
+        m_invalid = entry();
+    }
 
-void
-results_collector_t::test_start( counter_t )
-{
-    s_rc_impl().m_results_store.clear();
-}
+    // Entry of the test unit, or 0 if there is no results for it yet
+    entry*          find( test_unit_id id )
+    {
+        std::vector<entry>& entries = range( id );
+        std::size_t         idx     = index( id );
 
-//____________________________________________________________________________//
+        return idx < entries.size() ? &entries[idx] : 0;
+    }
 
-void
-results_collector_t::test_unit_start( test_unit const& tu )
-{
-    // init test_results entry
-    test_results& tr = s_rc_impl().m_results_store[tu.p_id];
+    entry&          get( test_unit_id id )
+    {
+        // assertions can be reported outside of any test case
+        if( id == INV_TEST_UNIT_ID )
+            return m_invalid;
 
-    tr.clear();
+        std::vector<entry>& entries = range( id );
+        std::size_t         idx     = index( id );
 
-    tr.p_expected_failures.value = tu.p_expected_failures;
-}
+        if( idx >= entries.size() )
+            entries.resize( idx + 1 );
+
+        return entries[idx];
+    }
+
+    std::vector<entry>&     range( test_unit_id id )
+    {
+        return ut_detail::test_id_2_unit_type( id ) == TUT_SUITE ? m_test_suites : m_test_cases;
+    }
+    static std::size_t      index( test_unit_id id )
+    {
+        return id - (ut_detail::test_id_2_unit_type( id ) == TUT_SUITE ? MIN_TEST_SUITE_ID : MIN_TEST_CASE_ID);
+    }
+
+    // Data members
+    std::vector<entry>  m_test_suites;
+    std::vector<entry>  m_test_cases;
+    entry               m_invalid;
+    test_results        m_empty;
+    bool                m_sample_memory;    // the memory usage of the test cases is sampled
+};
+
+results_collector_impl& s_rc_impl() { static results_collector_impl the_inst; return the_inst; }
+
+} // local namespace
 
 //____________________________________________________________________________//
 
-class results_collect_helper : public test_tree_visitor {
+class results_collect_helper {
 public:
-    explicit results_collect_helper( test_results& tr, test_unit const& ts ) : m_tr( tr ), m_ts( ts ) {}
-
-    void    visit( test_case const& tc )
+    // Adds the results of the completed test unit to the ones of its parent test suite, if the latter is being
+    // executed. This way the results of the test suite are complete once all its children are done
+    static void add_to_parent( test_unit const& tu, test_results const& tr )
     {
-        test_results const& tr = results_collector.results( tc.p_id );
-        m_tr += tr;
+        results_collector_impl::entry* parent = tu.p_parent_id != INV_TEST_UNIT_ID ? s_rc_impl().find( tu.p_parent_id ) : 0;
+        if( !parent || !parent->m_open )
+            return;
+
+        test_results& ptr = parent->m_results;
+        ptr += tr;
+
+        if( tu.p_type == TUT_SUITE )
+            return;
 
         if( tr.passed() ) {
             if( tr.p_warnings_failed )
-                m_tr.p_test_cases_warned.value++;
+                ptr.p_test_cases_warned.value++;
             else
-                m_tr.p_test_cases_passed.value++;
+                ptr.p_test_cases_passed.value++;
         }
         else if( tr.p_skipped )
-            m_tr.p_test_cases_skipped.value++;
+            ptr.p_test_cases_skipped.value++;
         else {
             if( tr.p_aborted )
-                m_tr.p_test_cases_aborted.value++;
+                ptr.p_test_cases_aborted.value++;
 
-            m_tr.p_test_cases_failed.value++;
+            ptr.p_test_cases_failed.value++;
         }
     }
-    bool    test_suite_start( test_suite const& ts )
-    {
-        if( m_ts.p_id == ts.p_id )
-            return true;
+};
 
-        m_tr += results_collector.results( ts.p_id );
-        return false;
+//____________________________________________________________________________//
+
+void
+results_collector_t::test_start( counter_t )
+{
+    s_rc_impl().clear();
+
+    s_rc_impl().m_sample_memory = runtime_config::get<bool>( runtime_config::btrt_memory_usage );
+    if( !s_rc_impl().m_sample_memory )
+        return;
+
+    debug::process_memory_usage usage;
+    if( runtime_config::get<unsigned>( runtime_config::btrt_parallel ) != 1 ||
+        runtime_config::get<isolation_mode>( runtime_config::btrt_isolation ) != ISOLATION_NONE ) {
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Memory usage is not sampled when the test cases are executed "
+                                      "concurrently or in child processes" );
+        s_rc_impl().m_sample_memory = false;
     }
+    else if( !debug::memory_usage( usage ) ) {
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Memory usage is not available on this system" );
+        s_rc_impl().m_sample_memory = false;
+    }
+}
 
-private:
-    // Data members
-    test_results&       m_tr;
-    test_unit const&    m_ts;
-};
+//____________________________________________________________________________//
+
+void
+results_collector_t::test_unit_start( test_unit const& tu )
+{
+    // init test_results entry
+    results_collector_impl::entry& e = s_rc_impl().get( tu.p_id );
+    test_results& tr = e.m_results;
+
+    tr.clear();
+
+    tr.p_expected_failures.value = tu.p_expected_failures;
+    e.m_open = true;
+
+    if( tu.p_type == TUT_CASE && s_rc_impl().m_sample_memory ) {
+        e.m_peak_reset = debug::reset_peak_memory_usage();
+        debug::memory_usage( e.m_memory_at_start );
+    }
+}
 
 //____________________________________________________________________________//
 
 void
 results_collector_t::test_unit_finish( test_unit const& tu, unsigned long elapsed_in_microseconds )
 {
-    if( tu.p_type == TUT_SUITE ) {
-        results_collect_helper ch( s_rc_impl().m_results_store[tu.p_id], tu );
+    results_collector_impl::entry& e = s_rc_impl().get( tu.p_id );
+    test_results& tr = e.m_results;
 
-        traverse_test_tree( tu, ch );
-    }
-    else {
-        test_results & tr = s_rc_impl().m_results_store[tu.p_id];
+    if( tu.p_type == TUT_CASE ) {
         tr.p_duration_microseconds.value = elapsed_in_microseconds;
 
+        // the test case is not started in this run if a test run is nested in it
+        debug::process_memory_usage usage;
+        if( s_rc_impl().m_sample_memory && e.m_open && debug::memory_usage( usage ) ) {
+            debug::process_memory_usage const& start = e.m_memory_at_start;
+
+            // without a reset, the peak is the one of the whole process
+            tr.p_peak_resident_bytes.value = e.m_peak_reset
+                ? usage.m_peak_resident_bytes
+                : (std::max)( start.m_resident_bytes, usage.m_resident_bytes );
+            tr.p_minor_page_faults.value   = usage.m_minor_page_faults - start.m_minor_page_faults;
+            tr.p_major_page_faults.value   = usage.m_major_page_faults - start.m_major_page_faults;
+        }
+
         bool num_failures_match = tr.p_aborted || tr.p_assertions_failed >= tr.p_expected_failures;
         if( !num_failures_match )
             BOOST_TEST_FRAMEWORK_MESSAGE( "Test case " << tu.full_name() << " has fewer failures than expected" );
@@ -205,6 +308,10 @@ results_collector_t::test_unit_finish( test_unit const& tu, unsigned long elapse
         if( !check_any_assertions )
             BOOST_TEST_FRAMEWORK_MESSAGE( "Test case " << tu.full_name() << " did not check any assertions" );
     }
+
+    e.m_open = false;
+
+    results_collect_helper::add_to_parent( tu, tr );
 }
 
 //____________________________________________________________________________//
@@ -212,7 +319,8 @@ results_collector_t::test_unit_finish( test_unit const& tu, unsigned long elapse
 void
 results_collector_t::test_unit_skipped( test_unit const& tu, const_string /*reason*/ )
 {
-    test_results& tr = s_rc_impl().m_results_store[tu.p_id];
+    results_collector_impl::entry& e = s_rc_impl().get( tu.p_id );
+    test_results& tr = e.m_results;
 
     tr.clear();
 
@@ -224,6 +332,10 @@ results_collector_t::test_unit_skipped( test_unit const& tu, const_string /*reas
 
         tr.p_test_cases_skipped.value = tcc.p_count;
     }
+
+    e.m_open = false;
+
+    results_collect_helper::add_to_parent( tu, tr );
 }
 
 //____________________________________________________________________________//
@@ -231,7 +343,7 @@ results_collector_t::test_unit_skipped( test_unit const& tu, const_string /*reas
 void
 results_collector_t::assertion_result( unit_test::assertion_result ar )
 {
-    test_results& tr = s_rc_impl().m_results_store[framework::current_test_case_id()];
+    test_results& tr = s_rc_impl().get( framework::current_test_case_id() ).m_results;
 
     switch( ar ) {
     case AR_PASSED: tr.p_assertions_passed.value++; break;
@@ -248,17 +360,44 @@ results_collector_t::assertion_result( unit_test::assertion_result ar )
 void
 results_collector_t::exception_caught( execution_exception const& )
 {
-    test_results& tr = s_rc_impl().m_results_store[framework::current_test_case_id()];
+    test_results& tr = s_rc_impl().get( framework::current_test_case_id() ).m_results;
 
     tr.p_assertions_failed.value++;
 }
 
 //____________________________________________________________________________//
 
+void
+results_collector_t::perf_counters_measured( test_case const& tc, perf_counters const& pcs )
+{
+    s_rc_impl().get( tc.p_id ).m_results.p_perf_counters.value = pcs;
+}
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::allocations_measured( test_case const& tc, alloc_stats const& as )
+{
+    s_rc_impl().get( tc.p_id ).m_results.p_alloc_stats.value = as;
+}
+
+//____________________________________________________________________________//
+
+void
+results_collector_t::durations_measured( test_case const& tc, utils::elapsed_time const& et )
+{
+    test_results& tr = s_rc_impl().get( tc.p_id ).m_results;
+
+    tr.p_duration_nanoseconds.value = et.m_wall_ns;
+    tr.p_cpu_time_nanoseconds.value = et.m_cpu_ns;
+}
+
+//____________________________________________________________________________//
+
 void
 results_collector_t::test_unit_aborted( test_unit const& tu )
 {
-    s_rc_impl().m_results_store[tu.p_id].p_aborted.value = true;
+    s_rc_impl().get( tu.p_id ).m_results.p_aborted.value = true;
 }
 
 //____________________________________________________________________________//
@@ -266,7 +405,9 @@ results_collector_t::test_unit_aborted( test_unit const& tu )
 test_results const&
 results_collector_t::results( test_unit_id id ) const
 {
-    return s_rc_impl().m_results_store[id];
+    results_collector_impl::entry* e = id != INV_TEST_UNIT_ID ? s_rc_impl().find( id ) : &s_rc_impl().m_invalid;
+
+    return e ? e->m_results : s_rc_impl().m_empty;
 }
 
 //____________________________________________________________________________//
@@ -122,6 +122,14 @@ get_stream()
 
 //____________________________________________________________________________//
 
+report_level
+get_level()
+{
+    return s_rr_impl().m_report_level;
+}
+
+//____________________________________________________________________________//
+
 void
 set_format( output_format rf )
 {
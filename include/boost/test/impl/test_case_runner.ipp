@@ -0,0 +1,684 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : executes the test cases concurrently in worker threads or in child processes. Part of the
+//                framework implementation, included by framework.ipp
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TEST_CASE_RUNNER_IPP_101826GER
+#define BOOST_TEST_TEST_CASE_RUNNER_IPP_101826GER
+
+// Boost.Test
+#include <boost/test/framework.hpp>
+#include <boost/test/execution_monitor.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_monitor.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/event_recorder.hpp>
+
+#include <boost/test/utils/foreach.hpp>
+#include <boost/test/utils/timer.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+// Boost
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+
+// STL
+#include <string>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+#ifdef BOOST_TEST_SUPPORT_FORK
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <poll.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace framework {
+namespace impl {
+
+// ************************************************************************** //
+// **************               test_case_runner               ************** //
+// ************************************************************************** //
+
+// Test case executed outside of the main thread along with everything it reports
+struct parallel_job {
+    parallel_job( test_unit_id tc_id, log_level threshold, double timeout = 0 )
+    : m_tc_id( tc_id )
+    , m_timeout( timeout )
+    , m_recorder( threshold )
+    , m_result( unit_test_monitor_t::test_ok )
+    , m_executed( false )
+    , m_done( false )
+    {}
+
+    test_unit_id                        m_tc_id;
+    double                              m_timeout;
+    event_recorder                      m_recorder;
+    unit_test_monitor_t::error_level    m_result;
+    utils::elapsed_time                 m_elapsed;
+    bool                                m_executed;     // the body of the test case is executed and timed
+    bool                                m_done;
+};
+
+typedef std::vector<parallel_job> parallel_batch;
+
+#if defined(BOOST_TEST_SUPPORT_THREADS) || defined(BOOST_TEST_SUPPORT_FORK)
+static void execute_parallel_job( parallel_job& job, execution_monitor& em );
+#endif
+
+#if defined(BOOST_TEST_SUPPORT_THREADS) && defined(BOOST_TEST_SUPPORT_FORK)
+static void forget_foreign_threads();
+#endif
+
+//____________________________________________________________________________//
+
+// Executes batches of independent test cases outside of the main thread
+class test_case_runner {
+public:
+    virtual         ~test_case_runner() {}
+
+    // Starts execution of the batch; the batch must be left intact until finish() is called
+    virtual void    start( parallel_batch& batch ) = 0;
+
+    // Waits for the completion of the specific job of the current batch
+    virtual void    wait( parallel_job& job ) = 0;
+
+    // Waits until the runner is done with the current batch
+    virtual void    finish() = 0;
+
+    // Whether the test cases with a timeout can be executed by this runner
+    virtual bool    supports_timeout() const = 0;
+};
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+
+class test_case_pool : public test_case_runner {
+public:
+    explicit test_case_pool( unsigned size )
+    : m_batch( 0 )
+    , m_next( 0 )
+    , m_busy( 0 )
+    , m_generation( 0 )
+    , m_stop( false )
+    {
+        for( unsigned i = 0; i < size; ++i )
+            m_workers.push_back( std::thread( &test_case_pool::work, this ) );
+    }
+
+    ~test_case_pool()
+    {
+        {
+            std::lock_guard<std::mutex> guard( m_mutex );
+            m_stop = true;
+        }
+        m_batch_ready.notify_all();
+
+        BOOST_TEST_FOREACH( std::thread&, worker, m_workers )
+            worker.join();
+    }
+
+    virtual void    start( parallel_batch& batch )
+    {
+        {
+            std::lock_guard<std::mutex> guard( m_mutex );
+            m_batch = &batch;
+            m_next  = 0;
+            ++m_generation;
+        }
+        m_batch_ready.notify_all();
+    }
+
+    virtual void    wait( parallel_job& job )
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        while( !job.m_done )
+            m_job_done.wait( lock );
+    }
+
+    virtual void    finish()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_batch = 0;
+        while( m_busy > 0 )
+            m_job_done.wait( lock );
+    }
+
+    // unless each thread has its own timer, the timer implementing the timeout is process wide
+    virtual bool    supports_timeout() const { return execution_monitor::thread_timeouts_supported(); }
+
+private:
+    void            work()
+    {
+        execution_monitor em;
+        em.copy_exception_translators( unit_test_monitor );
+
+        unsigned long seen_generation = 0;
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+        while( true ) {
+            while( !m_stop && seen_generation == m_generation )
+                m_batch_ready.wait( lock );
+
+            if( m_stop )
+                return;
+
+            seen_generation = m_generation;
+            if( !m_batch ) // batch is completed before this worker woke up
+                continue;
+
+            parallel_batch& batch = *m_batch;
+            ++m_busy;
+            while( m_next < batch.size() ) {
+                parallel_job& job = batch[m_next++];
+
+                lock.unlock();
+                execute_parallel_job( job, em );
+                lock.lock();
+
+                job.m_done = true;
+                m_job_done.notify_all();
+            }
+            --m_busy;
+            m_job_done.notify_all();
+        }
+    }
+
+    // Data members
+    std::vector<std::thread>    m_workers;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_batch_ready;
+    std::condition_variable     m_job_done;
+    parallel_batch*             m_batch;
+    std::size_t                 m_next;
+    unsigned                    m_busy;
+    unsigned long               m_generation;
+    bool                        m_stop;
+};
+
+//____________________________________________________________________________//
+
+// Sets up the pool of threads executing the test cases of a test suite decorated with data_parallel, for the duration
+// of the execution of the test suite, unless the test cases are already dispatched to a runner
+class data_parallel_scope {
+public:
+    data_parallel_scope( test_case_runner*& active_runner, test_suite const& ts )
+    : m_active_runner( active_runner )
+    {
+        if( m_active_runner || ts.p_data_parallel < 2 )
+            return;
+
+        // the measures of the process would include the test cases executed by the other threads
+        if( runtime_config::get<bool>( runtime_config::btrt_track_allocations ) ||
+            runtime_config::get<bool>( runtime_config::btrt_perf_counters ) ||
+            runtime_config::get<bool>( runtime_config::btrt_memory_usage ) ) {
+            BOOST_TEST_FRAMEWORK_MESSAGE( "The test cases of \"" << ts.p_name << "\" are executed serially while "
+                                          "the allocations, performance counters or memory usage are measured" );
+            return;
+        }
+
+        m_runner.reset( new test_case_pool( ts.p_data_parallel ) );
+        m_active_runner = m_runner.get();
+    }
+
+    ~data_parallel_scope()
+    {
+        if( m_runner )
+            m_active_runner = 0;
+    }
+
+private:
+    // Data members
+    test_case_runner*&                  m_active_runner;
+    boost::scoped_ptr<test_case_runner> m_runner;
+};
+
+#endif
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_SUPPORT_FORK
+
+// The child process executing a test case sends the events it records to the parent process through a pipe,
+// followed by the result of the test case. Each record is made of a tag and of the fields of the event or result
+enum job_record_tag { JR_EVENT = 'E', JR_RESULT = 'R' };
+
+static void
+write_field( std::string& buf, std::size_t value )
+{
+    buf.append( reinterpret_cast<char const*>( &value ), sizeof(value) );
+}
+
+//____________________________________________________________________________//
+
+static void
+write_field( std::string& buf, std::string const& value )
+{
+    write_field( buf, value.size() );
+    buf.append( value );
+}
+
+//____________________________________________________________________________//
+
+static bool
+read_field( const_string& buf, std::size_t& value )
+{
+    if( buf.size() < sizeof(value) )
+        return false;
+
+    std::memcpy( &value, buf.begin(), sizeof(value) );
+    buf.trim_left( sizeof(value) );
+    return true;
+}
+
+//____________________________________________________________________________//
+
+static bool
+read_field( const_string& buf, std::string& value )
+{
+    std::size_t size = 0;
+    if( !read_field( buf, size ) || buf.size() < size )
+        return false;
+
+    value.assign( buf.begin(), size );
+    buf.trim_left( size );
+    return true;
+}
+
+//____________________________________________________________________________//
+
+// Buffered output of the records to the pipe. The buffer is sent once it is full and after each failure
+// or log entry, so that the parent process gets these even if the child process does not end gracefully
+class job_channel {
+public:
+    explicit job_channel( int fd ) : m_fd( fd ) {}
+
+    void            send_event( event_recorder::event const& e )
+    {
+        m_buffer += static_cast<char>( JR_EVENT );
+        write_field( m_buffer, static_cast<std::size_t>( e.m_type ) );
+        write_field( m_buffer, static_cast<std::size_t>( e.m_code ) );
+        write_field( m_buffer, e.m_num );
+        write_field( m_buffer, e.m_file );
+        write_field( m_buffer, e.m_function );
+        write_field( m_buffer, e.m_text );
+        write_field( m_buffer, e.m_context.size() );
+        BOOST_TEST_FOREACH( std::string const&, frame, e.m_context )
+            write_field( m_buffer, frame );
+
+        // the child process is a copy of the parent one, so the addresses of the call stack are valid in both
+        write_field( m_buffer, e.m_backtrace.size() );
+        BOOST_TEST_FOREACH( void*, address, e.m_backtrace )
+            write_field( m_buffer, reinterpret_cast<std::size_t>( address ) );
+
+        write_field( m_buffer, e.m_values.size() );
+        BOOST_TEST_FOREACH( counter_t, value, e.m_values )
+            write_field( m_buffer, static_cast<std::size_t>( value ) );
+
+        bool failure = e.m_type == event_recorder::ET_EXCEPTION ||
+                       (e.m_type == event_recorder::ET_ASSERTION && e.m_code != AR_PASSED);
+
+        if( m_buffer.size() >= 4096 || failure || e.m_type == event_recorder::ET_LOG_END )
+            flush();
+    }
+
+    void            send_result( parallel_job const& job )
+    {
+        m_buffer += static_cast<char>( JR_RESULT );
+        write_field( m_buffer, static_cast<std::size_t>( -job.m_result ) );
+        write_field( m_buffer, static_cast<std::size_t>( job.m_executed ) );
+        write_field( m_buffer, static_cast<std::size_t>( job.m_elapsed.m_wall_ns ) );
+        write_field( m_buffer, static_cast<std::size_t>( job.m_elapsed.m_cpu_ns ) );
+
+        flush();
+    }
+
+    void            flush()
+    {
+        char const* data = m_buffer.data();
+        std::size_t size = m_buffer.size();
+
+        while( size > 0 ) {
+            ssize_t written = ::write( m_fd, data, size );
+            if( written < 0 ) {
+                if( errno == EINTR )
+                    continue;
+                break; // parent process is gone; nothing else to do
+            }
+
+            data += written;
+            size -= static_cast<std::size_t>( written );
+        }
+
+        m_buffer.clear();
+    }
+
+private:
+    // Data members
+    int             m_fd;
+    std::string     m_buffer;
+};
+
+//____________________________________________________________________________//
+
+// Decodes the records sent by the child process into the job; returns false if the result is missing
+static bool
+decode_job_records( const_string buf, parallel_job& job )
+{
+    while( !buf.is_empty() ) {
+        char tag = buf[0];
+        buf.trim_left( 1 );
+
+        std::size_t type = 0, code = 0, executed = 0, wall_ns = 0, cpu_ns = 0;
+
+        if( tag == JR_RESULT ) {
+            if( !read_field( buf, code ) || !read_field( buf, executed ) || !read_field( buf, wall_ns ) || !read_field( buf, cpu_ns ) )
+                return false;
+
+            job.m_result            = static_cast<unit_test_monitor_t::error_level>( -static_cast<int>( code ) );
+            job.m_executed          = executed != 0;
+            job.m_elapsed.m_wall_ns = wall_ns;
+            job.m_elapsed.m_cpu_ns  = cpu_ns;
+            return true;
+        }
+
+        if( tag != JR_EVENT || !read_field( buf, type ) || !read_field( buf, code ) )
+            return false;
+
+        event_recorder::event e( static_cast<event_recorder::event_type>( type ) );
+        e.m_code = static_cast<int>( code );
+
+        std::size_t context_size = 0;
+        if( !read_field( buf, e.m_num ) || !read_field( buf, e.m_file ) || !read_field( buf, e.m_function ) ||
+            !read_field( buf, e.m_text ) || !read_field( buf, context_size ) )
+            return false;
+
+        e.m_context.resize( context_size );
+        BOOST_TEST_FOREACH( std::string&, frame, e.m_context ) {
+            if( !read_field( buf, frame ) )
+                return false;
+        }
+
+        std::size_t backtrace_size = 0;
+        if( !read_field( buf, backtrace_size ) )
+            return false;
+
+        e.m_backtrace.resize( backtrace_size );
+        BOOST_TEST_FOREACH( void*&, address, e.m_backtrace ) {
+            std::size_t value = 0;
+            if( !read_field( buf, value ) )
+                return false;
+            address = reinterpret_cast<void*>( value );
+        }
+
+        std::size_t values_size = 0;
+        if( !read_field( buf, values_size ) )
+            return false;
+
+        e.m_values.resize( values_size );
+        BOOST_TEST_FOREACH( counter_t&, value, e.m_values ) {
+            std::size_t field = 0;
+            if( !read_field( buf, field ) )
+                return false;
+            value = static_cast<counter_t>( field );
+        }
+
+        job.m_recorder.events().push_back( e );
+    }
+
+    return false;
+}
+
+//____________________________________________________________________________//
+
+// Executes each test case of the batch in a forked child process, keeping up to the specified number of them
+// running at the same time. The parent process collects the events sent by the children, and reports
+// the children terminating prematurely as failures of their test cases
+class process_pool : public test_case_runner {
+public:
+    explicit process_pool( unsigned size )
+    : m_size( size )
+    , m_batch( 0 )
+    , m_next( 0 )
+    {}
+
+    ~process_pool()
+    {
+        finish();
+    }
+
+    virtual void    start( parallel_batch& batch )
+    {
+        m_batch = &batch;
+        m_next  = 0;
+    }
+
+    virtual void    wait( parallel_job& job )
+    {
+        while( !job.m_done ) {
+            while( m_children.size() < m_size && m_next < m_batch->size() )
+                spawn( (*m_batch)[m_next++] );
+
+            if( !job.m_done )
+                receive();
+        }
+    }
+
+    virtual void    finish()
+    {
+        // the jobs still running are not going to be reported
+        BOOST_TEST_FOREACH( child&, c, m_children ) {
+            ::kill( c.m_pid, SIGKILL );
+            ::close( c.m_fd );
+            reap( c.m_pid );
+        }
+
+        m_children.clear();
+        m_batch = 0;
+    }
+
+    // the alarm is specific to the child process
+    virtual bool    supports_timeout() const { return true; }
+
+private:
+    struct child {
+        pid_t           m_pid;
+        int             m_fd;
+        parallel_job*   m_job;
+        std::string     m_data;
+    };
+
+    void            spawn( parallel_job& job )
+    {
+        // otherwise the child process outputs again what is buffered by the parent process
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush( 0 );
+
+        int read_fd  = -1;
+        int write_fd = -1;
+        pid_t pid = open_child( read_fd, write_fd );
+
+        if( pid < 0 ) {
+            // out of resources: the test case is executed without isolation rather than not at all
+            execute_parallel_job( job, unit_test_monitor );
+            job.m_done = true;
+            return;
+        }
+
+        if( pid == 0 ) {
+            ::close( read_fd );
+            execute_in_child( job, write_fd );
+        }
+
+        ::close( write_fd );
+
+        child c;
+        c.m_pid = pid;
+        c.m_fd  = read_fd;
+        c.m_job = &job;
+        m_children.push_back( c );
+    }
+
+    // Creates the pipe from the child process to this process and forks. Returns the pid of the child process, or -1
+    // if either could not be created
+    static pid_t    open_child( int& read_fd, int& write_fd )
+    {
+        int fds[2];
+        if( ::pipe( fds ) != 0 )
+            return -1;
+
+        pid_t pid = ::fork();
+        if( pid < 0 ) {
+            ::close( fds[0] );
+            ::close( fds[1] );
+            return pid;
+        }
+
+        read_fd  = fds[0];
+        write_fd = fds[1];
+
+        return pid;
+    }
+
+    // Executes the test case of the job in the child process, and sends its records through the pipe
+    static void     execute_in_child( parallel_job& job, int write_fd )
+    {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+        forget_foreign_threads();
+#endif
+
+        job_channel channel( write_fd );
+        job.m_recorder.set_sink( boost::bind( &job_channel::send_event, &channel, _1 ) );
+
+        execute_parallel_job( job, unit_test_monitor );
+
+        job.m_recorder.flush();
+        channel.send_result( job );
+
+        std::cout.flush();
+        std::cerr.flush();
+        std::fflush( 0 );
+
+        // skip the destruction of the test module state shared with the parent process
+        ::_exit( 0 );
+    }
+
+    // Reads the records available from the children, and completes the jobs of the children done
+    void            receive()
+    {
+        if( m_children.empty() )
+            return;
+
+        std::vector<pollfd> fds( m_children.size() );
+        for( std::size_t i = 0; i < m_children.size(); ++i ) {
+            fds[i].fd      = m_children[i].m_fd;
+            fds[i].events  = POLLIN;
+            fds[i].revents = 0;
+        }
+
+        if( ::poll( &fds[0], static_cast<nfds_t>( fds.size() ), -1 ) < 0 )
+            return;
+
+        for( std::size_t i = fds.size(); i > 0; --i ) {
+            if( fds[i-1].revents == 0 )
+                continue;
+
+            child& c = m_children[i-1];
+
+            char buf[4096];
+            ssize_t size = ::read( c.m_fd, buf, sizeof(buf) );
+
+            if( size > 0 )
+                c.m_data.append( buf, static_cast<std::size_t>( size ) );
+            else if( size == 0 || errno != EINTR ) {
+                complete( c );
+                m_children.erase( m_children.begin() + (i-1) );
+            }
+        }
+    }
+
+    void            complete( child& c )
+    {
+        ::close( c.m_fd );
+        int status = reap( c.m_pid );
+
+        parallel_job& job = *c.m_job;
+
+        if( !decode_job_records( c.m_data, job ) ) {
+            event_recorder::event e( event_recorder::ET_EXCEPTION );
+            e.m_code = execution_exception::system_error;
+            e.m_file = "unknown location";
+            e.m_text = WIFSIGNALED( status )
+                ? "child process executing the test case was terminated by signal " + utils::string_cast( WTERMSIG( status ) )
+                : "child process executing the test case exited with code " + utils::string_cast( WEXITSTATUS( status ) );
+            job.m_recorder.events().push_back( e );
+
+            event_recorder::event aborted( event_recorder::ET_ABORTED );
+            aborted.m_num = job.m_tc_id;
+            job.m_recorder.events().push_back( aborted );
+
+            job.m_result = unit_test_monitor_t::os_exception;
+        }
+        else if( unit_test_monitor.is_critical_error( job.m_result ) ) {
+            // the state of the test module is not affected by the failure of the child process
+            job.m_result = unit_test_monitor_t::os_exception;
+        }
+
+        job.m_done = true;
+    }
+
+    static int      reap( pid_t pid )
+    {
+        int status = 0;
+        while( ::waitpid( pid, &status, 0 ) < 0 && errno == EINTR )
+            ;
+
+        return status;
+    }
+
+    // Data members
+    unsigned            m_size;
+    parallel_batch*     m_batch;
+    std::size_t         m_next;
+    std::vector<child>  m_children;
+};
+
+#endif
+
+//____________________________________________________________________________//
+
+} // namespace impl
+} // namespace framework
+} // namespace unit_test
+} // namespace boost
+
+#endif // BOOST_TEST_TEST_CASE_RUNNER_IPP_101826GER
@@ -0,0 +1,531 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : schedules the test cases using the durations of the previous runs: sharding, longest
+//                test units first and rerun of the failed test cases. Part of the framework
+//                implementation, included by framework.ipp
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TEST_SCHEDULE_IPP_101826GER
+#define BOOST_TEST_TEST_SCHEDULE_IPP_101826GER
+
+// Boost.Test
+#include <boost/test/framework.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/results_collector.hpp>
+
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/tree/visitor.hpp>
+#include <boost/test/tree/traverse.hpp>
+
+#include <boost/test/utils/foreach.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+
+// STL
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace framework {
+namespace impl {
+
+// ************************************************************************** //
+// **************                test_durations                ************** //
+// ************************************************************************** //
+
+// Durations and results of the test cases measured by previous runs. These are stored in a text file with one
+// line per test case: the duration in microseconds, followed by the letter F if the test case failed, then a
+// space and the full name of the test case
+class test_durations {
+public:
+    typedef std::map<std::string,unsigned long> store;
+
+    // Missing file is the same as empty one: there is no history before the first run
+    void            load( std::string const& file_name )
+    {
+        std::ifstream in( file_name.c_str() );
+
+        std::string line;
+        while( std::getline( in, line ) ) {
+            std::string::size_type sep = line.find( ' ' );
+            if( sep == std::string::npos || sep == 0 )
+                continue;
+
+            std::string name = line.substr( sep + 1 );
+
+            m_durations[name] = std::strtoul( line.c_str(), 0, 10 );
+            if( line[sep - 1] == 'F' )
+                m_failures.insert( name );
+        }
+    }
+
+    // Duration of the test case, or 0 if it is unknown
+    unsigned long   get( std::string const& full_name ) const
+    {
+        store::const_iterator it = m_durations.find( full_name );
+
+        return it != m_durations.end() ? it->second : 0;
+    }
+
+    // Whether the test case failed the last time it was executed
+    bool            failed( std::string const& full_name ) const { return m_failures.count( full_name ) != 0; }
+
+    void            set( std::string const& full_name, unsigned long duration, bool failed )
+    {
+        m_durations[full_name] = duration;
+
+        if( failed )
+            m_failures.insert( full_name );
+        else
+            m_failures.erase( full_name );
+    }
+
+    bool            save( std::string const& file_name ) const
+    {
+        std::ofstream out( file_name.c_str() );
+
+        BOOST_TEST_FOREACH( store::value_type const&, d, m_durations )
+            out << d.second << (failed( d.first ) ? "F " : " ") << d.first << '\n';
+
+        return static_cast<bool>( out.flush() );
+    }
+
+    // Duration assumed for the test cases without history: the average duration of the listed ones
+    unsigned long   average( test_unit_id_list const& tcs ) const
+    {
+        unsigned long known_duration = 0, known_count = 0;
+        BOOST_TEST_FOREACH( test_unit_id, tc_id, tcs ) {
+            unsigned long d = get( framework::get( tc_id, TUT_CASE ).full_name() );
+
+            if( d != 0 ) {
+                known_duration += d;
+                ++known_count;
+            }
+        }
+
+        return known_count != 0 ? (std::max)( known_duration / known_count, 1UL ) : 1UL;
+    }
+
+    bool            empty() const   { return m_durations.empty(); }
+
+private:
+    // Data members
+    store                   m_durations;
+    std::set<std::string>   m_failures;
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                 select_shard                 ************** //
+// ************************************************************************** //
+
+class enabled_test_case_collector : public test_tree_visitor {
+public:
+    explicit enabled_test_case_collector( test_unit_id_list& targ ) : m_targ( targ ) {}
+
+private:
+    virtual void    visit( test_case const& tc )
+    {
+        if( tc.p_run_status == test_unit::RS_ENABLED )
+            m_targ.push_back( tc.p_id );
+    }
+
+    // Data members
+    test_unit_id_list&  m_targ;
+};
+
+//____________________________________________________________________________//
+
+class dependencies_collector : public test_tree_visitor {
+public:
+    explicit dependencies_collector( test_unit_id_list& targ ) : m_targ( targ ) {}
+
+private:
+    virtual bool    visit( test_unit const& tu )
+    {
+        if( !tu.p_dependencies.get().empty() )
+            m_targ.push_back( tu.p_id );
+
+        return true;
+    }
+
+    // Data members
+    test_unit_id_list&  m_targ;
+};
+
+//____________________________________________________________________________//
+
+// FNV-1a hash of the test case name; unlike the test unit ids, it does not depend on the registration order
+static boost::uint32_t
+stable_name_hash( std::string const& name )
+{
+    boost::uint32_t hash = 2166136261u;
+
+    BOOST_TEST_FOREACH( char, c, name ) {
+        hash ^= static_cast<unsigned char>( c );
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+//____________________________________________________________________________//
+
+// Test cases, which have to be executed in the same shard because of the dependencies between them
+struct shard_group {
+    shard_group() : m_duration( 0 ) {}
+
+    std::string         m_name;     // lowest full name of the test cases in the group
+    unsigned long       m_duration; // sum of the durations of the test cases in the group
+    test_unit_id_list   m_tcs;
+};
+
+struct longest_group_first {
+    bool operator()( shard_group const* lhs, shard_group const* rhs ) const
+    {
+        return lhs->m_duration != rhs->m_duration ? lhs->m_duration > rhs->m_duration : lhs->m_name < rhs->m_name;
+    }
+};
+
+//____________________________________________________________________________//
+
+static std::size_t
+find_group( std::vector<std::size_t>& groups, std::size_t i )
+{
+    while( groups[i] != i ) {
+        groups[i] = groups[groups[i]];
+        i = groups[i];
+    }
+
+    return i;
+}
+
+//____________________________________________________________________________//
+
+// Disables the enabled test cases not assigned to the specified shard. The test cases are assigned to the
+// shards based on the hash of their names, or using the durations if any so that shards take the same time.
+// Either way the assignment is the same for all the shards, and the test cases depending on each other are
+// assigned to the same shard
+static void
+select_shard( test_unit_id master_tu_id, unsigned shard_index, unsigned shard_count, test_durations const& durations )
+{
+    // 10. Collect the enabled test cases
+    test_unit_id_list tcs;
+    enabled_test_case_collector tcc( tcs );
+    traverse_test_tree( master_tu_id, tcc, true );
+
+    std::map<test_unit_id,std::size_t> tc_index;
+    for( std::size_t i = 0; i < tcs.size(); ++i )
+        tc_index[tcs[i]] = i;
+
+    // 20. Join the test cases of the test units depending on each other: dependency of a test suite applies
+    // to all its test cases, and dependency on a test suite involves all its test cases
+    std::vector<std::size_t> groups( tcs.size() );
+    for( std::size_t i = 0; i < groups.size(); ++i )
+        groups[i] = i;
+
+    test_unit_id_list dependants;
+    dependencies_collector dc( dependants );
+    traverse_test_tree( master_tu_id, dc, true );
+
+    BOOST_TEST_FOREACH( test_unit_id, tu_id, dependants ) {
+        test_unit_id_list related;
+        enabled_test_case_collector rc( related );
+        traverse_test_tree( tu_id, rc, true );
+
+        BOOST_TEST_FOREACH( test_unit_id, dep_id, framework::get( tu_id, TUT_ANY ).p_dependencies.get() )
+            traverse_test_tree( dep_id, rc, true );
+
+        for( std::size_t i = 1; i < related.size(); ++i )
+            groups[find_group( groups, tc_index[related[i]] )] = find_group( groups, tc_index[related[0]] );
+    }
+
+    // 30. Build the groups
+    unsigned long default_duration = durations.average( tcs );
+
+    std::map<std::size_t,shard_group> group_store;
+    for( std::size_t i = 0; i < tcs.size(); ++i ) {
+        shard_group& group = group_store[find_group( groups, i )];
+        std::string name = framework::get( tcs[i], TUT_CASE ).full_name();
+        unsigned long d = durations.get( name );
+
+        if( group.m_tcs.empty() || name < group.m_name )
+            group.m_name = name;
+        group.m_duration += d != 0 ? d : default_duration;
+        group.m_tcs.push_back( tcs[i] );
+    }
+
+    // 40. Assign the groups to the shards
+    std::vector<shard_group const*> assigned;
+
+    if( durations.empty() ) {
+        typedef std::map<std::size_t,shard_group>::value_type group_entry;
+        BOOST_TEST_FOREACH( group_entry const&, g, group_store ) {
+            if( stable_name_hash( g.second.m_name ) % shard_count == shard_index )
+                assigned.push_back( &g.second );
+        }
+    }
+    else {
+        // longest processing time first: each group goes to the shard with the least work assigned so far
+        std::vector<shard_group const*> sorted;
+        typedef std::map<std::size_t,shard_group>::value_type group_entry;
+        BOOST_TEST_FOREACH( group_entry const&, g, group_store )
+            sorted.push_back( &g.second );
+        std::sort( sorted.begin(), sorted.end(), longest_group_first() );
+
+        std::vector<unsigned long> load( shard_count, 0 );
+        BOOST_TEST_FOREACH( shard_group const*, g, sorted ) {
+            std::size_t shard = static_cast<std::size_t>( std::min_element( load.begin(), load.end() ) - load.begin() );
+
+            load[shard] += g->m_duration;
+            if( shard == shard_index )
+                assigned.push_back( g );
+        }
+    }
+
+    // 50. Disable the test cases assigned to the other shards
+    std::set<test_unit_id> kept;
+    BOOST_TEST_FOREACH( shard_group const*, g, assigned )
+        kept.insert( g->m_tcs.begin(), g->m_tcs.end() );
+
+    BOOST_TEST_FOREACH( test_unit_id, tc_id, tcs ) {
+        if( kept.count( tc_id ) == 0 )
+            framework::get( tc_id, TUT_CASE ).p_run_status.value = test_unit::RS_DISABLED;
+    }
+
+    // 60. The test suites generating their test cases on demand are assigned to the shards as a whole
+    test_unit_id_list lazy_suites;
+    lazy_suite_collector lsc( lazy_suites );
+    traverse_test_tree( master_tu_id, lsc, true );
+
+    BOOST_TEST_FOREACH( test_unit_id, ts_id, lazy_suites ) {
+        test_unit& ts = framework::get( ts_id, TUT_SUITE );
+
+        if( stable_name_hash( ts.full_name() ) % shard_count != shard_index )
+            ts.p_run_status.value = test_unit::RS_DISABLED;
+    }
+
+    BOOST_TEST_FRAMEWORK_MESSAGE( "Shard " << shard_index << " of " << shard_count << " executes " << kept.size()
+                                  << " test cases out of " << tcs.size() );
+}
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************              schedule_longest_first          ************** //
+// ************************************************************************** //
+
+typedef std::map<test_unit_id,unsigned long> expected_durations;
+
+// Estimates the duration of each enabled test unit: the duration measured by the previous runs for the
+// test cases, and the sum of the durations of their test cases for the test suites
+class expected_duration_collector : public test_tree_visitor {
+public:
+    expected_duration_collector( test_durations const& durations, unsigned long default_duration, expected_durations& targ )
+    : m_durations( durations )
+    , m_default_duration( default_duration )
+    , m_targ( targ )
+    {}
+
+private:
+    virtual void    visit( test_case const& tc )
+    {
+        unsigned long d = m_durations.get( tc.full_name() );
+
+        add( tc.p_id, d != 0 ? d : m_default_duration );
+    }
+    virtual bool    test_suite_start( test_suite const& ts )
+    {
+        m_targ[ts.p_id] = 0;
+        m_suites.push_back( ts.p_id );
+
+        return true;
+    }
+    virtual void    test_suite_finish( test_suite const& ts )
+    {
+        m_suites.pop_back();
+
+        unsigned long d = m_targ[ts.p_id];
+        m_targ.erase( ts.p_id );
+        add( ts.p_id, d );
+    }
+
+    void            add( test_unit_id tu_id, unsigned long d )
+    {
+        m_targ[tu_id] = d;
+        if( !m_suites.empty() )
+            m_targ[m_suites.back()] += d;
+    }
+
+    // Data members
+    test_durations const&   m_durations;
+    unsigned long           m_default_duration;
+    expected_durations&     m_targ;
+    test_unit_id_list       m_suites;
+};
+
+//____________________________________________________________________________//
+
+struct longest_expected_first {
+    explicit longest_expected_first( expected_durations const& durations ) : m_durations( durations ) {}
+
+    bool operator()( test_unit_id lhs, test_unit_id rhs ) const
+    {
+        return get( lhs ) > get( rhs );
+    }
+
+private:
+    unsigned long get( test_unit_id tu_id ) const
+    {
+        expected_durations::const_iterator it = m_durations.find( tu_id );
+
+        return it != m_durations.end() ? it->second : 0;
+    }
+
+    // Data members
+    expected_durations const& m_durations;
+};
+
+//____________________________________________________________________________//
+
+// ************************************************************************** //
+// **************                 rerun_failed                 ************** //
+// ************************************************************************** //
+
+// Collects the enabled test cases which failed in the previous runs, along with the test suites holding them
+static void
+collect_failed( test_unit_id master_tu_id, test_durations const& durations, std::set<test_unit_id>& failed_units )
+{
+    test_unit_id_list tcs;
+    enabled_test_case_collector tcc( tcs );
+    traverse_test_tree( master_tu_id, tcc, true );
+
+    BOOST_TEST_FOREACH( test_unit_id, tc_id, tcs ) {
+        if( !durations.failed( framework::get( tc_id, TUT_CASE ).full_name() ) )
+            continue;
+
+        for( test_unit_id tu_id = tc_id; tu_id != INV_TEST_UNIT_ID && failed_units.insert( tu_id ).second; )
+            tu_id = framework::get( tu_id, TUT_ANY ).p_parent_id;
+    }
+}
+
+//____________________________________________________________________________//
+
+// Disables the enabled test cases, except the ones which failed in the previous runs and the test cases they
+// depend on. If none of them failed, all the test cases are kept
+static void
+select_failed( test_unit_id master_tu_id, test_durations const& durations )
+{
+    test_unit_id_list tcs;
+    enabled_test_case_collector tcc( tcs );
+    traverse_test_tree( master_tu_id, tcc, true );
+
+    test_unit_id_list to_keep;
+    BOOST_TEST_FOREACH( test_unit_id, tc_id, tcs ) {
+        if( durations.failed( framework::get( tc_id, TUT_CASE ).full_name() ) )
+            to_keep.push_back( tc_id );
+    }
+
+    if( to_keep.empty() ) {
+        BOOST_TEST_FRAMEWORK_MESSAGE( "No test case failed in the previous runs: all the test cases are executed" );
+        return;
+    }
+
+    std::size_t failed_count = to_keep.size();
+
+    // the dependencies of a test suite apply to all its test cases
+    std::set<test_unit_id> kept;
+    while( !to_keep.empty() ) {
+        test_unit_id tc_id = to_keep.back();
+        to_keep.pop_back();
+
+        if( !kept.insert( tc_id ).second )
+            continue;
+
+        for( test_unit_id tu_id = tc_id; tu_id != INV_TEST_UNIT_ID; tu_id = framework::get( tu_id, TUT_ANY ).p_parent_id ) {
+            enabled_test_case_collector dc( to_keep );
+
+            BOOST_TEST_FOREACH( test_unit_id, dep_id, framework::get( tu_id, TUT_ANY ).p_dependencies.get() )
+                traverse_test_tree( dep_id, dc, true );
+        }
+    }
+
+    BOOST_TEST_FOREACH( test_unit_id, tc_id, tcs ) {
+        if( kept.count( tc_id ) == 0 )
+            framework::get( tc_id, TUT_CASE ).p_run_status.value = test_unit::RS_DISABLED;
+    }
+
+    BOOST_TEST_FRAMEWORK_MESSAGE( "Rerun executes " << failed_count << " failed test cases and "
+                                  << kept.size() - failed_count << " of their dependencies out of "
+                                  << tcs.size() << " test cases" );
+}
+
+//____________________________________________________________________________//
+
+struct failed_first {
+    explicit failed_first( std::set<test_unit_id> const& failed_units ) : m_failed_units( failed_units ) {}
+
+    bool operator()( test_unit_id tu_id ) const
+    {
+        return m_failed_units.count( tu_id ) != 0;
+    }
+
+private:
+    // Data members
+    std::set<test_unit_id> const& m_failed_units;
+};
+
+//____________________________________________________________________________//
+
+// Updates the file of durations with the durations of the test cases executed by this run; the durations
+// of the other test cases, like the ones belonging to other shards, are kept
+static void
+save_durations( test_unit_id master_tu_id, std::string const& file_name )
+{
+    test_durations durations;
+    durations.load( file_name );
+
+    test_unit_id_list tcs;
+    enabled_test_case_collector tcc( tcs );
+    traverse_test_tree( master_tu_id, tcc, true );
+
+    BOOST_TEST_FOREACH( test_unit_id, tc_id, tcs ) {
+        test_results const& tr = results_collector.results( tc_id );
+        if( tr.p_skipped )
+            continue;
+
+        // zero duration stands for the unknown one
+        durations.set( framework::get( tc_id, TUT_CASE ).full_name(), (std::max)( tr.p_duration_microseconds.get(), 1UL ), !tr.passed() );
+    }
+
+    if( !durations.save( file_name ) )
+        BOOST_TEST_FRAMEWORK_MESSAGE( "Durations of the test cases can't be saved to " << file_name );
+}
+
+//____________________________________________________________________________//
+
+} // namespace impl
+} // namespace framework
+} // namespace unit_test
+} // namespace boost
+
+#endif // BOOST_TEST_TEST_SCHEDULE_IPP_101826GER
@@ -313,8 +313,15 @@ report_assertion( assertion_result const&   ar,
     BOOST_TEST_I_ASSRT( framework::current_test_case_id() != INV_TEST_UNIT_ID,
                         std::runtime_error( "Can't use testing tools outside of test case implementation." ) );
 
-    if( !!ar )
+    if( !!ar ) {
+        // the passing assertions which are not reported by any logger are only counted
+        if( unit_test_log.get_min_threshold_level() > log_successful_tests ) {
+            framework::assertion_result( AR_PASSED );
+            return true;
+        }
+
         tl = PASS;
+    }
 
     log_level    ll;
     char const*  prefix;
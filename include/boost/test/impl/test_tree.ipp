@@ -30,9 +30,6 @@
 
 #include <boost/test/unit_test_parameters.hpp>
 
-// Boost
-#include <boost/timer.hpp>
-
 // STL
 #include <algorithm>
 #include <vector>
@@ -58,6 +55,12 @@ test_unit::test_unit( const_string name, const_string file_name, std::size_t lin
 , p_name( std::string( name.begin(), name.size() ) )
 , p_timeout( 0 )
 , p_expected_failures( 0 )
+, p_serial( false )
+, p_max_regression( 0 )
+, p_regression_repeats( 1 )
+, p_max_allocations( NO_ALLOCATION_LIMIT )
+, p_memory_budget( 0 )
+, p_data_parallel( 0 )
 , p_default_status( RS_INHERIT )
 , p_run_status( RS_INVALID )
 , p_sibling_rank(0)
@@ -75,6 +78,12 @@ test_unit::test_unit( const_string module_name )
 , p_name( std::string( module_name.begin(), module_name.size() ) )
 , p_timeout( 0 )
 , p_expected_failures( 0 )
+, p_serial( false )
+, p_max_regression( 0 )
+, p_regression_repeats( 1 )
+, p_max_allocations( NO_ALLOCATION_LIMIT )
+, p_memory_budget( 0 )
+, p_data_parallel( 0 )
 , p_default_status( RS_INHERIT )
 , p_run_status( RS_INVALID )
 , p_sibling_rank(0)
@@ -216,6 +225,17 @@ test_case::test_case( const_string name, const_string file_name, std::size_t lin
 
 //____________________________________________________________________________//
 
+test_case::test_case( const_string name, const_string file_name, std::size_t line_num,
+                      boost::function<void ()> const& test_func, boost::function<void (counter_t)> const& benchmark_func )
+: test_unit( name, file_name, line_num, static_cast<test_unit_type>(type) )
+, p_test_func( test_func )
+, p_benchmark_func( benchmark_func )
+{
+    framework::register_test_unit( this );
+}
+
+//____________________________________________________________________________//
+
 // ************************************************************************** //
 // **************                  test_suite                  ************** //
 // ************************************************************************** //
@@ -224,6 +244,7 @@ test_case::test_case( const_string name, const_string file_name, std::size_t lin
 
 test_suite::test_suite( const_string name, const_string file_name, std::size_t line_num )
 : test_unit( name, file_name, line_num, static_cast<test_unit_type>(type) )
+, m_all_samples( false )
 {
     framework::register_test_unit( this );
 }
@@ -232,6 +253,7 @@ test_suite::test_suite( const_string name, const_string file_name, std::size_t l
 
 test_suite::test_suite( const_string module_name )
 : test_unit( module_name )
+, m_all_samples( false )
 {
     framework::register_test_unit( this );
 }
@@ -239,7 +261,7 @@ test_suite::test_suite( const_string module_name )
 //____________________________________________________________________________//
 
 void
-test_suite::add( test_unit* tu, counter_t expected_failures, unsigned timeout )
+test_suite::add( test_unit* tu, counter_t expected_failures, double timeout )
 {
     tu->p_timeout.value = timeout;
 
@@ -256,7 +278,7 @@ test_suite::add( test_unit* tu, counter_t expected_failures, unsigned timeout )
 //____________________________________________________________________________//
 
 void
-test_suite::add( test_unit_generator const& gen, unsigned timeout )
+test_suite::add( test_unit_generator const& gen, double timeout )
 {
     test_unit* tu;
     while((tu = gen.next()) != 0)
@@ -268,6 +290,18 @@ test_suite::add( test_unit_generator const& gen, unsigned timeout )
 void
 test_suite::add( test_unit_generator const& gen, decorator::collector& decorators )
 {
+    // the test cases of a lazy data test case are generated while it is executed
+    shared_ptr<test_case_source> source = gen.source();
+    if( source && !m_source ) {
+        BOOST_TEST_FOREACH( decorator::base_ptr, d, p_decorators.get() ) {
+            if( dynamic_cast<decorator::lazy_samples*>( d.get() ) ) {
+                m_source = source;
+                decorators.reset();
+                return;
+            }
+        }
+    }
+
     test_unit* tu;
     while((tu = gen.next()) != 0) {
         decorators.store_in( *tu );
@@ -290,6 +324,17 @@ test_suite::remove( test_unit_id id )
 
 //____________________________________________________________________________//
 
+counter_t
+test_suite::lazy_size() const
+{
+    if( !m_source )
+        return 0;
+
+    return m_all_samples ? m_source->size() : static_cast<counter_t>( m_selected_samples.size() );
+}
+
+//____________________________________________________________________________//
+
 test_unit_id
 test_suite::get( const_string tu_name ) const
 {
@@ -21,19 +21,45 @@
 #include <boost/test/execution_monitor.hpp>
 #include <boost/test/framework.hpp>
 #include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/alloc_monitor.hpp>
+
+#include <boost/test/tree/event_recorder.hpp>
+#include <boost/test/tree/test_unit.hpp>
 
 #include <boost/test/utils/basic_cstring/compare.hpp>
 #include <boost/test/utils/foreach.hpp>
+#include <boost/test/utils/lazy_ostream.hpp>
+#include <boost/test/utils/wrap_stringstream.hpp>
 
 #include <boost/test/output/compiler_log_formatter.hpp>
 #include <boost/test/output/xml_log_formatter.hpp>
 #include <boost/test/output/junit_log_formatter.hpp>
+#include <boost/test/output/binary_log_formatter.hpp>
 
 // Boost
 #include <boost/shared_ptr.hpp>
 #include <boost/io/ios_state.hpp>
+#include <boost/core/ignore_unused.hpp>
 typedef ::boost::io::ios_base_all_saver io_saver_type;
 
+// STL
+#include <string>
+#include <sstream>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#ifdef BOOST_HAS_SIGACTION
+#include <unistd.h>
+#include <time.h>
+#endif
+#endif
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -119,6 +145,162 @@ struct unit_test_log_data_helper_impl {
   }
 };
 
+#ifdef BOOST_TEST_SUPPORT_THREADS
+
+// ************************************************************************** //
+// **************                async_log_writer              ************** //
+// ************************************************************************** //
+
+// log event captured by the thread driving the test tree
+struct log_record {
+    enum record_type {
+        LR_TEST_START,      // num is the amount of test cases
+        LR_TEST_FINISH,
+        LR_UNIT_START,      // test unit
+        LR_UNIT_FINISH,     // test unit, num is the elapsed time
+        LR_UNIT_SKIPPED,    // test unit, text is the reason
+        LR_UNIT_ABORTED,    // test unit
+        LR_BENCHMARK,       // test case and benchmark data
+        LR_PERF_COUNTERS,   // test case and performance counters
+        LR_ALLOCATIONS,     // test case and heap allocations
+        LR_EXCEPTION,       // code, text, file, line, function, context and call stack
+        LR_CHECKPOINT,      // file, line and text
+        LR_ENTRY_BEGIN,     // file and line
+        LR_ENTRY_LEVEL,     // code
+        LR_ENTRY_VALUE,     // text
+        LR_ENTRY_END        // context
+    };
+
+    log_record()
+    : m_type( LR_TEST_FINISH )
+    , m_tc_id( INV_TEST_UNIT_ID )
+    , m_tu( 0 )
+    , m_code( 0 )
+    , m_num( 0 )
+    , m_context_size( 0 )
+    {}
+
+    void                record_context()
+    {
+        framework::context_generator const& context = framework::get_context();
+
+        const_string frame;
+        for( m_context_size = 0; !(frame = context.next()).is_empty(); ++m_context_size ) {
+            if( m_context_size == m_context.size() )
+                m_context.push_back( std::string() );
+
+            m_context[m_context_size].assign( frame.begin(), frame.end() );
+        }
+    }
+
+    void                replay_context() const
+    {
+        for( std::size_t i = 0; i < m_context_size; ++i )
+            framework::add_context( BOOST_TEST_LAZY_MSG( m_context[i] ), false );
+    }
+
+    record_type                 m_type;
+    test_unit_id                m_tc_id;        // current test case of the thread driving the test tree
+    test_unit const*            m_tu;
+    int                         m_code;         // log level or error code
+    std::size_t                 m_num;          // line number, amount of test cases or elapsed time
+    std::string                 m_file;
+    std::string                 m_function;
+    std::string                 m_text;
+    std::vector<std::string>    m_context;      // frames are reused along with the record
+    std::size_t                 m_context_size;
+    benchmark_data              m_benchmark;
+    perf_counters               m_perf_counters;
+    alloc_stats                 m_alloc_stats;
+    stack_trace                 m_backtrace;
+};
+
+//____________________________________________________________________________//
+
+// Writes out the log events from a dedicated thread. The events are captured as records in a ring buffer by the
+// thread driving the test tree, and the writer thread replays them through the loggers. The ring buffer has a
+// single producer and a single consumer, which synchronize on the positions of the records only; the records
+// are reused, so that their buffers do not need to be allocated for each event. A thread waiting for the records
+// to be written out spins for a while, and then blocks until the writer thread notifies it.
+class async_log_writer {
+public:
+    async_log_writer()
+    : m_records( 1024 )
+    , m_head( 0 )
+    , m_tail( 0 )
+    , m_stop( false )
+    , m_waiting( false )
+    , m_producer_waiting( false )
+    , m_flush_requested( false )
+    , m_flushed( false )
+    , m_test_runs( 0 )
+    , m_entry_line( 0 )
+    , m_entry_captured( false )
+    {}
+    ~async_log_writer() { m_test_runs = 0; terminate(); }
+
+    /// Starts the writer thread, unless it is already started by an enclosing test run
+    void                start();
+    /// Writes out all the captured events and terminates the writer thread at the end of the outermost test run
+    void                stop();
+    /// Waits until the events captured so far are written out
+    void                drain();
+    /// Waits a bounded time for the writer thread to write out and flush the captured events; async-signal-safe
+    void                flush_from_signal();
+    bool                running() const { return m_thread.joinable(); }
+
+    // capture of the events
+    void                capture( log_record::record_type t, test_unit const* tu = 0, std::size_t num = 0,
+                                 const_string text = const_string() );
+    void                exception_caught( execution_exception const& ex );
+    void                benchmark_result( test_case const& tc, benchmark_data const& bd );
+    void                perf_counters_measured( test_case const& tc, perf_counters const& pcs );
+    void                allocations_measured( test_case const& tc, alloc_stats const& as );
+    void                set_checkpoint( const_string file_name, std::size_t line_num, const_string msg );
+    void                log_begin( const_string file_name, std::size_t line_num );
+    void                log_level( unit_test::log_level l );
+    void                log_value( const_string value );
+    void                log_value( lazy_ostream const& value );
+    void                log_end();
+
+    static bool&        in_writer_thread() { static BOOST_TEST_THREAD_LOCAL bool the_inst = false; return the_inst; }
+
+private:
+    log_record&         prepare( log_record::record_type t );
+    void                commit();
+    void                wake();
+    void                wait_written( std::size_t position );
+
+    void                terminate();
+    void                run();
+    void                replay( log_record const& r );
+
+    // Data members
+    std::vector<log_record>     m_records;
+    std::atomic<std::size_t>    m_head;         // position of the next record to capture
+    std::atomic<std::size_t>    m_tail;         // position of the next record to write out
+    std::atomic<bool>           m_stop;
+    std::atomic<bool>           m_waiting;      // the writer thread waits for the records
+    std::atomic<bool>           m_producer_waiting; // a thread waits for the records to be written out
+    std::atomic<bool>           m_flush_requested;  // the process is terminated by a signal
+    std::atomic<bool>           m_flushed;
+    std::mutex                  m_mutex;
+    std::condition_variable     m_wakeup;
+    std::condition_variable     m_written;
+    std::thread                 m_thread;
+    std::string                 m_checkpoint_file;
+    std::size_t                 m_test_runs;
+
+    // log entry being captured
+    std::string                 m_entry_file;
+    std::size_t                 m_entry_line;
+    bool                        m_entry_captured;
+};
+
+#endif
+
+//____________________________________________________________________________//
+
 struct unit_test_log_impl {
     // Constructor
     unit_test_log_impl()
@@ -126,11 +308,29 @@ struct unit_test_log_impl {
       m_log_formatter_data.push_back( unit_test_log_data_helper_impl(new output::compiler_log_formatter, OF_CLF, true) ); // only this one is active by default,
       m_log_formatter_data.push_back( unit_test_log_data_helper_impl(new output::xml_log_formatter, OF_XML, false) );
       m_log_formatter_data.push_back( unit_test_log_data_helper_impl(new output::junit_log_formatter, OF_JUNIT, false) );
+      m_log_formatter_data.push_back( unit_test_log_data_helper_impl(new output::binary_log_formatter, OF_BINARY, false) );
+      update_min_threshold_level();
+
+      // the checkpoints set by the test cases do not allocate memory, unless their message is longer
+      m_checkpoint_data.m_message.reserve( 256 );
     }
 
     typedef std::vector<unit_test_log_data_helper_impl> v_formatter_data_t;
     v_formatter_data_t m_log_formatter_data;
 
+    // lowest threshold level among the enabled loggers, checked by the testing tools for each assertion
+    log_level           m_min_threshold_level;
+
+    void                update_min_threshold_level()
+    {
+        m_min_threshold_level = log_nothing;
+
+        BOOST_TEST_FOREACH( unit_test_log_data_helper_impl const&, current_logger_data, m_log_formatter_data ) {
+            if( current_logger_data.m_enabled && current_logger_data.get_log_level() < m_min_threshold_level )
+                m_min_threshold_level = current_logger_data.get_log_level();
+        }
+    }
+
     // entry data
     log_entry_data      m_entry_data;
 
@@ -151,10 +351,495 @@ struct unit_test_log_impl {
         m_checkpoint_data.m_file_name   = file;
         m_checkpoint_data.m_line_num    = line_num;
     }
+
+    void                flush_streams()
+    {
+        BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, m_log_formatter_data ) {
+            if( current_logger_data.m_enabled )
+                current_logger_data.stream().flush();
+        }
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    // writer thread is terminated before the loggers are destroyed
+    async_log_writer    m_async_writer;
+#endif
 };
 
 unit_test_log_impl& s_log_impl() { static unit_test_log_impl the_inst; return the_inst; }
 
+//____________________________________________________________________________//
+
+#ifndef BOOST_TEST_SUPPORT_THREADS
+
+// events are written out by the thread producing them
+void drain_async_writer() {}
+
+#else
+
+// writer capturing the events produced by the calling thread, if any
+async_log_writer*
+active_async_writer()
+{
+    async_log_writer& writer = s_log_impl().m_async_writer;
+
+    return writer.running() && !async_log_writer::in_writer_thread() ? &writer : 0;
+}
+
+//____________________________________________________________________________//
+
+// loggers can only be reconfigured once the events captured so far are written out
+void
+drain_async_writer()
+{
+    if( async_log_writer* writer = active_async_writer() )
+        writer->drain();
+}
+
+//____________________________________________________________________________//
+
+// writes out the log before the test module is terminated by a signal; called by the signal handler
+void
+terminate_async_writer()
+{
+    // the events of a thread recording them are lost with the process anyway
+    if( !active_async_writer() || framework::impl::event_recorder::active() )
+        return;
+
+    s_log_impl().m_async_writer.flush_from_signal();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::start()
+{
+    if( m_test_runs++ > 0 )
+        return;
+
+    // the buffers of the records are allocated before the test cases, which may count their allocations
+    BOOST_TEST_FOREACH( log_record&, r, m_records ) {
+        r.m_file.reserve( 128 );
+        r.m_text.reserve( 128 );
+    }
+
+    m_stop              = false;
+    m_flush_requested   = false;
+    m_flushed           = false;
+    m_thread = std::thread( &async_log_writer::run, this );
+
+    execution_monitor::set_termination_hook( &terminate_async_writer );
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::stop()
+{
+    if( m_test_runs == 0 || --m_test_runs > 0 )
+        return;
+
+    terminate();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::terminate()
+{
+    if( !running() )
+        return;
+
+    execution_monitor::set_termination_hook( 0 );
+
+    m_stop = true;
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_wakeup.notify_one();
+    }
+
+    m_thread.join();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::drain()
+{
+    wait_written( m_head.load() );
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::flush_from_signal()
+{
+#ifdef BOOST_HAS_SIGACTION
+    // neither the loggers nor the condition variables can be used by a signal handler: the writer thread formats
+    // and flushes the events, and notices the request on its own, while this thread polls for it
+    m_flush_requested = true;
+
+    for( int i = 0; i < 2000 && !m_flushed.load(); ++i ) {
+        struct timespec const delay = { 0, 1000000 };
+        ::nanosleep( &delay, 0 );
+    }
+
+    if( m_flushed.load() )
+        return;
+
+    static char const incomplete[] = "the test log could not be written out before the termination\n";
+    ssize_t written = ::write( STDERR_FILENO, incomplete, sizeof(incomplete) - 1 );
+    ignore_unused( written );
+#endif
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::wait_written( std::size_t position )
+{
+    // the writer thread is expected to catch up shortly: yielding avoids the cost of blocking
+    for( unsigned spins = 0; m_tail.load() < position; ++spins ) {
+        wake();
+
+        if( spins < 64 ) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_producer_waiting = true;
+
+        if( m_tail.load() < position )
+            m_written.wait( lock );
+
+        m_producer_waiting = false;
+    }
+}
+
+//____________________________________________________________________________//
+
+log_record&
+async_log_writer::prepare( log_record::record_type t )
+{
+    std::size_t const head = m_head.load( std::memory_order_relaxed );
+
+    // the buffer is full: wait for the writer thread to catch up
+    if( head - m_tail.load( std::memory_order_acquire ) == m_records.size() )
+        wait_written( head + 1 - m_records.size() );
+
+    log_record& r = m_records[head % m_records.size()];
+    r.m_type            = t;
+    r.m_tc_id           = framework::current_test_case_id();
+    r.m_tu              = 0;
+    r.m_code            = 0;
+    r.m_num             = 0;
+    r.m_context_size    = 0;
+
+    return r;
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::commit()
+{
+    m_head.fetch_add( 1 );
+
+    wake();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::wake()
+{
+    if( !m_waiting.load() )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_wakeup.notify_one();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::capture( log_record::record_type t, test_unit const* tu, std::size_t num, const_string text )
+{
+    log_record& r = prepare( t );
+    r.m_tu  = tu;
+    r.m_num = num;
+    r.m_text.assign( text.begin(), text.end() );
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::exception_caught( execution_exception const& ex )
+{
+    log_record& r = prepare( log_record::LR_EXCEPTION );
+    r.m_code = ex.code();
+    r.m_text.assign( ex.what().begin(), ex.what().end() );
+    r.m_file.assign( ex.where().m_file_name.begin(), ex.where().m_file_name.end() );
+    r.m_num  = ex.where().m_line_num;
+    r.m_function.assign( ex.where().m_function.begin(), ex.where().m_function.end() );
+    r.m_backtrace = ex.backtrace();
+    r.record_context();
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::benchmark_result( test_case const& tc, benchmark_data const& bd )
+{
+    log_record& r = prepare( log_record::LR_BENCHMARK );
+    r.m_tu          = &tc;
+    r.m_benchmark   = bd;
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::perf_counters_measured( test_case const& tc, perf_counters const& pcs )
+{
+    log_record& r = prepare( log_record::LR_PERF_COUNTERS );
+    r.m_tu              = &tc;
+    r.m_perf_counters   = pcs;
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::allocations_measured( test_case const& tc, alloc_stats const& as )
+{
+    log_record& r = prepare( log_record::LR_ALLOCATIONS );
+    r.m_tu          = &tc;
+    r.m_alloc_stats = as;
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::set_checkpoint( const_string file_name, std::size_t line_num, const_string msg )
+{
+    log_record& r = prepare( log_record::LR_CHECKPOINT );
+    r.m_file.assign( file_name.begin(), file_name.end() );
+    r.m_num = line_num;
+    r.m_text.assign( msg.begin(), msg.end() );
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::log_begin( const_string file_name, std::size_t line_num )
+{
+    if( m_entry_captured ) {
+        log_end();
+        framework::clear_context();
+    }
+
+    // the entry is captured once its level is known
+    m_entry_file.assign( file_name.begin(), file_name.end() );
+    m_entry_line = line_num;
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::log_level( unit_test::log_level l )
+{
+    // the entry is not going to be reported by any logger
+    if( l < unit_test_log.get_min_threshold_level() )
+        return;
+
+    if( !m_entry_captured ) {
+        log_record& r = prepare( log_record::LR_ENTRY_BEGIN );
+        r.m_file = m_entry_file;
+        r.m_num  = m_entry_line;
+
+        commit();
+
+        m_entry_captured = true;
+    }
+
+    prepare( log_record::LR_ENTRY_LEVEL ).m_code = l;
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::log_value( const_string value )
+{
+    if( !m_entry_captured || value.is_empty() )
+        return;
+
+    prepare( log_record::LR_ENTRY_VALUE ).m_text.assign( value.begin(), value.end() );
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::log_value( lazy_ostream const& value )
+{
+    if( !m_entry_captured || value.empty() )
+        return;
+
+    // the value refers to the objects of the calling thread
+    prepare( log_record::LR_ENTRY_VALUE ).m_text = (wrap_stringstream().ref() << value).str();
+
+    commit();
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::log_end()
+{
+    if( !m_entry_captured )
+        return;
+
+    prepare( log_record::LR_ENTRY_END ).record_context();
+
+    commit();
+
+    m_entry_captured = false;
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::run()
+{
+    in_writer_thread() = true;
+    framework::impl::attach_thread_state();
+
+    for( ;; ) {
+        std::size_t const tail = m_tail.load( std::memory_order_relaxed );
+
+        if( tail != m_head.load( std::memory_order_acquire ) ) {
+            BOOST_TEST_I_TRY {
+                replay( m_records[tail % m_records.size()] );
+            }
+            BOOST_TEST_I_CATCHALL() {
+                // the failure of a logger does not stop the others
+            }
+
+            m_tail.store( tail + 1 );
+
+            if( m_producer_waiting.load() ) {
+                std::lock_guard<std::mutex> lock( m_mutex );
+                m_written.notify_one();
+            }
+            continue;
+        }
+
+        if( m_flush_requested.load() && !m_flushed.load() ) {
+            s_log_impl().flush_streams();
+            m_flushed = true;
+        }
+
+        if( m_stop.load() )
+            break;
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_waiting = true;
+
+        // a signal handler requesting the flush can't notify the condition variable
+        if( tail == m_head.load() && !m_stop.load() )
+            m_wakeup.wait_for( lock, std::chrono::milliseconds( 20 ) );
+
+        m_waiting = false;
+    }
+
+    framework::impl::detach_thread_state();
+    in_writer_thread() = false;
+}
+
+//____________________________________________________________________________//
+
+void
+async_log_writer::replay( log_record const& r )
+{
+    framework::impl::set_thread_test_case( r.m_tc_id );
+
+    switch( r.m_type ) {
+    case log_record::LR_TEST_START:
+        unit_test_log.test_start( r.m_num );
+        break;
+    case log_record::LR_TEST_FINISH:
+        unit_test_log.test_finish();
+        break;
+    case log_record::LR_UNIT_START:
+        unit_test_log.test_unit_start( *r.m_tu );
+        break;
+    case log_record::LR_UNIT_FINISH:
+        unit_test_log.test_unit_finish( *r.m_tu, static_cast<unsigned long>( r.m_num ) );
+        break;
+    case log_record::LR_UNIT_SKIPPED:
+        unit_test_log.test_unit_skipped( *r.m_tu, r.m_text );
+        break;
+    case log_record::LR_UNIT_ABORTED:
+        unit_test_log.test_unit_aborted( *r.m_tu );
+        break;
+    case log_record::LR_BENCHMARK:
+        unit_test_log.benchmark_result( static_cast<test_case const&>( *r.m_tu ), r.m_benchmark );
+        break;
+    case log_record::LR_PERF_COUNTERS:
+        unit_test_log.perf_counters_measured( static_cast<test_case const&>( *r.m_tu ), r.m_perf_counters );
+        break;
+    case log_record::LR_ALLOCATIONS:
+        unit_test_log.allocations_measured( static_cast<test_case const&>( *r.m_tu ), r.m_alloc_stats );
+        break;
+    case log_record::LR_EXCEPTION:
+        r.replay_context();
+
+        unit_test_log.exception_caught( execution_exception(
+            static_cast<execution_exception::error_code>( r.m_code ),
+            r.m_text,
+            execution_exception::location( r.m_file.c_str(), r.m_num, r.m_function.empty() ? 0 : r.m_function.c_str() ),
+            r.m_backtrace ) );
+        break;
+    case log_record::LR_CHECKPOINT:
+        // the checkpoint refers to its file name until the next one, while the record is reused
+        m_checkpoint_file = r.m_file;
+
+        unit_test_log.set_checkpoint( m_checkpoint_file, r.m_num, r.m_text );
+        break;
+    case log_record::LR_ENTRY_BEGIN:
+        unit_test_log << log::begin( r.m_file, r.m_num );
+        break;
+    case log_record::LR_ENTRY_LEVEL:
+        unit_test_log << static_cast<unit_test::log_level>( r.m_code );
+        break;
+    case log_record::LR_ENTRY_VALUE:
+        unit_test_log << const_string( r.m_text );
+        break;
+    case log_record::LR_ENTRY_END:
+        r.replay_context();
+
+        unit_test_log << log::end();
+        break;
+    }
+}
+
+#endif
+
 } // local namespace
 
 //____________________________________________________________________________//
@@ -162,6 +847,20 @@ unit_test_log_impl& s_log_impl() { static unit_test_log_impl the_inst; return th
 void
 unit_test_log_t::test_start( counter_t test_cases_amount )
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    async_log_writer& async_writer = s_log_impl().m_async_writer;
+
+    // nested test runs are logged by the writer of the enclosing one
+    if( !async_log_writer::in_writer_thread() &&
+        (async_writer.running() || runtime_config::get<bool>( runtime_config::btrt_log_async )) )
+        async_writer.start();
+
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->capture( log_record::LR_TEST_START, 0, test_cases_amount );
+        return;
+    }
+#endif
+
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
       if( !current_logger_data.m_enabled || current_logger_data.get_log_level() == log_nothing )
           continue;
@@ -180,6 +879,14 @@ unit_test_log_t::test_start( counter_t test_cases_amount )
 void
 unit_test_log_t::test_finish()
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->capture( log_record::LR_TEST_FINISH );
+        writer->stop();
+        return;
+    }
+#endif
+
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
       if( !current_logger_data.m_enabled || current_logger_data.get_log_level() == log_nothing )
           continue;
@@ -203,6 +910,13 @@ unit_test_log_t::test_aborted()
 void
 unit_test_log_t::test_unit_start( test_unit const& tu )
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->capture( log_record::LR_UNIT_START, &tu );
+        return;
+    }
+#endif
+
     if( s_log_impl().has_entry_in_progress() )
         *this << log::end();
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
@@ -217,6 +931,13 @@ unit_test_log_t::test_unit_start( test_unit const& tu )
 void
 unit_test_log_t::test_unit_finish( test_unit const& tu, unsigned long elapsed )
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->capture( log_record::LR_UNIT_FINISH, &tu, elapsed );
+        return;
+    }
+#endif
+
     s_log_impl().m_checkpoint_data.clear();
 
     if( s_log_impl().has_entry_in_progress() )
@@ -236,6 +957,13 @@ unit_test_log_t::test_unit_finish( test_unit const& tu, unsigned long elapsed )
 void
 unit_test_log_t::test_unit_skipped( test_unit const& tu, const_string reason )
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->capture( log_record::LR_UNIT_SKIPPED, &tu, 0, reason );
+        return;
+    }
+#endif
+
     if( s_log_impl().has_entry_in_progress() )
         *this << log::end();
 
@@ -250,6 +978,13 @@ unit_test_log_t::test_unit_skipped( test_unit const& tu, const_string reason )
 void
 unit_test_log_t::test_unit_aborted( test_unit const& tu )
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->capture( log_record::LR_UNIT_ABORTED, &tu );
+        return;
+    }
+#endif
+
     if( s_log_impl().has_entry_in_progress() )
         *this << log::end();
 
@@ -263,9 +998,86 @@ unit_test_log_t::test_unit_aborted( test_unit const& tu )
 
 //____________________________________________________________________________//
 
+void
+unit_test_log_t::benchmark_result( test_case const& tc, benchmark_data const& bd )
+{
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->benchmark_result( tc, bd );
+        return;
+    }
+#endif
+
+    if( s_log_impl().has_entry_in_progress() )
+        *this << log::end();
+
+    BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
+        if( !current_logger_data.m_enabled || current_logger_data.get_log_level() > log_messages )
+            continue;
+
+        current_logger_data.m_log_formatter->log_benchmark( current_logger_data.stream(), tc, bd );
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::perf_counters_measured( test_case const& tc, perf_counters const& pcs )
+{
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->perf_counters_measured( tc, pcs );
+        return;
+    }
+#endif
+
+    if( s_log_impl().has_entry_in_progress() )
+        *this << log::end();
+
+    BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
+        if( !current_logger_data.m_enabled || current_logger_data.get_log_level() > log_messages )
+            continue;
+
+        current_logger_data.m_log_formatter->log_perf_counters( current_logger_data.stream(), tc, pcs );
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_t::allocations_measured( test_case const& tc, alloc_stats const& as )
+{
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->allocations_measured( tc, as );
+        return;
+    }
+#endif
+
+    if( s_log_impl().has_entry_in_progress() )
+        *this << log::end();
+
+    BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
+        if( !current_logger_data.m_enabled || current_logger_data.get_log_level() > log_messages )
+            continue;
+
+        current_logger_data.m_log_formatter->log_allocations( current_logger_data.stream(), tc, as );
+    }
+}
+
+//____________________________________________________________________________//
+
 void
 unit_test_log_t::exception_caught( execution_exception const& ex )
 {
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->exception_caught( ex );
+        clear_entry_context();
+        return;
+    }
+#endif
+
     log_level l =
         ex.code() <= execution_exception::cpp_exception_error   ? log_cpp_exception_errors :
         (ex.code() <= execution_exception::timeout_error        ? log_system_errors
@@ -293,6 +1105,18 @@ unit_test_log_t::exception_caught( execution_exception const& ex )
 void
 unit_test_log_t::set_checkpoint( const_string file, std::size_t line_num, const_string msg )
 {
+    if( framework::impl::event_recorder* recorder = framework::impl::event_recorder::active() ) {
+        recorder->set_checkpoint( file, line_num, msg );
+        return;
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->set_checkpoint( file, line_num, msg );
+        return;
+    }
+#endif
+
     s_log_impl().set_checkpoint( file, line_num, msg );
 }
 
@@ -307,6 +1131,18 @@ set_unix_slash( char in )
 unit_test_log_t&
 unit_test_log_t::operator<<( log::begin const& b )
 {
+    if( framework::impl::event_recorder* recorder = framework::impl::event_recorder::active() ) {
+        recorder->log_begin( b.m_file_name, b.m_line_num );
+        return *this;
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->log_begin( b.m_file_name, b.m_line_num );
+        return *this;
+    }
+#endif
+
     if( s_log_impl().has_entry_in_progress() )
         *this << log::end();
 
@@ -335,6 +1171,20 @@ unit_test_log_t::operator<<( log::begin const& b )
 unit_test_log_t&
 unit_test_log_t::operator<<( log::end const& )
 {
+    if( framework::impl::event_recorder* recorder = framework::impl::event_recorder::active() ) {
+        recorder->log_end();
+        clear_entry_context();
+        return *this;
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->log_end();
+        clear_entry_context();
+        return *this;
+    }
+#endif
+
     if( s_log_impl().has_entry_in_progress() ) {
         log_entry_context( s_log_impl().m_entry_data.m_level );
 
@@ -356,6 +1206,18 @@ unit_test_log_t::operator<<( log::end const& )
 unit_test_log_t&
 unit_test_log_t::operator<<( log_level l )
 {
+    if( framework::impl::event_recorder* recorder = framework::impl::event_recorder::active() ) {
+        recorder->log_level( l );
+        return *this;
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->log_level( l );
+        return *this;
+    }
+#endif
+
     s_log_impl().m_entry_data.m_level = l;
 
     return *this;
@@ -428,6 +1290,18 @@ unit_test_log_t::log_entry_start(output_format log_format)
 unit_test_log_t&
 unit_test_log_t::operator<<( const_string value )
 {
+    if( framework::impl::event_recorder* recorder = framework::impl::event_recorder::active() ) {
+        recorder->log_value( value );
+        return *this;
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->log_value( value );
+        return *this;
+    }
+#endif
+
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
         if( current_logger_data.m_enabled && s_log_impl().m_entry_data.m_level >= current_logger_data.get_log_level() && !value.empty() && log_entry_start(current_logger_data.m_format) )
             current_logger_data.m_log_formatter->log_entry_value( current_logger_data.stream(), value );
@@ -441,6 +1315,18 @@ unit_test_log_t::operator<<( const_string value )
 unit_test_log_t&
 unit_test_log_t::operator<<( lazy_ostream const& value )
 {
+    if( framework::impl::event_recorder* recorder = framework::impl::event_recorder::active() ) {
+        recorder->log_value( value );
+        return *this;
+    }
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    if( async_log_writer* writer = active_async_writer() ) {
+        writer->log_value( value );
+        return *this;
+    }
+#endif
+
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
         if( current_logger_data.m_enabled && s_log_impl().m_entry_data.m_level >= current_logger_data.get_log_level() && !value.empty() ) {
             if( log_entry_start(current_logger_data.m_format) ) {
@@ -494,9 +1380,19 @@ unit_test_log_t::clear_entry_context()
 
 //____________________________________________________________________________//
 
+void
+unit_test_log_t::drain()
+{
+    drain_async_writer();
+}
+
+//____________________________________________________________________________//
+
 void
 unit_test_log_t::set_stream( std::ostream& str )
 {
+    drain_async_writer();
+
     if( s_log_impl().has_entry_in_progress() )
         return;
 
@@ -511,6 +1407,8 @@ unit_test_log_t::set_stream( std::ostream& str )
 void
 unit_test_log_t::set_stream( output_format log_format, std::ostream& str )
 {
+    drain_async_writer();
+
     if( s_log_impl().has_entry_in_progress() )
         return;
 
@@ -528,12 +1426,16 @@ unit_test_log_t::set_stream( output_format log_format, std::ostream& str )
 void
 unit_test_log_t::set_threshold_level( log_level lev )
 {
+    drain_async_writer();
+
     if( s_log_impl().has_entry_in_progress() || lev == invalid_log_level )
         return;
 
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
         current_logger_data.m_log_formatter->set_log_level( lev );
     }
+
+    s_log_impl().update_min_threshold_level();
 }
 
 //____________________________________________________________________________//
@@ -541,6 +1443,8 @@ unit_test_log_t::set_threshold_level( log_level lev )
 void
 unit_test_log_t::set_threshold_level( output_format log_format, log_level lev )
 {
+    drain_async_writer();
+
     if( s_log_impl().has_entry_in_progress() || lev == invalid_log_level )
         return;
 
@@ -550,6 +1454,16 @@ unit_test_log_t::set_threshold_level( output_format log_format, log_level lev )
             break;
         }
     }
+
+    s_log_impl().update_min_threshold_level();
+}
+
+//____________________________________________________________________________//
+
+log_level
+unit_test_log_t::get_min_threshold_level() const
+{
+    return s_log_impl().m_min_threshold_level;
 }
 
 //____________________________________________________________________________//
@@ -557,12 +1471,16 @@ unit_test_log_t::set_threshold_level( output_format log_format, log_level lev )
 void
 unit_test_log_t::set_format( output_format log_format )
 {
+    drain_async_writer();
+
     if( s_log_impl().has_entry_in_progress() )
         return;
 
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
         current_logger_data.m_enabled = current_logger_data.m_format == log_format;
     }
+
+    s_log_impl().update_min_threshold_level();
 }
 
 //____________________________________________________________________________//
@@ -570,6 +1488,8 @@ unit_test_log_t::set_format( output_format log_format )
 void
 unit_test_log_t::add_format( output_format log_format )
 {
+    drain_async_writer();
+
     if( s_log_impl().has_entry_in_progress() )
         return;
 
@@ -579,12 +1499,16 @@ unit_test_log_t::add_format( output_format log_format )
             break;
         }
     }
+
+    s_log_impl().update_min_threshold_level();
 }
 
 //____________________________________________________________________________//
 
 unit_test_log_formatter*
 unit_test_log_t::get_formatter( output_format log_format ) {
+    drain_async_writer();
+
     BOOST_TEST_FOREACH( unit_test_log_data_helper_impl&, current_logger_data, s_log_impl().m_log_formatter_data ) {
         if( current_logger_data.m_format == log_format) {
             return current_logger_data.m_log_formatter.get();
@@ -597,6 +1521,8 @@ unit_test_log_t::get_formatter( output_format log_format ) {
 void
 unit_test_log_t::add_formatter( unit_test_log_formatter* the_formatter )
 {
+    drain_async_writer();
+
     // remove only user defined logger
     for(unit_test_log_impl::v_formatter_data_t::iterator it(s_log_impl().m_log_formatter_data.begin()),
             ite(s_log_impl().m_log_formatter_data.end());
@@ -612,11 +1538,15 @@ unit_test_log_t::add_formatter( unit_test_log_formatter* the_formatter )
     if( the_formatter ) {
         s_log_impl().m_log_formatter_data.push_back( unit_test_log_data_helper_impl(the_formatter, OF_CUSTOM_LOGGER, true) );
     }
+
+    s_log_impl().update_min_threshold_level();
 }
 
 void
 unit_test_log_t::set_formatter( unit_test_log_formatter* the_formatter )
 {
+    drain_async_writer();
+
     // remove only user defined logger
     log_level current_level = invalid_log_level;
     std::ostream *current_stream = 0;
@@ -655,6 +1585,88 @@ unit_test_log_formatter::log_entry_value( std::ostream& ostr, lazy_ostream const
     log_entry_value( ostr, (wrap_stringstream().ref() << value).str() );
 }
 
+//____________________________________________________________________________//
+
+namespace ut_detail {
+
+void
+print_duration( std::ostream& ostr, double ns )
+{
+    if( ns < 1e3 )
+        ostr << ns << "ns";
+    else if( ns < 1e6 )
+        ostr << ns / 1e3 << "us";
+    else if( ns < 1e9 )
+        ostr << ns / 1e6 << "ms";
+    else
+        ostr << ns / 1e9 << "s";
+}
+
+} // namespace ut_detail
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_formatter::log_benchmark( std::ostream& ostr, test_case const& tc, benchmark_data const& bd )
+{
+    log_entry_data entry_data;
+    entry_data.m_file_name.assign( tc.p_file_name.begin(), tc.p_file_name.end() );
+    entry_data.m_line_num = tc.p_line_num;
+    entry_data.m_level    = log_messages;
+
+    std::ostringstream text;
+    text.precision( 3 );
+    text << "benchmark \"" << tc.full_name() << "\": " << bd.m_iterations << " iterations in " << bd.m_samples << " samples, mean ";
+    ut_detail::print_duration( text, bd.m_mean );
+    text << ", median ";
+    ut_detail::print_duration( text, bd.m_median );
+    text << ", p99 ";
+    ut_detail::print_duration( text, bd.m_p99 );
+    text << ", " << bd.m_rate << " iterations/s";
+
+    log_entry_start( ostr, entry_data, BOOST_UTL_ET_INFO );
+    log_entry_value( ostr, text.str() );
+    log_entry_finish( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_formatter::log_perf_counters( std::ostream& ostr, test_case const& tc, perf_counters const& pcs )
+{
+    log_entry_data entry_data;
+    entry_data.m_file_name.assign( tc.p_file_name.begin(), tc.p_file_name.end() );
+    entry_data.m_line_num = tc.p_line_num;
+    entry_data.m_level    = log_messages;
+
+    std::ostringstream text;
+    text << "performance counters of \"" << tc.full_name() << "\": " << pcs;
+
+    log_entry_start( ostr, entry_data, BOOST_UTL_ET_INFO );
+    log_entry_value( ostr, text.str() );
+    log_entry_finish( ostr );
+}
+
+//____________________________________________________________________________//
+
+void
+unit_test_log_formatter::log_allocations( std::ostream& ostr, test_case const& tc, alloc_stats const& as )
+{
+    log_entry_data entry_data;
+    entry_data.m_file_name.assign( tc.p_file_name.begin(), tc.p_file_name.end() );
+    entry_data.m_line_num = tc.p_line_num;
+    entry_data.m_level    = log_messages;
+
+    std::ostringstream text;
+    text << "allocations of \"" << tc.full_name() << "\": " << as;
+
+    log_entry_start( ostr, entry_data, BOOST_UTL_ET_INFO );
+    log_entry_value( ostr, text.str() );
+    log_entry_finish( ostr );
+}
+
+//____________________________________________________________________________//
+
 void
 unit_test_log_formatter::set_log_level(log_level new_log_level)
 {
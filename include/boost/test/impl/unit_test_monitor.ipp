@@ -34,16 +34,26 @@ namespace unit_test {
 // ************************************************************************** //
 
 unit_test_monitor_t::error_level
-unit_test_monitor_t::execute_and_translate( boost::function<void ()> const& func, unsigned timeout )
+unit_test_monitor_t::execute_and_translate( boost::function<void ()> const& func, double timeout )
+{
+    return execute_and_translate( *this, func, timeout );
+}
+
+//____________________________________________________________________________//
+
+unit_test_monitor_t::error_level
+unit_test_monitor_t::execute_and_translate( execution_monitor& em, boost::function<void ()> const& func, double timeout )
 {
     BOOST_TEST_I_TRY {
-        p_catch_system_errors.value     = runtime_config::get<bool>( runtime_config::btrt_catch_sys_errors );
-        p_timeout.value                 = timeout;
-        p_auto_start_dbg.value          = runtime_config::get<bool>( runtime_config::btrt_auto_start_dbg );
-        p_use_alt_stack.value           = runtime_config::get<bool>( runtime_config::btrt_use_alt_stack );
-        p_detect_fp_exceptions.value    = runtime_config::get<bool>( runtime_config::btrt_detect_fp_except );
+        em.p_catch_system_errors.value  = runtime_config::get<bool>( runtime_config::btrt_catch_sys_errors );
+        em.p_timeout.value              = timeout;
+        em.p_timeout_action.value       = runtime_config::get<timeout_action>( runtime_config::btrt_timeout_action );
+        em.p_auto_start_dbg.value       = runtime_config::get<bool>( runtime_config::btrt_auto_start_dbg );
+        em.p_use_alt_stack.value        = runtime_config::get<bool>( runtime_config::btrt_use_alt_stack );
+        em.p_detect_fp_exceptions.value = runtime_config::get<bool>( runtime_config::btrt_detect_fp_except );
+        em.p_capture_backtrace.value    = runtime_config::get<bool>( runtime_config::btrt_backtrace );
 
-        vexecute( func );
+        em.vexecute( func );
     }
     BOOST_TEST_I_CATCH( execution_exception, ex ) {
         framework::exception_caught( ex );
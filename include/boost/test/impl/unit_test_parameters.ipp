@@ -28,6 +28,7 @@
 
 #include <boost/test/debug.hpp>
 #include <boost/test/framework.hpp>
+#include <boost/test/execution_monitor.hpp>
 
 #include <boost/test/detail/log_level.hpp>
 #include <boost/test/detail/throw_exception.hpp>
@@ -72,28 +73,45 @@ namespace runtime_config {
 
 // UTF parameters
 std::string btrt_auto_start_dbg    = "auto_start_dbg";
+std::string btrt_backtrace         = "backtrace";
+std::string btrt_benchmark_filter  = "benchmark_filter";
+std::string btrt_benchmark_min_time = "benchmark_min_time";
 std::string btrt_break_exec_path   = "break_exec_path";
 std::string btrt_build_info        = "build_info";
 std::string btrt_catch_sys_errors  = "catch_system_errors";
 std::string btrt_color_output      = "color_output";
 std::string btrt_detect_fp_except  = "detect_fp_exceptions";
 std::string btrt_detect_mem_leaks  = "detect_memory_leaks";
+std::string btrt_durations         = "durations";
+std::string btrt_isolation         = "isolation";
+std::string btrt_junit_streaming   = "junit_streaming";
 std::string btrt_list_content      = "list_content";
 std::string btrt_list_labels       = "list_labels";
+std::string btrt_log_async         = "log_async";
 std::string btrt_log_format        = "log_format";
 std::string btrt_log_level         = "log_level";
 std::string btrt_log_sink          = "log_sink";
 std::string btrt_combined_logger   = "logger";
+std::string btrt_memory_usage      = "memory_usage";
 std::string btrt_output_format     = "output_format";
+std::string btrt_parallel          = "parallel";
+std::string btrt_perf_counters     = "perf_counters";
 std::string btrt_random_seed       = "random";
+std::string btrt_regression_baseline = "regression_baseline";
 std::string btrt_report_format     = "report_format";
 std::string btrt_report_level      = "report_level";
 std::string btrt_report_mem_leaks  = "report_memory_leaks_to";
 std::string btrt_report_sink       = "report_sink";
+std::string btrt_rerun             = "rerun";
 std::string btrt_result_code       = "result_code";
 std::string btrt_run_filters       = "run_test";
 std::string btrt_save_test_pattern = "save_pattern";
+std::string btrt_schedule          = "schedule";
+std::string btrt_shard_count       = "shard_count";
+std::string btrt_shard_index       = "shard_index";
 std::string btrt_show_progress     = "show_progress";
+std::string btrt_timeout_action    = "timeout_action";
+std::string btrt_track_allocations = "track_allocations";
 std::string btrt_use_alt_stack     = "use_alt_stack";
 std::string btrt_wait_for_debugger = "wait_for_debugger";
 
@@ -126,6 +144,54 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::option backtrace( btrt_backtrace, (
+        rt::description = "Reports the call stack of the system errors and the uncaught exceptions.",
+        rt::env_var = "BOOST_TEST_BACKTRACE",
+        rt::help = "Option " + btrt_backtrace + " instructs the framework to capture the call stack where "
+                   "a signal is raised or where an uncaught C++ exception is thrown in a test unit, and "
+                   "to log it with the error. This is only available with the GNU C library, and the "
+                   "names of the functions are only resolved for the symbols exported by the test "
+                   "module (linked with -rdynamic)."
+    ));
+
+    backtrace.add_cla_id( "--", btrt_backtrace, "=" );
+    store.add( backtrace );
+
+    ///////////////////////////////////////////////
+
+    rt::parameter<std::string> benchmark_filter( btrt_benchmark_filter, (
+        rt::description = "Selects the benchmark test cases to measure.",
+        rt::env_var = "BOOST_TEST_BENCHMARK_FILTER",
+        rt::value_hint = "<pattern>[,<pattern>...]",
+        rt::help = "Parameter " + btrt_benchmark_filter + " selects the benchmark test cases which are "
+                   "measured, by patterns matching their full name, such as 'suite/bench_*'. The "
+                   "symbol '*' matches any sequence of characters. The other benchmark test cases "
+                   "are executed once, like regular test cases. By default all the benchmark test "
+                   "cases are measured."
+    ));
+
+    benchmark_filter.add_cla_id( "--", btrt_benchmark_filter, "=" );
+    store.add( benchmark_filter );
+
+    ///////////////////////////////////////////////
+
+    rt::parameter<double> benchmark_min_time( btrt_benchmark_min_time, (
+        rt::description = "Specifies the minimal time spent measuring each benchmark test case.",
+        rt::env_var = "BOOST_TEST_BENCHMARK_MIN_TIME",
+        rt::default_value = 0.5,
+        rt::value_hint = "<seconds>",
+        rt::help = "Parameter " + btrt_benchmark_min_time + " specifies the minimal time in seconds "
+                   "spent measuring the body of each benchmark test case. The amount of iterations "
+                   "of the body per sample is calibrated so that a sample lasts about one hundredth "
+                   "of this time, and samples are taken until this time is spent. The default value "
+                   "is 0.5 seconds."
+    ));
+
+    benchmark_min_time.add_cla_id( "--", btrt_benchmark_min_time, "=" );
+    store.add( benchmark_min_time );
+
+    ///////////////////////////////////////////////
+
     rt::parameter<std::string> break_exec_path( btrt_break_exec_path, (
         rt::description = "For the exception safety testing allows to break at specific execution path.",
         rt::env_var = "BOOST_TEST_BREAK_EXEC_PATH"
@@ -225,6 +291,69 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::parameter<std::string> durations( btrt_durations, (
+        rt::description = "Specifies the file with the durations of the test cases measured by previous runs.",
+        rt::env_var = "BOOST_TEST_DURATIONS",
+        rt::value_hint = "<file name>",
+        rt::help = "Parameter " + btrt_durations + " specifies the name of the file holding the durations "
+                   "of the test cases. When the test cases are sharded (see " + btrt_shard_count + "), "
+                   "these durations are used to assign the test cases to the shards so that all the "
+                   "shards take about the same time. All the shards should use the same file. They are "
+                   "also used to order the test cases (see " + btrt_schedule + "). At the end of the "
+                   "run, the durations measured for the executed test cases are saved in this file, "
+                   "along with the test cases which failed (see " + btrt_rerun + ")."
+    ));
+
+    durations.add_cla_id( "--", btrt_durations, "=" );
+    store.add( durations );
+
+    ///////////////////////////////////////////////
+
+    rt::enum_parameter<unit_test::isolation_mode> isolation( btrt_isolation, (
+        rt::description = "Specifies where the test cases are executed.",
+        rt::env_var = "BOOST_TEST_ISOLATION",
+        rt::default_value = ISOLATION_NONE,
+        rt::enum_values<unit_test::isolation_mode>::value =
+#if defined(BOOST_TEST_CLA_NEW_API)
+        {
+            { "none", ISOLATION_NONE },
+            { "fork", ISOLATION_FORK }
+        },
+#else
+        rt::enum_values_list<unit_test::isolation_mode>()
+            ( "none", ISOLATION_NONE )
+            ( "fork", ISOLATION_FORK )
+        ,
+#endif
+        rt::help = "Parameter " + btrt_isolation + " allows to execute each test case in a child "
+                   "process of the test module (value 'fork'), so that a crash of the test case does not "
+                   "affect the other test cases. The assertions and the log entries of the child process "
+                   "are reported by the test module as if the test case was executed in it. Combined "
+                   "with the parameter " + btrt_parallel + ", it specifies the number of child processes "
+                   "running at the same time. By default (value 'none') the test cases are executed in "
+                   "the process of the test module."
+    ));
+
+    isolation.add_cla_id( "--", btrt_isolation, "=" );
+    store.add( isolation );
+
+    ///////////////////////////////////////////////
+
+    rt::option junit_streaming( btrt_junit_streaming, (
+        rt::description = "Writes the JUNIT log while the test cases are executed.",
+        rt::env_var = "BOOST_TEST_JUNIT_STREAMING",
+        rt::help = "Option " + btrt_junit_streaming + " instructs the JUNIT log formatter to write out "
+                   "each test case as soon as it finishes, instead of keeping the log of the whole test "
+                   "run in memory until its end. The totals of the test suite are written into its "
+                   "opening tag once the test suite finishes if the log sink can be repositioned, and "
+                   "in a comment after it otherwise."
+    ));
+
+    junit_streaming.add_cla_id( "--", btrt_junit_streaming, "=" );
+    store.add( junit_streaming );
+
+    ///////////////////////////////////////////////
+
     rt::enum_parameter<unit_test::output_format> list_content( btrt_list_content, (
         rt::description = "Lists the content of test tree - names of all test suites and test cases.",
         rt::env_var = "BOOST_TEST_LIST_CONTENT",
@@ -265,6 +394,22 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::option log_async( btrt_log_async, (
+        rt::description = "Writes the log from a dedicated thread.",
+        rt::env_var = "BOOST_TEST_LOG_ASYNC",
+        rt::help = "Option " + btrt_log_async + " instructs the framework to capture the log events "
+                   "in a buffer and to leave the formatting and the output of the log to a dedicated "
+                   "thread, so that the test cases do not wait for the log output. The log is "
+                   "written out completely at the end of the test, and before the test module is "
+                   "terminated by a signal. This option has no effect if the framework is built "
+                   "without threading support."
+    ));
+
+    log_async.add_cla_id( "--", btrt_log_async, "=" );
+    store.add( log_async );
+
+    ///////////////////////////////////////////////
+
     rt::enum_parameter<unit_test::output_format> log_format( btrt_log_format, (
         rt::description = "Specifies log format.",
         rt::env_var = "BOOST_TEST_LOG_FORMAT",
@@ -276,6 +421,7 @@ register_parameters( rt::parameters_store& store )
             { "CLF", OF_CLF },
             { "XML", OF_XML },
             { "JUNIT", OF_JUNIT },
+            { "BINARY", OF_BINARY },
         },
 #else
         rt::enum_values_list<unit_test::output_format>()
@@ -283,6 +429,7 @@ register_parameters( rt::parameters_store& store )
             ( "CLF", OF_CLF )
             ( "XML", OF_XML )
             ( "JUNIT", OF_JUNIT )
+            ( "BINARY", OF_BINARY )
         ,
 #endif
         rt::help = "Parameter " + btrt_log_format + " allows to set the frameowrk's log format to one "
@@ -290,7 +437,9 @@ register_parameters( rt::parameters_store& store )
                    "parameter are the names of the output formats supplied by the framework. By "
                    "default the framework uses human readable format (HRF) for testing log. This "
                    "format is similar to compiler error format. Alternatively you can specify XML "
-                   "or JUNIT as log format, which are easier to process by testing automation tools."
+                   "or JUNIT as log format, which are easier to process by testing automation tools. "
+                   "For high volume runs, BINARY writes a compact binary log, which can be converted "
+                   "to the other formats afterwards."
     ));
 
     log_format.add_cla_id( "--", btrt_log_format, "=" );
@@ -363,6 +512,22 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::option memory_usage( btrt_memory_usage, (
+        rt::description = "Reports the resident memory of the test units.",
+        rt::env_var = "BOOST_TEST_MEMORY_USAGE",
+        rt::help = "Parameter " + btrt_memory_usage + " instructs the framework to sample the memory "
+                   "usage of the process at the start and at the finish of each test case: the peak of "
+                   "the resident memory while the test case is executed and the numbers of minor and major "
+                   "page faults it causes. They are reported in the detailed report. This is only available "
+                   "on Linux, and the memory usage is not sampled when the test cases are executed "
+                   "concurrently (see " + btrt_parallel + ") or in child processes (see " + btrt_isolation + ")."
+    ));
+
+    memory_usage.add_cla_id( "--", btrt_memory_usage, "=" );
+    store.add( memory_usage );
+
+    ///////////////////////////////////////////////
+
     rt::enum_parameter<unit_test::output_format> output_format( btrt_output_format, (
         rt::description = "Specifies output format (both log and report).",
         rt::env_var = "BOOST_TEST_OUTPUT_FORMAT",
@@ -408,6 +573,45 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::parameter<unsigned> parallel( btrt_parallel, (
+        rt::description = "Specifies the number of threads executing the test cases concurrently.",
+        rt::env_var = "BOOST_TEST_PARALLEL",
+        rt::default_value = 1U,
+        rt::optional_value = 0U,
+        rt::value_hint = "<number of threads>",
+        rt::help = "Parameter " + btrt_parallel + " instructs the framework to execute the test "
+                   "cases of the same test suite concurrently using the specified number of "
+                   "worker threads. By default (value 1) test cases are executed sequentially. "
+                   "If parameter is specified without the argument value or with value 0, the "
+                   "number of threads is the number of hardware threads available. When the test "
+                   "cases are executed in child processes (see " + btrt_isolation + "), it specifies "
+                   "the number of child processes running at the same time instead. Test units "
+                   "decorated as serial, their children, and test cases with timeout on the "
+                   "platforms without a timer per thread are always executed sequentially. The test log and results are reported in the same order "
+                   "as in sequential run."
+    ));
+
+    parallel.add_cla_id( "--", btrt_parallel, "=" );
+    store.add( parallel );
+
+    ///////////////////////////////////////////////
+
+    rt::option perf_counters( btrt_perf_counters, (
+        rt::description = "Measures the performance counters of the test cases.",
+        rt::env_var = "BOOST_TEST_PERF_COUNTERS",
+        rt::help = "Parameter " + btrt_perf_counters + " instructs the framework to measure the hardware "
+                   "performance counters (cycles, instructions, cache misses, branch misses) and the page "
+                   "faults of each test case, where the system allows it. The counters are reported in the "
+                   "log at the message level and in the detailed report. They are not measured when the "
+                   "test cases are executed concurrently (see " + btrt_parallel + ") or in child processes "
+                   "(see " + btrt_isolation + ")."
+    ));
+
+    perf_counters.add_cla_id( "--", btrt_perf_counters, "=" );
+    store.add( perf_counters );
+
+    ///////////////////////////////////////////////
+
     rt::parameter<unsigned> random_seed( btrt_random_seed, (
         rt::description = "Allows to switch between sequential and random order of test units execution."
                           " Optionally allows to specify concrete seed for random number generator.",
@@ -430,6 +634,22 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::parameter<std::string> regression_baseline( btrt_regression_baseline, (
+        rt::description = "Specifies the file with the performance baseline of the test cases.",
+        rt::env_var = "BOOST_TEST_REGRESSION_BASELINE",
+        rt::value_hint = "<file name>",
+        rt::help = "Parameter " + btrt_regression_baseline + " specifies the name of the file holding the "
+                   "durations the test cases decorated with max_regression are compared with. Such a test "
+                   "case fails if the median duration of its repeated executions exceeds its baseline by "
+                   "more than the ratio given to the decorator. If the parameter " + btrt_save_test_pattern +
+                   " is set, the measured durations are saved in this file instead."
+    ));
+
+    regression_baseline.add_cla_id( "--", btrt_regression_baseline, "=" );
+    store.add( regression_baseline );
+
+    ///////////////////////////////////////////////
+
     rt::enum_parameter<unit_test::output_format> report_format( btrt_report_format, (
         rt::description = "Specifies report format.",
         rt::env_var = "BOOST_TEST_REPORT_FORMAT",
@@ -525,6 +745,37 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::enum_parameter<unit_test::rerun_mode> rerun( btrt_rerun, (
+        rt::description = "Selects the test cases to execute according to the results of the previous runs.",
+        rt::env_var = "BOOST_TEST_RERUN",
+        rt::default_value = RERUN_ALL,
+        rt::enum_values<unit_test::rerun_mode>::value =
+#if defined(BOOST_TEST_CLA_NEW_API)
+        {
+            { "all", RERUN_ALL },
+            { "failed", RERUN_FAILED },
+            { "failed_first", RERUN_FAILED_FIRST }
+        },
+#else
+        rt::enum_values_list<unit_test::rerun_mode>()
+            ( "all", RERUN_ALL )
+            ( "failed", RERUN_FAILED )
+            ( "failed_first", RERUN_FAILED_FIRST )
+        ,
+#endif
+        rt::help = "Parameter " + btrt_rerun + " uses the results of the previous runs saved in the file "
+                   "of durations (see " + btrt_durations + ") to execute only the test cases which failed "
+                   "(value 'failed'), along with the test cases they depend on, or to execute the test "
+                   "units holding these test cases first (value 'failed_first'). A test case is considered "
+                   "failed until a run executes it successfully. If no test case failed, all the test cases "
+                   "are executed. By default (value 'all') the results of the previous runs are ignored."
+    ));
+
+    rerun.add_cla_id( "--", btrt_rerun, "=" );
+    store.add( rerun );
+
+    ///////////////////////////////////////////////
+
     rt::option result_code( btrt_result_code, (
         rt::description = "Disables test modules's result code generation.",
         rt::env_var = "BOOST_TEST_RESULT_CODE",
@@ -565,7 +816,8 @@ register_parameters( rt::parameters_store& store )
         rt::help = "Parameter " + btrt_save_test_pattern + " facilitates switching mode of operation for "
                    "testing output streams.\n\nThis parameter serves no particular purpose within the "
                    "framework itself. It can be used by test modules relying on output_test_stream to "
-                   "implement testing logic. Default mode is 'match' (false)."
+                   "implement testing logic. It also saves the performance baseline of the test cases "
+                   "(see " + btrt_regression_baseline + "). Default mode is 'match' (false)."
     ));
 
     save_test_pattern.add_cla_id( "--", btrt_save_test_pattern, "=" );
@@ -573,6 +825,68 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::enum_parameter<unit_test::schedule_order> schedule( btrt_schedule, (
+        rt::description = "Specifies the order of execution of the test units.",
+        rt::env_var = "BOOST_TEST_SCHEDULE",
+        rt::default_value = SCHEDULE_DECLARATION,
+        rt::enum_values<unit_test::schedule_order>::value =
+#if defined(BOOST_TEST_CLA_NEW_API)
+        {
+            { "declaration", SCHEDULE_DECLARATION },
+            { "longest_first", SCHEDULE_LONGEST_FIRST }
+        },
+#else
+        rt::enum_values_list<unit_test::schedule_order>()
+            ( "declaration", SCHEDULE_DECLARATION )
+            ( "longest_first", SCHEDULE_LONGEST_FIRST )
+        ,
+#endif
+        rt::help = "Parameter " + btrt_schedule + " allows to execute the longest test units first "
+                   "(value 'longest_first'), according to the durations measured by the previous runs "
+                   "(see " + btrt_durations + "). Only the test units with the same dependency rank "
+                   "within a test suite are reordered. Combined with the parameter " + btrt_parallel +
+                   ", this shortens the overall execution time. By default (value 'declaration') the "
+                   "test units are executed in the order of their declaration."
+    ));
+
+    schedule.add_cla_id( "--", btrt_schedule, "=" );
+    store.add( schedule );
+
+    ///////////////////////////////////////////////
+
+    rt::parameter<unsigned> shard_count( btrt_shard_count, (
+        rt::description = "Specifies the number of shards the test cases are partitioned into.",
+        rt::env_var = "BOOST_TEST_SHARD_COUNT",
+        rt::default_value = 1U,
+        rt::value_hint = "<number of shards>",
+        rt::help = "Parameter " + btrt_shard_count + " allows to split the execution of the test cases "
+                   "between several runs of the test module, for instance on different machines. The "
+                   "enabled test cases are partitioned into the specified number of shards and only "
+                   "the test cases of the shard specified by " + btrt_shard_index + " are executed. "
+                   "The partition depends only on the names of the test cases (or on their durations, "
+                   "see " + btrt_durations + "), and the test cases depending on each other belong to "
+                   "the same shard. By default (value 1) the test cases are not sharded."
+    ));
+
+    shard_count.add_cla_id( "--", btrt_shard_count, "=" );
+    store.add( shard_count );
+
+    ///////////////////////////////////////////////
+
+    rt::parameter<unsigned> shard_index( btrt_shard_index, (
+        rt::description = "Specifies the shard of the test cases to execute.",
+        rt::env_var = "BOOST_TEST_SHARD_INDEX",
+        rt::default_value = 0U,
+        rt::value_hint = "<shard index>",
+        rt::help = "Parameter " + btrt_shard_index + " specifies which shard of the test cases to "
+                   "execute, from 0 to the number of shards minus one (see " + btrt_shard_count + ")."
+    ));
+
+    shard_index.add_cla_id( "--", btrt_shard_index, "=" );
+    store.add( shard_index );
+
+    ///////////////////////////////////////////////
+
     rt::option show_progress( btrt_show_progress, (
         rt::description = "Turns on progress display.",
         rt::env_var = "BOOST_TEST_SHOW_PROGRESS",
@@ -586,6 +900,53 @@ register_parameters( rt::parameters_store& store )
 
     ///////////////////////////////////////////////
 
+    rt::enum_parameter<timeout_action> timeout_action_param( btrt_timeout_action, (
+        rt::description = "Specifies what happens when the timeout of a test case expires.",
+        rt::env_var = "BOOST_TEST_TIMEOUT_ACTION",
+        rt::default_value = TIMEOUT_REPORT,
+        rt::enum_values<timeout_action>::value =
+#if defined(BOOST_TEST_CLA_NEW_API)
+        {
+            { "report",    TIMEOUT_REPORT },
+            { "backtrace", TIMEOUT_BACKTRACE },
+            { "abort",     TIMEOUT_ABORT }
+        },
+#else
+        rt::enum_values_list<timeout_action>()
+            ( "report",    TIMEOUT_REPORT )
+            ( "backtrace", TIMEOUT_BACKTRACE )
+            ( "abort",     TIMEOUT_ABORT )
+        ,
+#endif
+        rt::help = "Parameter " + btrt_timeout_action + " specifies the action taken when a test case "
+                   "exceeds its timeout. By default (value 'report') the test case is interrupted and "
+                   "reported as failed. With the value 'backtrace' the stack of the test case is also "
+                   "written to the standard error stream, which shows where it was blocked. With the "
+                   "value 'abort' the stack is written and the test module is aborted, so that a core "
+                   "file can be dumped."
+    ));
+
+    timeout_action_param.add_cla_id( "--", btrt_timeout_action, "=" );
+    store.add( timeout_action_param );
+
+    ///////////////////////////////////////////////
+
+    rt::option track_allocations( btrt_track_allocations, (
+        rt::description = "Tracks the heap allocations of the test cases.",
+        rt::env_var = "BOOST_TEST_TRACK_ALLOCATIONS",
+        rt::help = "Parameter " + btrt_track_allocations + " instructs the framework to count the heap "
+                   "allocations made through the global operator new by each test case: the number of "
+                   "allocations, the bytes allocated, the peak of the bytes in use and the blocks left "
+                   "allocated. They are reported in the log at the message level and in the detailed report. "
+                   "The allocations are not tracked when the test cases are executed concurrently (see " +
+                   btrt_parallel + ") or in child processes (see " + btrt_isolation + ")."
+    ));
+
+    track_allocations.add_cla_id( "--", btrt_track_allocations, "=" );
+    store.add( track_allocations );
+
+    ///////////////////////////////////////////////
+
     rt::option use_alt_stack( btrt_use_alt_stack, (
         rt::description = "Turns on/off usage of an alternative stack for signal handling.",
         rt::env_var = "BOOST_TEST_USE_ALT_STACK",
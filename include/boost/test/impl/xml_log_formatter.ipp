@@ -19,6 +19,8 @@
 #include <boost/test/output/xml_log_formatter.hpp>
 #include <boost/test/execution_monitor.hpp>
 #include <boost/test/framework.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/alloc_monitor.hpp>
 #include <boost/test/tree/test_unit.hpp>
 #include <boost/test/utils/basic_cstring/io.hpp>
 #include <boost/test/utils/xml_printer.hpp>
@@ -102,6 +104,34 @@ xml_log_formatter::test_unit_finish( std::ostream& ostr, test_unit const& tu, un
 
 //____________________________________________________________________________//
 
+void
+xml_log_formatter::log_perf_counters( std::ostream& ostr, test_case const&, perf_counters const& pcs )
+{
+    ostr << "<PerfCounters";
+
+    for( int pc = 0; pc < PC_COUNT; ++pc ) {
+        if( pcs.is_measured( static_cast<perf_counter>( pc ) ) )
+            ostr << ' ' << perf_counters::name( static_cast<perf_counter>( pc ) ) << utils::attr_value() << pcs.m_values[pc];
+    }
+
+    ostr << "/>";
+}
+
+//____________________________________________________________________________//
+
+void
+xml_log_formatter::log_allocations( std::ostream& ostr, test_case const&, alloc_stats const& as )
+{
+    ostr << "<Allocations"
+         << " count"            << utils::attr_value() << as.m_allocations
+         << " bytes"            << utils::attr_value() << as.m_bytes
+         << " peak_bytes"       << utils::attr_value() << as.m_peak_bytes
+         << " leaked_blocks"    << utils::attr_value() << as.m_leaked_blocks
+         << "/>";
+}
+
+//____________________________________________________________________________//
+
 void
 xml_log_formatter::test_unit_skipped( std::ostream& ostr, test_unit const& tu, const_string reason )
 {
@@ -134,6 +164,15 @@ xml_log_formatter::log_exception_start( std::ostream& ostr, log_checkpoint_data
              << utils::cdata() << checkpoint_data.m_message
              << "</LastCheckpoint>";
     }
+
+    if( !ex.backtrace().empty() ) {
+        std::vector<std::string> const frames = ex.backtrace().symbolize();
+
+        ostr << "<Backtrace>";
+        for( std::size_t i = 0; i < frames.size(); ++i )
+            ostr << "<Frame>" << utils::cdata() << frames[i] << "</Frame>";
+        ostr << "</Backtrace>";
+    }
 }
 
 //____________________________________________________________________________//
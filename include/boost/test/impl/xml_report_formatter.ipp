@@ -17,6 +17,7 @@
 
 // Boost.Test
 #include <boost/test/results_collector.hpp>
+#include <boost/test/results_reporter.hpp>
 #include <boost/test/output/xml_report_formatter.hpp>
 
 #include <boost/test/tree/test_unit.hpp>
@@ -80,6 +81,32 @@ xml_report_formatter::test_unit_report_start( test_unit const& tu, std::ostream&
              << " test_cases_aborted"   << utils::attr_value() << tr.p_test_cases_aborted;
     }
 
+    // the measurements of the test units are only written to the detailed report
+    bool const detailed = results_reporter::get_level() == DETAILED_REPORT;
+
+    if( detailed && tr.p_duration_nanoseconds > 0 )
+        ostr << " wall_time_nanoseconds" << utils::attr_value() << tr.p_duration_nanoseconds
+             << " cpu_time_nanoseconds" << utils::attr_value() << tr.p_cpu_time_nanoseconds;
+
+    for( int pc = 0; detailed && pc < PC_COUNT; ++pc ) {
+        if( tr.p_perf_counters.get().is_measured( static_cast<perf_counter>( pc ) ) )
+            ostr << ' ' << perf_counters::name( static_cast<perf_counter>( pc ) ) << utils::attr_value() << tr.p_perf_counters.get().m_values[pc];
+    }
+
+    if( detailed && !tr.p_alloc_stats.get().empty() ) {
+        alloc_stats const& as = tr.p_alloc_stats;
+
+        ostr << " allocations"          << utils::attr_value() << as.m_allocations
+             << " allocated_bytes"      << utils::attr_value() << as.m_bytes
+             << " peak_bytes"           << utils::attr_value() << as.m_peak_bytes
+             << " leaked_blocks"        << utils::attr_value() << as.m_leaked_blocks;
+    }
+
+    if( detailed && tr.p_peak_resident_bytes > 0 )
+        ostr << " peak_resident_bytes"  << utils::attr_value() << tr.p_peak_resident_bytes
+             << " minor_page_faults"    << utils::attr_value() << tr.p_minor_page_faults
+             << " major_page_faults"    << utils::attr_value() << tr.p_major_page_faults;
+
     ostr << '>';
 }
 
@@ -0,0 +1,150 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : contains OF_BINARY Log formatter definition
+// ***************************************************************************
+
+#ifndef BOOST_TEST_BINARY_LOG_FORMATTER_HPP_110917GER
+#define BOOST_TEST_BINARY_LOG_FORMATTER_HPP_110917GER
+
+// Boost.Test
+#include <boost/test/detail/global_typedef.hpp>
+#include <boost/test/unit_test_log_formatter.hpp>
+
+// STL
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace output {
+
+// ************************************************************************** //
+// **************             binary_log_formatter             ************** //
+// ************************************************************************** //
+
+/// Writes the log as a compact stream of binary records
+///
+/// The stream starts with the 4 bytes "BTL" followed by the format version. Each record is made of its type
+/// on one byte, the size of its payload and the payload. The integers are written as unsigned LEB128 varints,
+/// and the strings as their size followed by their characters. The file names are interned: each one is
+/// defined once by a file record and referred to by its id afterwards, 0 standing for no file name.
+///
+/// The test units are defined by unit records before they are referred to, the whole subtree of a test suite
+/// being defined when it starts. The assertions counted for a test unit are part of its finish record, so that
+/// the results of the test tree can be rebuilt from the log regardless of the log level.
+///
+/// @see decode_binary_log
+class binary_log_formatter : public unit_test_log_formatter {
+public:
+    /// Record types
+    enum record_type {
+        BLR_LOG_START = 1,      ///< log level, amount of test cases
+        BLR_LOG_FINISH,
+        BLR_BUILD_INFO,
+        BLR_FILE,               ///< file id, file name
+        BLR_UNIT,               ///< id, parent id, type, name, file id, line, expected failures, enabled
+        BLR_UNIT_START,         ///< id
+        BLR_UNIT_FINISH,        ///< id, elapsed time, assertions passed, failed and warnings failed
+        BLR_UNIT_SKIPPED,       ///< id, reason
+        BLR_UNIT_ABORTED,       ///< id
+        BLR_EXCEPTION_START,    ///< test case id, code, what, file id, line, function,
+                                ///< checkpoint file id, line and message
+        BLR_EXCEPTION_FINISH,
+        BLR_ENTRY_START,        ///< test case id, entry type, log level, file id, line
+        BLR_ENTRY_VALUE,        ///< value
+        BLR_ENTRY_FINISH,
+        BLR_CONTEXT_START,      ///< log level
+        BLR_CONTEXT_FRAME,      ///< value
+        BLR_CONTEXT_FINISH
+    };
+
+    /// Test unit types of the unit records
+    enum unit_type { BLU_CASE, BLU_SUITE, BLU_MODULE };
+
+    binary_log_formatter();
+
+    // Formatter interface
+    void    log_start( std::ostream&, counter_t test_cases_amount );
+    void    log_finish( std::ostream& );
+    void    log_build_info( std::ostream& );
+
+    void    test_unit_start( std::ostream&, test_unit const& tu );
+    void    test_unit_finish( std::ostream&, test_unit const& tu, unsigned long elapsed );
+    void    test_unit_skipped( std::ostream&, test_unit const& tu, const_string reason );
+    void    test_unit_aborted( std::ostream&, test_unit const& tu );
+
+    void    log_exception_start( std::ostream&, log_checkpoint_data const&, execution_exception const& ex );
+    void    log_exception_finish( std::ostream& );
+
+    void    log_entry_start( std::ostream&, log_entry_data const&, log_entry_types let );
+    using   unit_test_log_formatter::log_entry_value; // bring base class functions into overload set
+    void    log_entry_value( std::ostream&, const_string value );
+    void    log_entry_finish( std::ostream& );
+
+    void    entry_context_start( std::ostream&, log_level );
+    void    log_entry_context( std::ostream&, const_string );
+    void    entry_context_finish( std::ostream& );
+
+    //! The test units are always logged, the log level applies to the log entries only
+    virtual void        set_log_level( log_level ll );
+
+    //! Returns a file name corresponding to the current master test suite
+    virtual std::string get_default_stream_description() const;
+
+private:
+    struct subtree_declarer;
+
+    void            declare( std::ostream&, test_unit const& tu );
+    void            declare_subtree( std::ostream&, test_unit const& tu );
+    test_unit_id    declare_current_test_case( std::ostream& );
+    unsigned long   file_id( std::ostream&, const_string file_name );
+
+    void            begin_record( record_type t );
+    void            write_record( std::ostream& );
+    void            put( unsigned long value );
+    void            put( const_string value );
+
+    // Data members
+    log_level                           m_entry_log_level;
+    record_type                         m_record_type;
+    bool                                m_entry_logged;     // the entry in progress is at the entry log level
+    bool                                m_exception_logged;
+    std::vector<bool>                   m_declared_suites;  // indexed like the test unit ids of each type
+    std::vector<bool>                   m_declared_cases;
+    std::map<std::string,unsigned long> m_file_ids;
+    std::string                         m_file_name;        // file name being looked up
+    std::string                         m_record;           // payload of the record being written
+};
+
+//____________________________________________________________________________//
+
+/// Writes the log recorded by the binary_log_formatter out through another formatter
+///
+/// The test tree of the recorded test run is rebuilt and its results are collected by the results collector,
+/// so that the formatter finds them as during the test run. The log entries are written out if their level
+/// is at least both the recorded log level and the log level of the formatter. Throws std::runtime_error
+/// on malformed input.
+BOOST_TEST_DECL void decode_binary_log( std::istream& input, unit_test_log_formatter& formatter, std::ostream& output );
+
+} // namespace output
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_BINARY_LOG_FORMATTER_HPP_110917GER
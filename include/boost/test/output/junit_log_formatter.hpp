@@ -20,7 +20,9 @@
 //#include <boost/test/results_collector.hpp>
 
 // STL
+#include <algorithm> // std::min
 #include <cstddef> // std::size_t
+#include <ios>
 #include <map>
 #include <list>
 
@@ -86,10 +88,17 @@ namespace output {
 // ************************************************************************** //
 
 /// JUnit logger class
+///
+/// By default the log of the whole test run is kept in memory and written out when the test run finishes.
+/// If the runtime parameter junit_streaming is set, each test case is written out as soon as it finishes
+/// and only the log of the test units being executed is kept in memory.
 class junit_log_formatter : public unit_test_log_formatter {
 public:
 
-    junit_log_formatter() : m_display_build_info(false)
+    junit_log_formatter()
+    : m_display_build_info(false)
+    , m_streaming(false)
+    , m_streamed_root(INV_TEST_UNIT_ID)
     {
         // we log everything from the logger singleton point of view
         // because we need to know about all the messages/commands going to the logger
@@ -121,6 +130,12 @@ public:
     void    log_entry_context( std::ostream&, const_string );
     void    entry_context_finish( std::ostream& );
 
+    //! Adds the performance counters to the standard output of the test case, whatever the log level
+    void    log_perf_counters( std::ostream&, test_case const& tc, perf_counters const& pcs );
+
+    //! Adds the heap allocations to the standard output of the test case, whatever the log level
+    void    log_allocations( std::ostream&, test_case const& tc, alloc_stats const& as );
+
     //! Discards changes in the log level
     virtual void        set_log_level(log_level ll)
     {
@@ -130,6 +145,10 @@ public:
             ll = log_all_errors;
 
         this->m_log_level_internal = ll;
+
+        // the passing assertions are only needed at the success level: they can be
+        // left out by the logger singleton otherwise
+        this->m_log_level = (std::min)( ll, log_test_units );
     }
 
     //! Instead of a regular stream, returns a file name corresponding to
@@ -150,10 +169,21 @@ private:
         return (it == map_tests.end() ? runner_log_entry : it->second);
     }
 
+    // streaming of the log
+    void stream_root_start( std::ostream& ostr, test_unit const& tu );
+    void stream_root_finish( std::ostream& ostr );
+    void stream_subtree( std::ostream& ostr, test_unit const& tu );
+    void stream_skipped( std::ostream& ostr );
+
     std::list<test_unit_id> list_path_to_root;
     bool m_display_build_info;
     bool m_is_last_assertion_or_error; // true if failure, false if error
 
+    bool m_streaming;
+    test_unit_id m_streamed_root;      // INV_TEST_UNIT_ID if no test unit is streamed
+    std::streampos m_totals_pos;       // position of the room left for the totals of the streamed test suite
+    std::list<test_unit_id> m_skipped; // skipped test units, streamed once their results are collected
+
     log_level m_log_level_internal;
     friend class junit_result_helper;
 };
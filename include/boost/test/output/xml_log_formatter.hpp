@@ -57,6 +57,9 @@ public:
     void    log_entry_context( std::ostream&, const_string );
     void    entry_context_finish( std::ostream& );
 
+    void    log_perf_counters( std::ostream&, test_case const& tc, perf_counters const& pcs );
+    void    log_allocations( std::ostream&, test_case const& tc, alloc_stats const& as );
+
 private:
     // Data members
     const_string    m_curr_tag;
@@ -0,0 +1,116 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief defines the observer measuring the hardware performance counters of the test cases
+// ***************************************************************************
+
+#ifndef BOOST_TEST_PERF_MONITOR_HPP_101826GER
+#define BOOST_TEST_PERF_MONITOR_HPP_101826GER
+
+// Boost.Test
+#include <boost/test/tree/observer.hpp>
+#include <boost/test/detail/global_typedef.hpp>
+#include <boost/test/utils/trivial_singleton.hpp>
+
+// STL
+#include <iosfwd>   // for std::ostream&
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+
+// ************************************************************************** //
+// **************                 perf_counters                ************** //
+// ************************************************************************** //
+
+/// Performance counters measured for each test case
+enum perf_counter {
+    PC_CYCLES,          ///< CPU cycles
+    PC_INSTRUCTIONS,    ///< retired instructions
+    PC_CACHE_MISSES,    ///< cache misses of the last level cache
+    PC_BRANCH_MISSES,   ///< mispredicted branch instructions
+    PC_PAGE_FAULTS,     ///< page faults
+
+    PC_COUNT
+};
+
+/// Values of the performance counters of a test unit
+///
+/// The counters which can't be measured on the running system, like the hardware ones within most virtual
+/// machines, are left out.
+struct BOOST_TEST_DECL perf_counters {
+    perf_counters() { clear(); }
+
+    counter_t       m_values[PC_COUNT];
+    unsigned        m_measured;         ///< bit mask of the measured counters, indexed by perf_counter
+
+    void            clear();
+    bool            empty() const                       { return m_measured == 0; }
+    bool            is_measured( perf_counter pc ) const { return (m_measured & (1u << pc)) != 0; }
+
+    /// Adds the counters of another test unit, the ones measured by either of them are kept
+    perf_counters&  operator+=( perf_counters const& );
+
+    /// Identifier of the counter, like "cache_misses"
+    static char const* name( perf_counter pc );
+};
+
+/// Writes the measured counters, like "1200 cycles, 1500 instructions, 2 page faults"
+BOOST_TEST_DECL std::ostream& operator<<( std::ostream& ostr, perf_counters const& pc );
+
+// ************************************************************************** //
+// **************                 perf_monitor                 ************** //
+// ************************************************************************** //
+
+/// This class implements test observer interface and measures the performance counters of each test case
+///
+/// The counters are opened with the Linux @c perf_event_open system call at the start of the test run and
+/// measure the thread executing the test tree, along with the threads and processes it starts. Their values
+/// during the executions of the body of each test case, without its fixtures and the other observers, are
+/// reported to the other observers by framework::perf_counters_measured once the test case is finished. The
+/// counters are not measured when the test cases are executed concurrently or in child processes.
+class BOOST_TEST_DECL perf_monitor_t : public test_observer, public singleton<perf_monitor_t> {
+public:
+    /// @name Test observer interface
+    /// @{
+    virtual void    test_start( counter_t );
+    virtual void    test_finish();
+
+    virtual void    test_unit_start( test_unit const& );
+    virtual void    test_unit_finish( test_unit const&, unsigned long );
+
+    virtual int     priority() { return 4; }
+    /// @}
+
+    /// @name Measure of the test case body
+    /// Called by the framework around each execution of the body of the test case being executed
+    /// @{
+    void            test_body_start( test_case const& );
+    void            test_body_finish( test_case const& );
+    /// @}
+
+    /// Whether some of the counters can be measured on this system
+    bool            is_supported();
+
+private:
+    BOOST_TEST_SINGLETON_CONS( perf_monitor_t )
+}; // perf_monitor_t
+
+BOOST_TEST_SINGLETON_INST( perf_monitor )
+
+} // namespace unit_test
+} // namespace boost
+
+//____________________________________________________________________________//
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_PERF_MONITOR_HPP_101826GER
@@ -17,6 +17,8 @@
 
 // Boost.Test
 #include <boost/test/tree/observer.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/alloc_monitor.hpp>
 
 #include <boost/test/detail/global_typedef.hpp>
 #include <boost/test/detail/fwd_decl.hpp>
@@ -24,6 +26,9 @@
 #include <boost/test/utils/trivial_singleton.hpp>
 #include <boost/test/utils/class_properties.hpp>
 
+// Boost
+#include <boost/cstdint.hpp>
+
 #include <boost/test/detail/suppress_warnings.hpp>
 
 //____________________________________________________________________________//
@@ -62,6 +67,18 @@ public:
     typedef BOOST_READONLY_PROPERTY( bool,      (results_collector_t)
                                                 (test_results)
                                                 (results_collect_helper) ) bool_prop;
+    /// Type representing a duration in nanoseconds
+    typedef BOOST_READONLY_PROPERTY( boost::uint64_t, (results_collector_t)
+                                                (test_results)
+                                                (results_collect_helper) ) duration_prop;
+    /// Type representing the performance counters property
+    typedef BOOST_READONLY_PROPERTY( perf_counters, (results_collector_t)
+                                                (test_results)
+                                                (results_collect_helper) ) perf_counters_prop;
+    /// Type representing the heap allocations property
+    typedef BOOST_READONLY_PROPERTY( alloc_stats, (results_collector_t)
+                                                (test_results)
+                                                (results_collect_helper) ) alloc_stats_prop;
 
     counter_prop    p_assertions_passed;        //!< Number of successful assertions
     counter_prop    p_assertions_failed;        //!< Number of failing assertions
@@ -73,8 +90,15 @@ public:
     counter_prop    p_test_cases_skipped;       //!< Number of skipped test cases
     counter_prop    p_test_cases_aborted;       //!< Number of aborted test cases
     counter_prop    p_duration_microseconds;    //!< Duration of the test in microseconds
+    duration_prop   p_duration_nanoseconds;     //!< Wall time of the test in nanoseconds, measured with a steady clock
+    duration_prop   p_cpu_time_nanoseconds;     //!< CPU time (user and system) of the test in nanoseconds, see test_observer::durations_measured
     bool_prop       p_aborted;                  //!< Indicates that the test unit execution has been aborted
     bool_prop       p_skipped;                  //!< Indicates that the test unit execution has been skipped
+    perf_counters_prop p_perf_counters;         //!< Performance counters of the test unit, if measured (see perf_monitor_t)
+    alloc_stats_prop p_alloc_stats;             //!< Heap allocations of the test unit, if tracked (see alloc_monitor_t)
+    counter_prop    p_peak_resident_bytes;      //!< Peak of the resident memory of the process during the test unit, if sampled
+    counter_prop    p_minor_page_faults;        //!< Number of minor page faults during the test unit, if sampled
+    counter_prop    p_major_page_faults;        //!< Number of major page faults during the test unit, if sampled
 
     /// Returns true if test unit passed
     bool            passed() const;
@@ -91,7 +115,8 @@ public:
 
     //! Combines the results of the current instance with another
     //!
-    //! Only the counters are updated and the @c p_aborted and @c p_skipped are left unchanged.
+    //! Only the counters are updated and the @c p_aborted and @c p_skipped are left unchanged. The peak of the resident
+    //! memory is the highest of the two.
     void            operator+=( test_results const& );
 
     //! Resets the current state of the result
@@ -118,6 +143,9 @@ public:
 
     virtual void        assertion_result( unit_test::assertion_result );
     virtual void        exception_caught( execution_exception const& );
+    virtual void        perf_counters_measured( test_case const&, perf_counters const& );
+    virtual void        allocations_measured( test_case const&, alloc_stats const& );
+    virtual void        durations_measured( test_case const&, utils::elapsed_time const& );
 
     virtual int         priority() { return 2; }
 
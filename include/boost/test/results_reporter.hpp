@@ -98,6 +98,11 @@ BOOST_TEST_DECL void    set_format( results_reporter::format* f );
 /// Use this stream to report additional information abut test module execution
 BOOST_TEST_DECL std::ostream& get_stream();
 
+/// @brief Access to the level of the report being made
+///
+/// The report formatters use it to write the details of the test units only at the detailed level
+BOOST_TEST_DECL report_level get_level();
+
 /// @}
 
 // ************************************************************************** //
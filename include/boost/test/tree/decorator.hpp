@@ -124,9 +124,10 @@ private:
 // **************              decorator::timeout              ************** //
 // ************************************************************************** //
 
+//! Fails the test case if its body runs for longer than the given number of seconds, which may be fractional
 class BOOST_TEST_DECL timeout : public decorator::base {
 public:
-    explicit                timeout( unsigned t ) : m_timeout( t ) {}
+    explicit                timeout( double seconds ) : m_timeout( seconds ) {}
 
 private:
     // decorator::base interface
@@ -134,7 +135,7 @@ private:
     virtual base_ptr        clone() const { return base_ptr(new timeout( m_timeout )); }
 
     // Data members
-    unsigned                m_timeout;
+    double                  m_timeout;
 };
 
 // ************************************************************************** //
@@ -256,6 +257,128 @@ private:
     predicate_t             m_precondition;
 };
 
+// ************************************************************************** //
+// **************          decorator::max_regression           ************** //
+// ************************************************************************** //
+
+//! Fails the test case if it is slower than its regression baseline by more than the given ratio
+//!
+//! The test case is executed @c repeats times and the median duration is compared with the baseline,
+//! which is saved with the runtime parameter @c save_pattern. The assertions and the log entries of the first
+//! execution only are reported, unless one of the next executions fails, which stops the repetition.
+class BOOST_TEST_DECL max_regression : public decorator::base {
+public:
+    explicit                max_regression( double max_ratio, unsigned repeats = 3 )
+    : m_max_ratio( max_ratio )
+    , m_repeats( repeats )
+    {}
+
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new max_regression( m_max_ratio, m_repeats )); }
+
+    // Data members
+    double                  m_max_ratio;
+    unsigned                m_repeats;
+};
+
+// ************************************************************************** //
+// **************          decorator::max_allocations          ************** //
+// ************************************************************************** //
+
+//! Fails the test case if its body makes more than the given number of heap allocations
+//!
+//! The allocations are counted where they can be tracked (see alloc_measure), and the budget is not checked while
+//! the test case is measured as a benchmark.
+class BOOST_TEST_DECL max_allocations : public decorator::base {
+public:
+    explicit                max_allocations( counter_t max_count ) : m_max_count( max_count ) {}
+
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new max_allocations( m_max_count )); }
+
+    // Data members
+    counter_t               m_max_count;
+};
+
+// ************************************************************************** //
+// **************           decorator::memory_budget           ************** //
+// ************************************************************************** //
+
+//! Fails the test case if its body grows the resident memory of the process by more than the given number of bytes
+//!
+//! The growth is the peak of the resident memory during the body above the resident memory at its start. It is checked
+//! where the peak can be reset (see debug::reset_peak_memory_usage), and not while the test case is measured as a
+//! benchmark.
+class BOOST_TEST_DECL memory_budget : public decorator::base {
+public:
+    explicit                memory_budget( counter_t max_bytes ) : m_max_bytes( max_bytes ) {}
+
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new memory_budget( m_max_bytes )); }
+
+    // Data members
+    counter_t               m_max_bytes;
+};
+
+// ************************************************************************** //
+// **************              decorator::serial               ************** //
+// ************************************************************************** //
+
+//! Prevents the test unit and all the test units it contains from being executed concurrently with other test units
+//!
+//! When the test cases are executed concurrently (see the parameters parallel and isolation), the test cases
+//! decorated this way are executed by the thread driving the test tree, once the test cases declared before them are
+//! completed and before the test cases declared after them are started.
+class BOOST_TEST_DECL serial : public decorator::base {
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new serial()); }
+};
+
+// ************************************************************************** //
+// **************           decorator::lazy_samples            ************** //
+// ************************************************************************** //
+
+//! Generates the test cases of a data test case on demand, while it is executed, instead of registering them
+//!
+//! The samples selected by the filters are generated in batches, and the test cases which passed are released
+//! once executed. Only the failed ones are kept in the test tree for the reports.
+class BOOST_TEST_DECL lazy_samples : public decorator::base {
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new lazy_samples()); }
+};
+
+// ************************************************************************** //
+// **************           decorator::data_parallel           ************** //
+// ************************************************************************** //
+
+//! Executes the test cases of a data test case concurrently, by the given number of threads
+//!
+//! The events of each test case are recorded by the thread executing it, and reported in the order of the samples.
+//! The decorator has no effect if the test cases are already executed concurrently (see the parameters parallel and
+//! isolation) or if the threads are not supported.
+class BOOST_TEST_DECL data_parallel : public decorator::base {
+public:
+    explicit                data_parallel( unsigned workers ) : m_workers( workers ) {}
+
+private:
+    // decorator::base interface
+    virtual void            apply( test_unit& tu );
+    virtual base_ptr        clone() const { return base_ptr(new data_parallel( m_workers )); }
+
+    // Data members
+    unsigned                m_workers;
+};
+
 } // namespace decorator
 
 using decorator::label;
@@ -268,6 +391,12 @@ using decorator::enabled;
 using decorator::disabled;
 using decorator::fixture;
 using decorator::precondition;
+using decorator::serial;
+using decorator::max_regression;
+using decorator::max_allocations;
+using decorator::memory_budget;
+using decorator::lazy_samples;
+using decorator::data_parallel;
 
 } // namespace unit_test
 } // namespace boost
@@ -0,0 +1,134 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//!@file
+//!@brief defines recorder of the test events produced outside of the thread driving the test tree
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TREE_EVENT_RECORDER_HPP_112716GER
+#define BOOST_TEST_TREE_EVENT_RECORDER_HPP_112716GER
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+#include <boost/test/detail/global_typedef.hpp>
+#include <boost/test/detail/log_level.hpp>
+#include <boost/test/detail/fwd_decl.hpp>
+
+// Boost
+#include <boost/function/function1.hpp>
+
+// STL
+#include <string>
+#include <vector>
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace framework {
+namespace impl {
+
+// ************************************************************************** //
+// **************                event_recorder                ************** //
+// ************************************************************************** //
+
+/// @brief Records the log entries and the observer notifications produced while a test case is executed
+///
+/// While the recorder is active in a thread, the framework and the log do not dispatch the events produced by this
+/// thread; the events are stored instead, so that they can be replayed later on by the thread driving the
+/// execution of the test tree. This is how the test cases executed concurrently report their results in the
+/// same order as in sequential run.
+class BOOST_TEST_DECL event_recorder {
+public:
+    enum event_type {
+        ET_LOG_BEGIN,       ///< log entry start: file and line
+        ET_LOG_LEVEL,       ///< log entry level: code
+        ET_LOG_VALUE,       ///< log entry value: text
+        ET_LOG_END,         ///< log entry end: context
+        ET_CHECKPOINT,      ///< checkpoint: file, line and text
+        ET_ASSERTION,       ///< assertion result: code repeated num times
+        ET_EXCEPTION,       ///< exception caught: code, text, file, line, function, context and call stack
+        ET_ABORTED,         ///< test unit aborted: num is the test unit id
+        ET_PERF_COUNTERS,   ///< performance counters measured: num is the test case id, code the measured counters
+        ET_ALLOCATIONS      ///< allocations measured: num is the test case id, code whether they are measured
+    };
+
+    struct event {
+        explicit    event( event_type t ) : m_type( t ), m_code( 0 ), m_num( 0 ) {}
+
+        event_type                  m_type;
+        int                         m_code;     ///< log level, assertion result or error code
+        std::size_t                 m_num;      ///< line number, repetition count or test unit id
+        std::string                 m_file;
+        std::string                 m_function;
+        std::string                 m_text;
+        std::vector<std::string>    m_context;
+        std::vector<void*>          m_backtrace; ///< frames of the call stack, symbolized when logged
+        std::vector<counter_t>      m_values;   ///< values of the measures
+    };
+    typedef std::vector<event>      event_list;
+    typedef boost::function<void (event const&)> event_sink;
+
+    /// @param[in] threshold lowest log level of the log entries worth recording
+    explicit                event_recorder( unit_test::log_level threshold = log_successful_tests );
+
+    // log entries
+    void                    log_begin( const_string file_name, std::size_t line_num );
+    void                    log_level( unit_test::log_level l );
+    void                    log_value( const_string value );
+    void                    log_value( lazy_ostream const& value );
+    void                    log_end();
+    void                    set_checkpoint( const_string file_name, std::size_t line_num, const_string msg );
+
+    // observer notifications
+    void                    assertion_result( unit_test::assertion_result ar );
+    void                    exception_caught( execution_exception const& ex );
+    void                    test_unit_aborted( test_unit const& tu );
+    void                    perf_counters_measured( test_case const& tc, perf_counters const& pcs );
+    void                    allocations_measured( test_case const& tc, alloc_stats const& as );
+
+    /// Dispatches recorded events in the calling thread, in the order they were recorded
+    void                    replay() const;
+    void                    clear();
+
+    /// Passes the events to the sink as soon as they are complete, instead of keeping them
+    void                    set_sink( event_sink const& sink ) { m_sink = sink; }
+    /// Passes all the events kept so far to the sink, closing the log entry in progress if any
+    void                    flush();
+
+    event_list const&       events() const  { return m_events; }
+    event_list&             events()        { return m_events; }
+
+    /// Recorder active in the calling thread if any
+    static event_recorder*  active();
+
+private:
+    void                    record_context( event& e ) const;
+    void                    record_checkpoint();
+    void                    release();
+
+    // Data members
+    event_list              m_events;
+    unit_test::log_level    m_threshold;
+    unit_test::log_level    m_entry_level;
+    std::size_t             m_entry_start;      ///< position of the log entry being recorded, if any
+    bool                    m_entry_has_values;
+    event                   m_checkpoint;       ///< last checkpoint, recorded before the next exception only
+    bool                    m_has_checkpoint;
+    event_sink              m_sink;
+};
+
+} // namespace impl
+} // namespace framework
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_TREE_EVENT_RECORDER_HPP_112716GER
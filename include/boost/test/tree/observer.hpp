@@ -98,6 +98,36 @@ public:
     //! additional data about the exception.
     virtual void    exception_caught( execution_exception const& ) {}
 
+    //! Called when a benchmark test case is measured
+    //!
+    //! The call happens between the calls to @ref test_unit_start and @ref test_unit_finish of the test case,
+    //! once its body is measured without any uncaught exception.
+    //! @par Since Boost 1.65
+    virtual void    benchmark_result( test_case const& /* tc */, benchmark_data const& /* bd */ ) {}
+
+    //! Called when the performance counters of a test case are measured
+    //!
+    //! The call happens at the finish of the test case, before the observers with a lower priority than
+    //! the @ref perf_monitor_t are notified about it.
+    //! @par Since Boost 1.65
+    virtual void    perf_counters_measured( test_case const& /* tc */, perf_counters const& /* pcs */ ) {}
+
+    //! Called when the heap allocations of a test case are tracked
+    //!
+    //! The call happens at the finish of the test case, before the observers with a lower priority than
+    //! the @ref alloc_monitor_t are notified about it.
+    //! @par Since Boost 1.65
+    virtual void    allocations_measured( test_case const& /* tc */, alloc_stats const& /* as */ ) {}
+
+    //! Called when the body of a test case is timed
+    //!
+    //! The call happens right before the call to @ref test_unit_finish of the test case, if its body is executed.
+    //! The wall time is measured with a steady clock. The CPU time is the one of the whole process, including the threads
+    //! started by the test case, unless the test case is executed concurrently with others: it is then the CPU time
+    //! of the thread executing the body only.
+    //! @par Since Boost 1.65
+    virtual void    durations_measured( test_case const& /* tc */, utils::elapsed_time const& /* et */ ) {}
+
     virtual int     priority() { return 0; }
 
 protected:
@@ -40,7 +40,19 @@ public:
 private:
     // test tree visitor interface
     virtual void    visit( test_case const& tc )                { if( tc.is_enabled() ) ++p_count.value; }
-    virtual bool    test_suite_start( test_suite const& ts )    { return ts.is_enabled(); }
+    virtual bool    test_suite_start( test_suite const& ts )
+    {
+        if( !ts.is_enabled() )
+            return false;
+
+        // the test cases generated on demand are counted before they are generated
+        if( ts.is_lazy() ) {
+            p_count.value += ts.lazy_size();
+            return false;
+        }
+
+        return true;
+    }
 };
 
 } // namespace unit_test
@@ -96,8 +96,14 @@ public:
     // Public r/w properties
     readwrite_property<std::string>     p_name;                 ///< name for this test unit
     readwrite_property<std::string>     p_description;          ///< description for this test unit
-    readwrite_property<unsigned>        p_timeout;              ///< timeout for the test unit execution in seconds
+    readwrite_property<double>          p_timeout;              ///< timeout for the test unit execution in seconds, possibly fractional
     readwrite_property<counter_t>       p_expected_failures;    ///< number of expected failures in this test unit
+    readwrite_property<bool>            p_serial;               ///< this test unit and its children are never executed concurrently with other test units
+    readwrite_property<double>          p_max_regression;       ///< maximum slowdown of this test case against the regression baseline (0.1 for 10%), 0 if not checked
+    readwrite_property<unsigned>        p_regression_repeats;   ///< number of executions of this test case whose median is checked against the regression baseline
+    readwrite_property<counter_t>       p_max_allocations;      ///< maximum number of heap allocations of this test case body, NO_ALLOCATION_LIMIT if not checked
+    readwrite_property<counter_t>       p_memory_budget;        ///< maximum growth of the resident memory during this test case body in bytes, 0 if not checked
+    readwrite_property<unsigned>        p_data_parallel;        ///< number of threads executing the test cases of this test suite concurrently, 0 if not set
 
     readwrite_property<run_status>      p_default_status;       ///< run status obtained by this unit during setup phase
     readwrite_property<run_status>      p_run_status;           ///< run status assigned to this unit before execution phase after applying all filters
@@ -117,6 +123,39 @@ protected:
 private:
 };
 
+// ************************************************************************** //
+// **************               test_case_source               ************** //
+// ************************************************************************** //
+
+//! Source of the test cases of a test suite generated on demand, while the test suite is executed
+//!
+//! The test cases are identified by their index, from 0 to size()-1. They are generated by increasing index,
+//! and generating them by increasing index again may be more expensive.
+class BOOST_TEST_DECL test_case_source {
+public:
+    //! Number of test cases
+    virtual counter_t   size() const = 0;
+
+    //! Name of the test case with the specified index, known without generating it
+    virtual std::string name( counter_t index ) const = 0;
+
+    //! Generates the test case with the specified index
+    virtual test_case*  make( counter_t index ) = 0;
+
+    //! Index of the test case with the specified name, size() if there is none
+    virtual counter_t   find( const_string tc_name ) const
+    {
+        for( counter_t i = 0; i < size(); ++i ) {
+            if( tc_name == name( i ) )
+                return i;
+        }
+
+        return size();
+    }
+
+    virtual ~test_case_source() {}
+};
+
 // ************************************************************************** //
 // **************              test_unit_generator             ************** //
 // ************************************************************************** //
@@ -125,6 +164,9 @@ class BOOST_TEST_DECL test_unit_generator {
 public:
     virtual test_unit*  next() const = 0;
 
+    //! Source of the same test units, generated on demand while they are executed, if the generator supports it
+    virtual shared_ptr<test_case_source> source() const { return shared_ptr<test_case_source>(); }
+
 protected:
     BOOST_TEST_PROTECTED_VIRTUAL ~test_unit_generator() {}
 };
@@ -140,11 +182,16 @@ public:
     // Constructor
     test_case( const_string tc_name, boost::function<void ()> const& test_func );
     test_case( const_string tc_name, const_string tc_file, std::size_t tc_line, boost::function<void ()> const& test_func );
+    /// Benchmark test case constructor: @c test_func executes the body once, @c benchmark_func the given amount of times
+    test_case( const_string tc_name, const_string tc_file, std::size_t tc_line,
+               boost::function<void ()> const& test_func, boost::function<void (counter_t)> const& benchmark_func );
 
     // Public property
     typedef BOOST_READONLY_PROPERTY(boost::function<void ()>,(test_case))  test_func;
+    typedef BOOST_READONLY_PROPERTY(boost::function<void (counter_t)>,(test_case))  benchmark_func;
 
-    test_func   p_test_func;
+    test_func       p_test_func;
+    benchmark_func  p_benchmark_func;   ///< repeats the body of a benchmark test case; empty for the other test cases
 
 private:
     friend class framework::state;
@@ -169,10 +216,10 @@ public:
      *
      * It is possible to specify the timeout and the expected failures.
      */
-    void            add( test_unit* tu, counter_t expected_failures = 0, unsigned timeout = 0 );
+    void            add( test_unit* tu, counter_t expected_failures = 0, double timeout = 0 );
 
     /// @overload
-    void            add( test_unit_generator const& gen, unsigned timeout = 0 );
+    void            add( test_unit_generator const& gen, double timeout = 0 );
 
     /// @overload
     void            add( test_unit_generator const& gen, decorator::collector& decorators );
@@ -185,6 +232,11 @@ public:
     test_unit_id    get( const_string tu_name ) const;
     std::size_t     size() const { return m_children.size(); }
 
+    //! Indicates that the test cases of this test suite are generated on demand (see decorator::lazy_samples)
+    bool            is_lazy() const { return !!m_source; }
+    //! Number of test cases generated on demand by this test suite in the current run
+    counter_t       lazy_size() const;
+
 protected:
     // Master test suite constructor
     explicit        test_suite( const_string module_name );
@@ -199,6 +251,10 @@ protected:
 
     test_unit_id_list   m_children;
     children_per_rank   m_ranked_children; ///< maps child sibling rank to list of children with that rank
+
+    shared_ptr<test_case_source> m_source;          ///< source of the test cases generated on demand, if any
+    bool                         m_all_samples;     ///< all the test cases of the source are selected for the current run
+    std::vector<counter_t>       m_selected_samples;///< indexes of the test cases selected for the current run otherwise
 };
 
 // ************************************************************************** //
@@ -237,6 +293,32 @@ struct user_tc_method_invoker {
     TestMethod               m_test_method;
 };
 
+//____________________________________________________________________________//
+
+// Repeats a test function, so that it can be measured as the body of a benchmark test case
+struct benchmark_invoker {
+    explicit benchmark_invoker( boost::function<void ()> const& test_func ) : m_test_func( test_func ) {}
+
+    void operator()( counter_t iterations ) const
+    {
+        for( counter_t i = 0; i < iterations; ++i )
+            m_test_func();
+    }
+
+    boost::function<void ()> m_test_func;
+};
+
+//____________________________________________________________________________//
+
+// Executes the body of a benchmark test case once, when it is not measured
+struct benchmark_single_iteration {
+    explicit benchmark_single_iteration( boost::function<void (counter_t)> const& benchmark_func ) : m_benchmark_func( benchmark_func ) {}
+
+    void operator()() const { m_benchmark_func( 1 ); }
+
+    boost::function<void (counter_t)> m_benchmark_func;
+};
+
 } // namespace ut_detail
 
 // ************************************************************************** //
@@ -265,6 +347,20 @@ make_test_case( void (UserTestCase::*           test_method )(),
                           ut_detail::user_tc_method_invoker<InstanceType,UserTestCase>( user_test_case, test_method ) );
 }
 
+// ************************************************************************** //
+// **************             make_benchmark_case              ************** //
+// ************************************************************************** //
+
+inline test_case*
+make_benchmark_case( boost::function<void (counter_t)> const& benchmark_func, const_string tc_name, const_string tc_file, std::size_t tc_line )
+{
+    return new test_case( ut_detail::normalize_test_case_name( tc_name ),
+                          tc_file,
+                          tc_line,
+                          ut_detail::benchmark_single_iteration( benchmark_func ),
+                          benchmark_func );
+}
+
 //____________________________________________________________________________//
 
 } // namespace unit_test
@@ -123,6 +123,10 @@ public:
 
     virtual void        exception_caught( execution_exception const& ex );
 
+    virtual void        benchmark_result( test_case const& tc, benchmark_data const& bd );
+    virtual void        perf_counters_measured( test_case const& tc, perf_counters const& pcs );
+    virtual void        allocations_measured( test_case const& tc, alloc_stats const& as );
+
     virtual int         priority() { return 1; }
 
     // log configuration methods
@@ -148,6 +152,13 @@ public:
     //! @par Since Boost 1.62
     void                set_threshold_level( output_format, log_level );
 
+    //! Returns the lowest threshold level among the enabled loggers
+    //!
+    //! Entries with a level below the returned one are not reported by any logger. The level is computed by the
+    //! configuration methods of this class, so that it can be checked for each assertion: a level set directly on
+    //! a formatter returned by @c get_formatter is only taken into account by the next configuration.
+    log_level           get_min_threshold_level() const;
+
     //! Add a format to the set of loggers
     //!
     //! Adding a logger means that the specified logger is enabled. The log level is managed by the formatter itself
@@ -173,7 +184,7 @@ public:
     //! given in argument.
     //!
     //! The log level and output stream of the new formatter are taken from the currently active logger. In case
-    //! several loggers are active, the order of priority is CUSTOM, HRF, XML, and JUNIT.
+    //! several loggers are active, the order of priority is CUSTOM, HRF, XML, JUNIT and BINARY.
     //! If (unit_test_log_formatter*)0 is given as argument, the custom logger (if any) is removed.
     //!
     //! @note The ownership of the pointer is transfered to the Boost.Test framework. This call is equivalent to
@@ -196,6 +207,12 @@ public:
     //! @par Since Boost 1.62
     void                add_formatter( unit_test_log_formatter* the_formatter );
 
+    //! Waits until the events produced so far are passed to the loggers
+    //!
+    //! With @c --log_async, the events refer to their test units until the writer thread handles them: a test unit
+    //! may only be deleted during the execution after this call.
+    void                drain();
+
     // test progress logging
     void                set_checkpoint( const_string file, std::size_t line_num, const_string msg = const_string() );
 
@@ -265,6 +282,15 @@ BOOST_TEST_SINGLETON_INST( unit_test_log )
         (::boost::wrap_stringstream().ref() << M).str() )       \
 /**/
 
+// checkpoint of the test case invokers, whose message is a string literal: the body of the test case does not
+// allocate any memory for it
+#define BOOST_TEST_INVOKER_CHECKPOINT( test_name, M )           \
+    ::boost::unit_test::unit_test_log.set_checkpoint(           \
+        BOOST_TEST_L(__FILE__),                                 \
+        static_cast<std::size_t>(__LINE__),                     \
+        BOOST_TEST_L( "\"" #test_name "\" " M ) )               \
+/**/
+
 //____________________________________________________________________________//
 
 #include <boost/test/detail/enable_warnings.hpp>
@@ -72,6 +72,33 @@ struct BOOST_TEST_DECL log_checkpoint_data
     }
 };
 
+// ************************************************************************** //
+/// Collection of the timings of a benchmark test case
+// ************************************************************************** //
+
+struct BOOST_TEST_DECL benchmark_data
+{
+    counter_t       m_iterations;   ///< amount of iterations of the test case body measured
+    counter_t       m_samples;      ///< amount of samples the iterations are divided into
+    double          m_mean;         ///< mean duration of an iteration in nanoseconds
+    double          m_median;       ///< median of the mean durations of an iteration in each sample, in nanoseconds
+    double          m_p99;          ///< 99th percentile of the mean durations of an iteration in each sample, in nanoseconds
+    double          m_rate;         ///< amount of iterations per second
+
+    void clear()
+    {
+        m_iterations = m_samples = 0;
+        m_mean = m_median = m_p99 = m_rate = 0;
+    }
+};
+
+namespace ut_detail {
+
+//! Writes the duration given in nanoseconds with the most readable unit
+BOOST_TEST_DECL void print_duration( std::ostream& ostr, double ns );
+
+} // namespace ut_detail
+
 // ************************************************************************** //
 /// @brief Abstract Unit Test Framework log formatter interface
 ///
@@ -272,6 +299,40 @@ public:
     virtual void        entry_context_finish( std::ostream& os ) = 0;
     // @}
 
+    // @name Benchmark report
+
+    /// Invoked when a benchmark test case is measured
+
+    /// The call happens after the measure of the test case body and before the test case finishes. It is made only
+    /// if the log level of the formatter is at most @c log_messages. The default implementation reports the timings
+    /// as an information log entry located at the declaration of the test case.
+    /// @param[in] os   output stream to write a messages into
+    /// @param[in] tc   benchmark test case measured
+    /// @param[in] bd   timings of the iterations of the test case body
+    /// @par Since Boost 1.65
+    virtual void        log_benchmark( std::ostream& os, test_case const& tc, benchmark_data const& bd );
+
+    /// Invoked when the performance counters of a test case are measured
+
+    /// The call happens before the test case finishes, under the same conditions as @ref log_benchmark. The default
+    /// implementation reports the counters as an information log entry located at the declaration of the test case.
+    /// @param[in] os   output stream to write a messages into
+    /// @param[in] tc   test case measured
+    /// @param[in] pcs  performance counters measured during the test case
+    /// @par Since Boost 1.65
+    virtual void        log_perf_counters( std::ostream& os, test_case const& tc, perf_counters const& pcs );
+
+    /// Invoked when the heap allocations of a test case are tracked
+
+    /// The call happens before the test case finishes, under the same conditions as @ref log_benchmark. The default
+    /// implementation reports the allocations as an information log entry located at the declaration of the test case.
+    /// @param[in] os   output stream to write a messages into
+    /// @param[in] tc   test case tracked
+    /// @param[in] as   heap allocations made during the test case
+    /// @par Since Boost 1.65
+    virtual void        log_allocations( std::ostream& os, test_case const& tc, alloc_stats const& as );
+    // @}
+
     // @name Log level management
 
     /// Sets the log level of the logger/formatter
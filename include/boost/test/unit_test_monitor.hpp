@@ -44,7 +44,10 @@ public:
     static bool is_critical_error( error_level e ) { return e <= fatal_error; }
 
     // monitor method
-    error_level execute_and_translate( boost::function<void ()> const& func, unsigned timeout = 0 );
+    error_level execute_and_translate( boost::function<void ()> const& func, double timeout = 0 );
+
+    // same as above using specific execution monitor; used by the threads executing test cases concurrently
+    static error_level execute_and_translate( execution_monitor& em, boost::function<void ()> const& func, double timeout = 0 );
 
 private:
     BOOST_TEST_SINGLETON_CONS( unit_test_monitor_t )
@@ -37,28 +37,45 @@ namespace runtime_config {
 
 // UTF parameters
 BOOST_TEST_DECL extern std::string btrt_auto_start_dbg;
+BOOST_TEST_DECL extern std::string btrt_backtrace;
+BOOST_TEST_DECL extern std::string btrt_benchmark_filter;
+BOOST_TEST_DECL extern std::string btrt_benchmark_min_time;
 BOOST_TEST_DECL extern std::string btrt_break_exec_path;
 BOOST_TEST_DECL extern std::string btrt_build_info;
 BOOST_TEST_DECL extern std::string btrt_catch_sys_errors;
 BOOST_TEST_DECL extern std::string btrt_color_output;
 BOOST_TEST_DECL extern std::string btrt_detect_fp_except;
 BOOST_TEST_DECL extern std::string btrt_detect_mem_leaks;
+BOOST_TEST_DECL extern std::string btrt_durations;
+BOOST_TEST_DECL extern std::string btrt_isolation;
+BOOST_TEST_DECL extern std::string btrt_junit_streaming;
 BOOST_TEST_DECL extern std::string btrt_list_content;
 BOOST_TEST_DECL extern std::string btrt_list_labels;
+BOOST_TEST_DECL extern std::string btrt_log_async;
 BOOST_TEST_DECL extern std::string btrt_log_format;
 BOOST_TEST_DECL extern std::string btrt_log_level;
 BOOST_TEST_DECL extern std::string btrt_log_sink;
 BOOST_TEST_DECL extern std::string btrt_combined_logger;
+BOOST_TEST_DECL extern std::string btrt_memory_usage;
 BOOST_TEST_DECL extern std::string btrt_output_format;
+BOOST_TEST_DECL extern std::string btrt_parallel;
+BOOST_TEST_DECL extern std::string btrt_perf_counters;
 BOOST_TEST_DECL extern std::string btrt_random_seed;
+BOOST_TEST_DECL extern std::string btrt_regression_baseline;
 BOOST_TEST_DECL extern std::string btrt_report_format;
 BOOST_TEST_DECL extern std::string btrt_report_level;
 BOOST_TEST_DECL extern std::string btrt_report_mem_leaks;
 BOOST_TEST_DECL extern std::string btrt_report_sink;
+BOOST_TEST_DECL extern std::string btrt_rerun;
 BOOST_TEST_DECL extern std::string btrt_result_code;
 BOOST_TEST_DECL extern std::string btrt_run_filters;
 BOOST_TEST_DECL extern std::string btrt_save_test_pattern;
+BOOST_TEST_DECL extern std::string btrt_schedule;
+BOOST_TEST_DECL extern std::string btrt_shard_count;
+BOOST_TEST_DECL extern std::string btrt_shard_index;
 BOOST_TEST_DECL extern std::string btrt_show_progress;
+BOOST_TEST_DECL extern std::string btrt_timeout_action;
+BOOST_TEST_DECL extern std::string btrt_track_allocations;
 BOOST_TEST_DECL extern std::string btrt_use_alt_stack;
 BOOST_TEST_DECL extern std::string btrt_wait_for_debugger;
 BOOST_TEST_DECL extern std::string btrt_help;
@@ -101,7 +118,7 @@ public:
     {
     }
 
-    void            setup( const const_string& stream_name )
+    void            setup( const const_string& stream_name, std::ios_base::openmode mode = std::ios_base::out )
     {
         if(stream_name.empty())
             return;
@@ -112,7 +129,7 @@ public:
             m_stream = &std::cout;
         else {
             m_file = boost::make_shared<std::ofstream>();
-            m_file->open( std::string(stream_name.begin(), stream_name.end()).c_str() );
+            m_file->open( std::string(stream_name.begin(), stream_name.end()).c_str(), mode );
             m_stream = m_file.get();
         }
     }
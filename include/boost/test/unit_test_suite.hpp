@@ -40,6 +40,11 @@ boost::unit_test::make_test_case( boost::function<void ()>(test_function), \
 boost::unit_test::make_test_case( (test_function),                         \
                                   BOOST_TEST_STRINGIZE( test_function ),   \
                                   __FILE__, __LINE__, tc_instance )
+#define BOOST_BENCHMARK_CASE( test_function )                              \
+boost::unit_test::make_benchmark_case(                                     \
+    boost::unit_test::ut_detail::benchmark_invoker( (test_function) ),     \
+    BOOST_TEST_STRINGIZE( test_function ),                                 \
+    __FILE__, __LINE__ )
 
 // ************************************************************************** //
 // **************               BOOST_TEST_SUITE               ************** //
@@ -143,11 +148,11 @@ struct test_name : public F { void test_method(); };                    \
                                                                         \
 static void BOOST_AUTO_TC_INVOKER( test_name )()                        \
 {                                                                       \
-    BOOST_TEST_CHECKPOINT('"' << #test_name << "\" fixture entry.");    \
+    BOOST_TEST_INVOKER_CHECKPOINT( test_name, "fixture entry." );       \
     test_name t;                                                        \
-    BOOST_TEST_CHECKPOINT('"' << #test_name << "\" entry.");            \
+    BOOST_TEST_INVOKER_CHECKPOINT( test_name, "entry." );               \
     t.test_method();                                                    \
-    BOOST_TEST_CHECKPOINT('"' << #test_name << "\" exit.");             \
+    BOOST_TEST_INVOKER_CHECKPOINT( test_name, "exit." );                \
 }                                                                       \
                                                                         \
 struct BOOST_AUTO_TC_UNIQUE_ID( test_name ) {};                         \
@@ -214,6 +219,88 @@ BOOST_FIXTURE_TEST_CASE_WITH_DECOR( test_name, F,                       \
 /**/
 
 
+#endif /* BOOST_PP_VARIADICS */
+
+// ************************************************************************** //
+// **************       BOOST_FIXTURE_BENCHMARK_TEST_CASE      ************** //
+// ************************************************************************** //
+
+#define BOOST_FIXTURE_BENCHMARK_TEST_CASE_WITH_DECOR( test_name, F, decorators ) \
+struct test_name : public F { void test_method(); };                    \
+                                                                        \
+static void BOOST_AUTO_TC_INVOKER( test_name )(                         \
+    boost::unit_test::counter_t iterations )                            \
+{                                                                       \
+    BOOST_TEST_INVOKER_CHECKPOINT( test_name, "fixture entry." );       \
+    test_name t;                                                        \
+    BOOST_TEST_INVOKER_CHECKPOINT( test_name, "entry." );               \
+    for( boost::unit_test::counter_t i = 0; i < iterations; ++i )       \
+        t.test_method();                                                \
+    BOOST_TEST_INVOKER_CHECKPOINT( test_name, "exit." );                \
+}                                                                       \
+                                                                        \
+struct BOOST_AUTO_TC_UNIQUE_ID( test_name ) {};                         \
+                                                                        \
+BOOST_AUTO_TU_REGISTRAR( test_name )(                                   \
+    boost::unit_test::make_benchmark_case(                              \
+        &BOOST_AUTO_TC_INVOKER( test_name ),                            \
+        #test_name, __FILE__, __LINE__ ),                               \
+        decorators );                                                   \
+                                                                        \
+void test_name::test_method()                                           \
+/**/
+
+#define BOOST_FIXTURE_BENCHMARK_TEST_CASE_NO_DECOR( test_name, F )      \
+BOOST_FIXTURE_BENCHMARK_TEST_CASE_WITH_DECOR( test_name, F,             \
+    boost::unit_test::decorator::collector::instance() )                \
+/**/
+
+#if BOOST_PP_VARIADICS
+
+#define BOOST_FIXTURE_BENCHMARK_TEST_CASE( ... )                        \
+    BOOST_TEST_INVOKE_IF_N_ARGS( 2,                                     \
+        BOOST_FIXTURE_BENCHMARK_TEST_CASE_NO_DECOR,                     \
+        BOOST_FIXTURE_BENCHMARK_TEST_CASE_WITH_DECOR,                   \
+         __VA_ARGS__)                                                   \
+/**/
+
+#else /* BOOST_PP_VARIADICS */
+
+#define BOOST_FIXTURE_BENCHMARK_TEST_CASE( test_name, F )               \
+     BOOST_FIXTURE_BENCHMARK_TEST_CASE_NO_DECOR(test_name, F)           \
+/**/
+
+#endif /* BOOST_PP_VARIADICS */
+
+// ************************************************************************** //
+// **************         BOOST_BENCHMARK_TEST_CASE            ************** //
+// ************************************************************************** //
+
+#define BOOST_BENCHMARK_TEST_CASE_NO_DECOR( test_name )                 \
+    BOOST_FIXTURE_BENCHMARK_TEST_CASE_NO_DECOR( test_name,              \
+        BOOST_AUTO_TEST_CASE_FIXTURE )                                  \
+/**/
+
+#define BOOST_BENCHMARK_TEST_CASE_WITH_DECOR( test_name, decorators )   \
+    BOOST_FIXTURE_BENCHMARK_TEST_CASE_WITH_DECOR( test_name,            \
+        BOOST_AUTO_TEST_CASE_FIXTURE, decorators )                      \
+/**/
+
+#if BOOST_PP_VARIADICS
+
+#define BOOST_BENCHMARK_TEST_CASE( ... )                                \
+    BOOST_TEST_INVOKE_IF_N_ARGS( 1,                                     \
+        BOOST_BENCHMARK_TEST_CASE_NO_DECOR,                             \
+        BOOST_BENCHMARK_TEST_CASE_WITH_DECOR,                           \
+         __VA_ARGS__)                                                   \
+/**/
+
+#else /* BOOST_PP_VARIADICS */
+
+#define BOOST_BENCHMARK_TEST_CASE( test_name )                          \
+    BOOST_BENCHMARK_TEST_CASE_NO_DECOR( test_name )                     \
+/**/
+
 #endif /* BOOST_PP_VARIADICS */
 
 // ************************************************************************** //
@@ -229,11 +316,11 @@ struct BOOST_AUTO_TC_INVOKER( test_name ) {                             \
     template<typename TestType>                                         \
     static void run( boost::type<TestType>* = 0 )                       \
     {                                                                   \
-        BOOST_TEST_CHECKPOINT('"' << #test_name <<"\" fixture entry."); \
+        BOOST_TEST_INVOKER_CHECKPOINT( test_name, "fixture entry." );   \
         test_name<TestType> t;                                          \
-        BOOST_TEST_CHECKPOINT('"' << #test_name << "\" entry.");        \
+        BOOST_TEST_INVOKER_CHECKPOINT( test_name, "entry." );           \
         t.test_method();                                                \
-        BOOST_TEST_CHECKPOINT('"' << #test_name << "\" exit.");         \
+        BOOST_TEST_INVOKER_CHECKPOINT( test_name, "exit." );            \
     }                                                                   \
 };                                                                      \
                                                                         \
@@ -0,0 +1,137 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  Description : defines the read-only view of the content of a file, mapped in memory where supported
+// ***************************************************************************
+
+#ifndef BOOST_TEST_UTILS_MAPPED_FILE_HPP
+#define BOOST_TEST_UTILS_MAPPED_FILE_HPP
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+
+// STL
+#include <string>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_MAPPED_FILE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace utils {
+
+// ************************************************************************** //
+// **************                  mapped_file                 ************** //
+// ************************************************************************** //
+
+//! Read-only content of a file
+//!
+//! On POSIX systems the file is mapped in memory, so that its pages are only read when they are accessed. Elsewhere
+//! the content of the file is read at once.
+class mapped_file {
+public:
+    // Constructor
+    explicit        mapped_file( std::string const& file_name )
+    : m_data( 0 )
+    , m_size( 0 )
+    , m_last_write_time( 0 )
+    , m_is_open( false )
+    {
+#ifdef BOOST_TEST_SUPPORT_MAPPED_FILE
+        int fd = ::open( file_name.c_str(), O_RDONLY );
+        if( fd < 0 )
+            return;
+
+        struct stat st;
+        if( ::fstat( fd, &st ) == 0 ) {
+            m_size              = static_cast<std::size_t>( st.st_size );
+            m_last_write_time   = static_cast<boost::uint64_t>( st.st_mtime ) * 1000000000u;
+#if defined(__linux__)
+            m_last_write_time  += static_cast<boost::uint64_t>( st.st_mtim.tv_nsec );
+#endif
+
+            if( m_size == 0 )
+                m_is_open = true;
+            else {
+                void* addr = ::mmap( 0, m_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+                if( addr != MAP_FAILED ) {
+                    m_data      = static_cast<char const*>( addr );
+                    m_is_open   = true;
+                }
+            }
+        }
+
+        ::close( fd );
+#else
+        std::ifstream in( file_name.c_str(), std::ios::binary );
+        if( !in )
+            return;
+
+        m_buffer.assign( std::istreambuf_iterator<char>( in ), std::istreambuf_iterator<char>() );
+
+        m_data      = m_buffer.empty() ? 0 : &m_buffer[0];
+        m_size      = m_buffer.size();
+        m_is_open   = !in.bad();
+#endif
+    }
+
+    // Destructor
+    ~mapped_file()
+    {
+#ifdef BOOST_TEST_SUPPORT_MAPPED_FILE
+        if( m_data )
+            ::munmap( const_cast<char*>( m_data ), m_size );
+#endif
+    }
+
+    //! Indicates if the file could be read
+    bool            is_open() const         { return m_is_open; }
+
+    //! Content of the file
+    char const*     data() const            { return m_data; }
+    std::size_t     size() const            { return m_size; }
+
+    //! Time of the last modification of the file, in nanoseconds since the epoch, or 0 if it is not known
+    boost::uint64_t last_write_time() const { return m_last_write_time; }
+
+private:
+    BOOST_DELETED_FUNCTION(mapped_file(mapped_file const&))
+    BOOST_DELETED_FUNCTION(mapped_file& operator=(mapped_file const&))
+
+    // Data members
+    char const*         m_data;
+    std::size_t         m_size;
+    boost::uint64_t     m_last_write_time;
+    bool                m_is_open;
+#ifndef BOOST_TEST_SUPPORT_MAPPED_FILE
+    std::vector<char>   m_buffer;
+#endif
+};
+
+} // namespace utils
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_UTILS_MAPPED_FILE_HPP
@@ -0,0 +1,153 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  Description : defines the timer measuring the wall time and the CPU time of the test units
+// ***************************************************************************
+
+#ifndef BOOST_TEST_UTILS_TIMER_HPP
+#define BOOST_TEST_UTILS_TIMER_HPP
+
+// Boost.Test
+#include <boost/test/detail/config.hpp>
+
+// Boost
+#include <boost/cstdint.hpp>
+
+// STL
+#include <ctime>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+#if defined(unix) || defined(__unix) || defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <time.h>
+#endif
+
+#include <boost/test/detail/suppress_warnings.hpp>
+
+//____________________________________________________________________________//
+
+namespace boost {
+namespace unit_test {
+namespace utils {
+
+// ************************************************************************** //
+// **************                    clocks                    ************** //
+// ************************************************************************** //
+
+//! Reads a steady clock, in nanoseconds since an unspecified point
+inline boost::uint64_t
+steady_clock_ns()
+{
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+    return static_cast<boost::uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#elif defined(CLOCK_MONOTONIC)
+    timespec ts;
+    ::clock_gettime( CLOCK_MONOTONIC, &ts );
+
+    return static_cast<boost::uint64_t>( ts.tv_sec ) * 1000000000u + static_cast<boost::uint64_t>( ts.tv_nsec );
+#else
+    // processor time is the best approximation available
+    return static_cast<boost::uint64_t>( std::clock() ) * 1000000000u / CLOCKS_PER_SEC;
+#endif
+}
+
+//____________________________________________________________________________//
+
+//! Reads the CPU time (user and system) consumed by the calling thread, in nanoseconds
+//!
+//! Where the CPU time of a thread is not available, the processor time of the whole process is returned.
+inline boost::uint64_t
+thread_cpu_clock_ns()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    timespec ts;
+    if( ::clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts ) == 0 )
+        return static_cast<boost::uint64_t>( ts.tv_sec ) * 1000000000u + static_cast<boost::uint64_t>( ts.tv_nsec );
+#endif
+
+    return static_cast<boost::uint64_t>( std::clock() ) * 1000000000u / CLOCKS_PER_SEC;
+}
+
+//____________________________________________________________________________//
+
+//! Reads the CPU time (user and system) consumed by all the threads of the process, in nanoseconds
+inline boost::uint64_t
+process_cpu_clock_ns()
+{
+#ifdef CLOCK_PROCESS_CPUTIME_ID
+    timespec ts;
+    if( ::clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &ts ) == 0 )
+        return static_cast<boost::uint64_t>( ts.tv_sec ) * 1000000000u + static_cast<boost::uint64_t>( ts.tv_nsec );
+#endif
+
+    return static_cast<boost::uint64_t>( std::clock() ) * 1000000000u / CLOCKS_PER_SEC;
+}
+
+// ************************************************************************** //
+// **************                 elapsed_time                 ************** //
+// ************************************************************************** //
+
+//! Durations measured by a timer
+struct elapsed_time {
+    elapsed_time() : m_wall_ns( 0 ), m_cpu_ns( 0 ) {}
+
+    boost::uint64_t m_wall_ns;  //!< wall time, measured with a steady clock
+    boost::uint64_t m_cpu_ns;   //!< CPU time (user and system) of the measuring thread or of the process
+};
+
+// ************************************************************************** //
+// **************                     timer                    ************** //
+// ************************************************************************** //
+
+//! Measures the wall time and the CPU time elapsed since its construction
+//!
+//! Unlike boost::timer, which reads the processor time, the wall time is measured with a steady clock with a
+//! nanosecond precision. The CPU time is the one of the measuring thread, or the one of the whole process when
+//! nothing else is executed meanwhile, which includes the threads started by the measured code.
+class timer {
+public:
+    explicit timer( bool process_cpu_time = false ) : m_process_cpu_time( process_cpu_time ) { restart(); }
+
+    void            restart()
+    {
+        m_wall_start = steady_clock_ns();
+        m_cpu_start  = cpu_clock_ns();
+    }
+
+    //! Wall time elapsed, in seconds
+    double          elapsed() const { return static_cast<double>( steady_clock_ns() - m_wall_start ) * 1e-9; }
+
+    //! Wall time and CPU time elapsed, in nanoseconds
+    elapsed_time    elapsed_times() const
+    {
+        elapsed_time et;
+        et.m_wall_ns = steady_clock_ns() - m_wall_start;
+        et.m_cpu_ns  = cpu_clock_ns() - m_cpu_start;
+
+        return et;
+    }
+
+private:
+    boost::uint64_t cpu_clock_ns() const { return m_process_cpu_time ? process_cpu_clock_ns() : thread_cpu_clock_ns(); }
+
+    // Data members
+    bool            m_process_cpu_time;
+    boost::uint64_t m_wall_start;
+    boost::uint64_t m_cpu_start;
+};
+
+} // namespace utils
+} // namespace unit_test
+} // namespace boost
+
+#include <boost/test/detail/enable_warnings.hpp>
+
+#endif // BOOST_TEST_UTILS_TIMER_HPP
@@ -0,0 +1,149 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the capture of the call stack of the failures detected by the execution monitor
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE backtrace test
+#define BOOST_TEST_ENABLE_THROW_BACKTRACE
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/execution_monitor.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <csignal>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+BOOST_NOINLINE void
+throwing_function()
+{
+    throw std::runtime_error( "thrown from the test" );
+}
+
+static int
+throwing_monitored()
+{
+    throwing_function();
+
+    return 0;
+}
+
+static int
+raising_monitored()
+{
+    std::raise( SIGSEGV );
+
+    return 0;
+}
+
+void throwing_body()
+{
+    throwing_function();
+}
+
+//____________________________________________________________________________//
+
+static boost::stack_trace
+monitored_backtrace( int (*f)(), bool capture )
+{
+    boost::execution_monitor em;
+    em.p_capture_backtrace.value = capture;
+
+    try {
+        em.execute( f );
+    }
+    catch( boost::execution_exception const& ex ) {
+        return ex.backtrace();
+    }
+
+    return boost::stack_trace();
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_stack_trace )
+{
+    int a, b;
+    void* frames[] = { &a, &b };
+
+    boost::stack_trace st( frames, 2 );
+    BOOST_TEST( st.size() == 2U );
+    BOOST_TEST( st.frame( 1 ) == &b );
+    BOOST_TEST( st.symbolize().size() == 2U );
+
+    std::vector<void*> many( boost::stack_trace::max_frames + 10, &a );
+    BOOST_TEST( boost::stack_trace( &many[0], many.size() ).size() == std::size_t( boost::stack_trace::max_frames ) );
+
+    BOOST_TEST( boost::stack_trace().empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_signal_backtrace )
+{
+    if( !boost::stack_trace::is_supported() ) {
+        BOOST_TEST_MESSAGE( "the call stack is not captured on this system" );
+        return;
+    }
+
+    boost::stack_trace st = monitored_backtrace( &raising_monitored, true );
+    BOOST_TEST( !st.empty() );
+    BOOST_TEST( st.symbolize().size() == st.size() );
+
+    BOOST_TEST( monitored_backtrace( &raising_monitored, false ).empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_exception_backtrace )
+{
+    if( !boost::stack_trace::is_supported_for_exceptions() ) {
+        BOOST_TEST_MESSAGE( "the call stack of the exceptions is not captured on this system" );
+        return;
+    }
+
+    boost::stack_trace st = monitored_backtrace( &throwing_monitored, true );
+    BOOST_TEST( !st.empty() );
+
+    BOOST_TEST( monitored_backtrace( &throwing_monitored, false ).empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_backtrace_logged )
+{
+    if( !boost::stack_trace::is_supported_for_exceptions() )
+        return;
+
+    config_guard G;
+    G.set<bool>( ut::runtime_config::btrt_backtrace, true );
+
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ut::test_case* tc = BOOST_TEST_CASE( throwing_body );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    std::string log = run_logged( ts_main->p_id );
+
+    BOOST_TEST( !ut::results_collector.results( tc->p_id ).passed() );
+    BOOST_TEST( log.find( "thrown from the test" ) != std::string::npos );
+    BOOST_TEST( log.find( "\ncall stack:\n    #0 " ) != std::string::npos );
+}
+
+// EOF
@@ -0,0 +1,232 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the tracking of the heap allocations of the test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE alloc monitor test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/alloc_monitor.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <sstream>
+#include <string>
+
+//____________________________________________________________________________//
+
+static int* leaked = 0;
+
+// kept out of the reach of the optimizer, which may remove the allocations that do not escape
+static void* volatile sink = 0;
+
+void allocating_body()
+{
+    sink = new int( 1 );
+    delete static_cast<int*>( sink );
+    sink = new int( 2 );
+    delete static_cast<int*>( sink );
+
+    // left allocated, checking an assertion would allocate as well
+    leaked = new int( 3 );
+}
+
+//____________________________________________________________________________//
+
+void allocating_setup()
+{
+    leaked = new int( 4 );
+}
+
+void empty_body()
+{
+}
+
+//____________________________________________________________________________//
+
+struct leak_guard {
+    ~leak_guard()
+    {
+        delete leaked;
+        leaked = 0;
+    }
+};
+
+//____________________________________________________________________________//
+
+static std::string
+run_tracked( ut::test_case* tc, bool monitored )
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    config_guard G;
+
+    ut::unit_test_log.set_threshold_level( ut::log_successful_tests );
+
+    if( monitored )
+        ut::framework::register_observer( ut::alloc_monitor );
+    std::string log = run_logged( ts_main->p_id );
+    ut::framework::deregister_observer( ut::alloc_monitor );
+
+    return log;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_alloc_measure )
+{
+    if( !ut::alloc_measure::is_supported() ) {
+        BOOST_TEST_MESSAGE( "allocations are not tracked in this build" );
+        return;
+    }
+
+    ut::alloc_measure outer;
+    ut::alloc_measure inner;
+
+    outer.start();
+    int* kept = new int( 1 );
+    sink = kept;
+
+    inner.start();
+    sink = new char[10000];
+    delete[] static_cast<char*>( sink );
+    ut::alloc_stats const inner_stats = inner.stop();
+
+    ut::alloc_stats const outer_stats = outer.stop();
+    delete kept;
+
+    BOOST_TEST( inner_stats.m_measured );
+    BOOST_TEST( inner_stats.m_allocations == 1U );
+    BOOST_TEST( inner_stats.m_bytes == 10000U );
+    BOOST_TEST( inner_stats.m_peak_bytes >= 10000U );
+    BOOST_TEST( inner_stats.m_leaked_blocks == 0U );
+
+    // the enclosing measure includes the inner one
+    BOOST_TEST( outer_stats.m_allocations == 2U );
+    BOOST_TEST( outer_stats.m_bytes == 10000U + sizeof(int) );
+    BOOST_TEST( outer_stats.m_peak_bytes >= 10000U + sizeof(int) );
+    BOOST_TEST( outer_stats.m_leaked_blocks == 1U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_allocations_measured )
+{
+    if( !ut::alloc_measure::is_supported() )
+        return;
+
+    leak_guard G;
+
+    ut::test_case* tc = BOOST_TEST_CASE( allocating_body );
+    std::string log = run_tracked( tc, true );
+
+    ut::alloc_stats const& as = ut::results_collector.results( tc->p_id ).p_alloc_stats;
+    BOOST_TEST( !as.empty() );
+    BOOST_TEST( as.m_allocations >= 3U );
+    BOOST_TEST( as.m_leaked_blocks >= 1U );
+
+    BOOST_TEST( log.find( "info: allocations of \"main/allocating_body\": " ) != std::string::npos );
+    BOOST_TEST( log.find( " leaked block" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_body_measured )
+{
+    if( !ut::alloc_measure::is_supported() )
+        return;
+
+    leak_guard G;
+
+    // neither the fixture nor the framework logging the test case are counted
+    ut::test_case* tc = BOOST_TEST_CASE( empty_body );
+    tc->p_fixtures.value.push_back( ut::test_unit_fixture_ptr(
+        new ut::function_based_fixture( &allocating_setup, boost::function<void ()>() ) ) );
+
+    run_tracked( tc, true );
+
+    ut::alloc_stats const& as = ut::results_collector.results( tc->p_id ).p_alloc_stats;
+    BOOST_TEST( !as.empty() );
+    BOOST_TEST( as.m_allocations == 0U );
+    BOOST_TEST( as.m_bytes == 0U );
+    BOOST_TEST( as.m_leaked_blocks == 0U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_allocation_budget )
+{
+    if( !ut::alloc_measure::is_supported() )
+        return;
+
+    leak_guard G;
+
+    // within the budget
+    ut::test_case* tc = BOOST_TEST_CASE( allocating_body );
+    tc->p_max_allocations.value = 3;
+    std::string log = run_tracked( tc, false );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == 1U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).passed() );
+    BOOST_TEST( log.find( "info: allocation check has passed: 3 allocations [maximum 3]" ) != std::string::npos );
+
+    // the allocations of the test case are not reported without the observer
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_alloc_stats.get().empty() );
+
+    delete leaked;
+    leaked = 0;
+
+    // above the budget
+    tc = BOOST_TEST_CASE( allocating_body );
+    tc->p_max_allocations.value = 2;
+    log = run_tracked( tc, false );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_failed == 1U );
+    BOOST_TEST( log.find( "error: in \"main/allocating_body\": allocation check has failed: 3 allocations [maximum 2]" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_alloc_stats_output )
+{
+    ut::alloc_stats as;
+    as.m_allocations    = 3;
+    as.m_bytes          = 120;
+    as.m_peak_bytes     = 96;
+    as.m_leaked_blocks  = 1;
+    as.m_measured       = true;
+
+    std::ostringstream text;
+    text << as;
+    BOOST_TEST( text.str() == "3 allocations, 120 bytes, peak 96 bytes, 1 leaked block" );
+
+    ut::alloc_stats sum;
+    sum += as;
+    sum += as;
+    BOOST_TEST( sum.m_allocations == 6U );
+    BOOST_TEST( sum.m_peak_bytes == 96U );
+    BOOST_TEST( !sum.empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_decorator, * ut::max_allocations( 10 ) )
+{
+    BOOST_TEST( ut::framework::current_test_case().p_max_allocations == 10U );
+}
+
+// EOF
@@ -0,0 +1,201 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the binary log against the logs written in the other formats
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE binary log formatter test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/output/binary_log_formatter.hpp>
+#include <boost/test/output/compiler_log_formatter.hpp>
+#include <boost/test/output/junit_log_formatter.hpp>
+#include <boost/test/output/xml_log_formatter.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// Boost
+#include <boost/scoped_ptr.hpp>
+
+// STL
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+//____________________________________________________________________________//
+
+void good_test()
+{
+    BOOST_TEST_PASSPOINT();
+    BOOST_TEST( 1 == 1 );
+}
+
+//____________________________________________________________________________//
+
+void bad_test()
+{
+    BOOST_TEST_MESSAGE( "this is a message" );
+
+    BOOST_TEST_INFO( "Context value=something" );
+    BOOST_TEST_CONTEXT( "some context" ) {
+        BOOST_ERROR( "with some message" );
+    }
+    BOOST_WARN( 1 == 2 );
+
+    BOOST_TEST_CHECKPOINT( "last checkpoint before the exception" );
+    throw std::runtime_error( "test is aborted" );
+}
+
+//____________________________________________________________________________//
+
+void verbose_test()
+{
+    for( int i = 0; i < 100; ++i )
+        BOOST_TEST_MESSAGE( "message " << i );
+}
+
+//____________________________________________________________________________//
+
+std::string
+log_of( ut::test_suite* ts, ut::output_format format, ut::log_level level )
+{
+    config_guard G;
+
+    G.set_log_format( format );
+    ut::unit_test_log.set_threshold_level( level );
+
+    return run_logged( ts->p_id );
+}
+
+//____________________________________________________________________________//
+
+std::string
+decode( std::string const& binary_log, ut::output_format format, ut::log_level level )
+{
+    boost::scoped_ptr<ut::unit_test_log_formatter> formatter;
+    if( format == ut::OF_CLF )
+        formatter.reset( new ut::output::compiler_log_formatter );
+    else if( format == ut::OF_XML )
+        formatter.reset( new ut::output::xml_log_formatter );
+    else
+        formatter.reset( new ut::output::junit_log_formatter );
+
+    formatter->set_log_level( level );
+
+    std::istringstream input( binary_log );
+    std::ostringstream output;
+    ut::output::decode_binary_log( input, *formatter, output );
+
+    return output.str();
+}
+
+//____________________________________________________________________________//
+
+ut::test_suite*
+make_test_tree()
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+
+    ut::test_case* tc_good = BOOST_TEST_CASE( good_test );
+    ut::test_case* tc_bad  = BOOST_TEST_CASE( bad_test );
+    ut::test_case* tc_skip = BOOST_TEST_CASE( good_test );
+    tc_skip->p_name.value = "skipped_test";
+    tc_skip->depends_on( tc_bad );
+
+    ut::test_suite* ts_inner = BOOST_TEST_SUITE( "inner" );
+    ts_inner->add( BOOST_TEST_CASE( verbose_test ) );
+    ts_inner->add( BOOST_TEST_CASE( good_test ), 1 );
+
+    ts_main->add( tc_good );
+    ts_main->add( tc_bad );
+    ts_main->add( tc_skip );
+    ts_main->add( ts_inner );
+
+    setup_test_tree( *ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_decoded_log_matches_direct_log )
+{
+    ut::test_suite* ts_main = make_test_tree();
+
+    ut::output_format const formats[] = { ut::OF_CLF, ut::OF_XML, ut::OF_JUNIT };
+    ut::log_level const     levels[]  = { ut::log_successful_tests, ut::log_messages, ut::log_all_errors };
+
+    for( std::size_t l = 0; l < sizeof(levels)/sizeof(levels[0]); ++l ) {
+        std::string binary_log = log_of( ts_main, ut::OF_BINARY, levels[l] );
+
+        for( std::size_t f = 0; f < sizeof(formats)/sizeof(formats[0]); ++f ) {
+            std::string direct_log  = scrub_times( log_of( ts_main, formats[f], levels[l] ) );
+            std::string decoded_log = scrub_times( decode( binary_log, formats[f], levels[l] ) );
+
+            BOOST_TEST( direct_log.find( "some context" ) != std::string::npos );
+            BOOST_TEST( decoded_log == direct_log, "log in format " << formats[f] << " at level " << levels[l] << " differs" );
+        }
+    }
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_log_entries_below_recorded_level )
+{
+    ut::test_suite* ts_main = make_test_tree();
+
+    // the test units and the errors are recorded, the messages are not
+    std::string binary_log = log_of( ts_main, ut::OF_BINARY, ut::log_all_errors );
+    std::string xml_log    = decode( binary_log, ut::OF_XML, ut::log_successful_tests );
+
+    BOOST_TEST( xml_log.find( "<TestCase name=\"good_test\"" ) != std::string::npos );
+    BOOST_TEST( xml_log.find( "with some message" ) != std::string::npos );
+    BOOST_TEST( xml_log.find( "message 99" ) == std::string::npos );
+
+    // the results of the test tree are rebuilt regardless of the recorded level
+    std::string junit_log = decode( binary_log, ut::OF_JUNIT, ut::log_successful_tests );
+
+    BOOST_TEST( junit_log.find( "skipped=\"1\"" ) != std::string::npos );
+    BOOST_TEST( junit_log.find( "errors=\"1\"" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_file_names_are_interned )
+{
+    ut::test_suite* ts_main = make_test_tree();
+
+    std::string binary_log = log_of( ts_main, ut::OF_BINARY, ut::log_successful_tests );
+    std::string file_name( __FILE__ );
+
+    std::string::size_type first = binary_log.find( file_name );
+    BOOST_TEST_REQUIRE( first != std::string::npos );
+    BOOST_TEST( binary_log.find( file_name, first + 1 ) == std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_malformed_log )
+{
+    std::string binary_log = log_of( make_test_tree(), ut::OF_BINARY, ut::log_all_errors );
+
+    BOOST_CHECK_THROW( decode( "not a binary log", ut::OF_XML, ut::log_all_errors ), std::runtime_error );
+
+    // the last record is cut
+    BOOST_CHECK_THROW( decode( binary_log.substr( 0, binary_log.size() - 1 ), ut::OF_XML, ut::log_all_errors ),
+                       std::runtime_error );
+
+    // the log of an interrupted test run ends with a complete record
+    BOOST_CHECK_NO_THROW( decode( binary_log.substr( 0, binary_log.size() - 2 ), ut::OF_XML, ut::log_all_errors ) );
+}
+
+// EOF
@@ -0,0 +1,201 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the JUNIT log written out while the test cases are executed against the JUNIT log written at the end
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE junit streaming test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+std::ostringstream* streamed_log = 0;
+
+void good_test()
+{
+    BOOST_TEST_PASSPOINT();
+    BOOST_TEST( 1 == 1 );
+}
+
+//____________________________________________________________________________//
+
+void bad_test()
+{
+    BOOST_TEST_MESSAGE( "this is a message" );
+
+    BOOST_TEST_CONTEXT( "some context" ) {
+        BOOST_ERROR( "with some message" );
+    }
+
+    throw std::runtime_error( "test is aborted" );
+}
+
+//____________________________________________________________________________//
+
+void streamed_test()
+{
+    // the test cases finished before are in the log already
+    BOOST_TEST( (!streamed_log || streamed_log->str().find( "name=\"good_test\"" ) != std::string::npos) );
+}
+
+//____________________________________________________________________________//
+
+struct streamed_log_guard : config_guard {
+    ~streamed_log_guard()
+    {
+        streamed_log = 0;
+    }
+};
+
+//____________________________________________________________________________//
+
+void
+run_junit_logged( ut::test_suite* ts, std::ostream& output, bool streaming )
+{
+    config_guard G;
+
+    G.set<bool>( ut::runtime_config::btrt_junit_streaming, streaming );
+    G.set_log_format( ut::OF_JUNIT );
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    run_logged( ts->p_id, output );
+}
+
+//____________________________________________________________________________//
+
+std::vector<std::string>
+test_case_elements( std::string const& log )
+{
+    std::vector<std::string> res;
+
+    std::string::size_type pos = 0;
+    while( (pos = log.find( "<testcase", pos )) != std::string::npos ) {
+        std::string::size_type end = log.find( "</testcase>", pos );
+        BOOST_TEST_REQUIRE( end != std::string::npos );
+
+        res.push_back( log.substr( pos, end - pos ) );
+        pos = end;
+    }
+
+    std::sort( res.begin(), res.end() );
+    return res;
+}
+
+//____________________________________________________________________________//
+
+ut::test_suite*
+make_test_tree()
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+
+    ut::test_case* tc_good = BOOST_TEST_CASE( good_test );
+    ut::test_case* tc_bad  = BOOST_TEST_CASE( bad_test );
+    ut::test_case* tc_skip = BOOST_TEST_CASE( good_test );
+    tc_skip->p_name.value = "skipped_test";
+    tc_skip->depends_on( tc_bad );
+
+    ut::test_case* tc_disabled = BOOST_TEST_CASE( good_test );
+    tc_disabled->p_name.value = "disabled_test";
+    tc_disabled->p_default_status.value = ut::test_unit::RS_DISABLED;
+
+    ut::test_suite* ts_inner = BOOST_TEST_SUITE( "inner" );
+    ts_inner->add( BOOST_TEST_CASE( good_test ) );
+    ts_inner->add( BOOST_TEST_CASE( streamed_test ) );
+
+    ts_main->add( tc_good );
+    ts_main->add( tc_bad );
+    ts_main->add( tc_skip );
+    ts_main->add( tc_disabled );
+    ts_main->add( ts_inner );
+
+    setup_test_tree( *ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_streamed_log_matches_buffered_log )
+{
+    streamed_log_guard G;
+    ut::test_suite* ts_main = make_test_tree();
+
+    std::ostringstream buffered;
+    run_junit_logged( ts_main, buffered, false );
+
+    std::ostringstream streamed;
+    streamed_log = &streamed;
+    run_junit_logged( ts_main, streamed, true );
+
+    std::string buffered_log = scrub_times( buffered.str() );
+    std::string streamed_text = scrub_times( streamed.str() );
+
+    // the test cases are written out in the order they finish
+    std::vector<std::string> buffered_cases = test_case_elements( buffered_log );
+    std::vector<std::string> streamed_cases = test_case_elements( streamed_text );
+
+    BOOST_TEST( buffered_cases.size() == 6U );
+    BOOST_TEST( streamed_cases == buffered_cases, boost::test_tools::per_element() );
+
+    // the totals are written into the opening tag of the test suite
+    std::string totals = "<testsuite tests=\"3\" skipped=\"1\" errors=\"1\" failures=\"1\"";
+    BOOST_TEST( buffered_log.find( totals ) != std::string::npos );
+    BOOST_TEST( streamed_text.find( totals ) != std::string::npos );
+    BOOST_TEST( streamed_text.find( "<!--" ) == std::string::npos );
+
+    BOOST_TEST( streamed_text.find( "</testsuite>" ) == streamed_text.size() - std::string( "</testsuite>" ).size() );
+}
+
+//____________________________________________________________________________//
+
+// stream buffer which cannot be repositioned, like a pipe
+class pipe_buffer : public std::streambuf {
+public:
+    std::string m_content;
+
+protected:
+    int_type overflow( int_type c )
+    {
+        if( !traits_type::eq_int_type( c, traits_type::eof() ) )
+            m_content += traits_type::to_char_type( c );
+
+        return traits_type::not_eof( c );
+    }
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_totals_trailing_unseekable_log )
+{
+    ut::test_suite* ts_main = make_test_tree();
+
+    pipe_buffer buffer;
+    std::ostream pipe( &buffer );
+    run_junit_logged( ts_main, pipe, true );
+
+    std::string log = buffer.m_content;
+
+    BOOST_TEST( test_case_elements( log ).size() == 6U );
+    BOOST_TEST( log.find( "<testsuite tests=" ) == std::string::npos );
+    BOOST_TEST( log.find( "</testsuite>\n<!-- testsuite tests=\"3\" skipped=\"1\" errors=\"1\" failures=\"1\"" ) != std::string::npos );
+}
+
+// EOF
@@ -0,0 +1,167 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the log written out by a dedicated thread against the log written out by the test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE log async test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+
+namespace ut = boost::unit_test;
+namespace data = boost::unit_test::data;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//____________________________________________________________________________//
+
+void good_test()
+{
+    BOOST_TEST_PASSPOINT();
+    BOOST_TEST( 1 == 1 );
+}
+
+//____________________________________________________________________________//
+
+void bad_test()
+{
+    BOOST_TEST_MESSAGE( "this is a message" );
+
+    BOOST_TEST_INFO( "Context value=something" );
+    BOOST_TEST_CONTEXT( "some context" ) {
+        BOOST_ERROR( "with some message" );
+    }
+
+    BOOST_TEST_CHECKPOINT( "last checkpoint before the exception" );
+    throw std::runtime_error( "test is aborted" );
+}
+
+//____________________________________________________________________________//
+
+void verbose_test()
+{
+    // more log entries than records in the buffer
+    for( int i = 0; i < 2000; ++i )
+        BOOST_TEST_MESSAGE( "message " << i );
+}
+
+BOOST_AUTO_TEST_SUITE( lazy )
+
+// the samples which passed are deleted after each batch
+BOOST_TEST_DECORATOR( * ut::lazy_samples() )
+BOOST_DATA_TEST_CASE( samples, data::xrange( 300 ), value )
+{
+    BOOST_TEST( value >= 0 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//____________________________________________________________________________//
+
+std::string
+log_of( ut::test_unit_id id, ut::output_format format, bool async )
+{
+    config_guard G;
+
+    G.set<bool>( ut::runtime_config::btrt_log_async, async );
+    G.set_log_format( format );
+    ut::unit_test_log.set_threshold_level( ut::log_successful_tests );
+
+    return scrub_times( run_logged( id ) );
+}
+
+//____________________________________________________________________________//
+
+ut::test_suite*
+make_test_tree()
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+
+    ut::test_case* tc_good = BOOST_TEST_CASE( good_test );
+    ut::test_case* tc_bad  = BOOST_TEST_CASE( bad_test );
+    ut::test_case* tc_skip = BOOST_TEST_CASE( good_test );
+    tc_skip->p_name.value = "skipped_test";
+    tc_skip->depends_on( tc_bad );
+
+    ts_main->add( tc_good );
+    ts_main->add( tc_bad );
+    ts_main->add( tc_skip );
+    ts_main->add( BOOST_TEST_CASE( verbose_test ) );
+
+    setup_test_tree( *ts_main );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_async_log_matches_sync_log )
+{
+    ut::test_suite* ts_main = make_test_tree();
+
+    ut::output_format const formats[] = { ut::OF_CLF, ut::OF_XML, ut::OF_JUNIT };
+
+    for( std::size_t i = 0; i < sizeof(formats)/sizeof(formats[0]); ++i ) {
+        std::string sync_log  = log_of( ts_main->p_id, formats[i], false );
+        std::string async_log = log_of( ts_main->p_id, formats[i], true );
+
+        BOOST_TEST( sync_log.find( "message 1999" ) != std::string::npos );
+        BOOST_TEST( sync_log.find( "some context" ) != std::string::npos );
+        BOOST_TEST( async_log == sync_log, "log in format " << formats[i] << " differs" );
+    }
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_async_log_of_released_samples )
+{
+    ut::test_unit_id ts_lazy = ut::framework::master_test_suite().get( "lazy" );
+
+    // the test cases logged are deleted only once their events are written out
+    std::string sync_log  = log_of( ts_lazy, ut::OF_CLF, false );
+    std::string async_log = log_of( ts_lazy, ut::OF_CLF, true );
+
+    BOOST_TEST( sync_log.find( "Leaving test case \"_299\"" ) != std::string::npos );
+    BOOST_TEST( async_log == sync_log );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_async_log_written_out_on_reconfiguration )
+{
+    config_guard G;
+
+    G.set<bool>( ut::runtime_config::btrt_log_async, true );
+    G.set_log_format( ut::OF_CLF );
+
+    std::ostringstream output;
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+    ut::unit_test_log.set_stream( output );
+
+    ut::unit_test_log.test_start( 0 );
+    for( int i = 0; i < 100; ++i )
+        BOOST_TEST_MESSAGE( "entry " << i );
+
+    // captured entries are written out to the stream they were logged to
+    ut::unit_test_log.set_stream( std::cout );
+
+    BOOST_TEST( output.str().find( "entry 99" ) != std::string::npos );
+
+    ut::unit_test_log.test_finish();
+}
+
+// EOF
@@ -0,0 +1,163 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the memory usage sampled for the test units and the memory budget of the test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE memory usage test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/results_reporter.hpp>
+#include <boost/test/debug.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <sstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+static const std::size_t touched_bytes = 32 * 1024 * 1024;
+
+void touching_body()
+{
+    // touches fresh pages, which grow the resident memory
+    std::vector<char> buffer( touched_bytes );
+    for( std::size_t i = 0; i < buffer.size(); i += 4096 )
+        buffer[i] = 1;
+
+    BOOST_TEST( buffer[0] == 1 );
+}
+
+//____________________________________________________________________________//
+
+static std::string
+run_sampled( ut::test_case* tc, ut::test_suite*& ts_main )
+{
+    ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    config_guard G;
+
+    ut::unit_test_log.set_threshold_level( ut::log_successful_tests );
+
+    return run_logged( ts_main->p_id );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_process_memory_usage )
+{
+    boost::debug::process_memory_usage usage;
+    if( !boost::debug::memory_usage( usage ) ) {
+        BOOST_TEST_MESSAGE( "memory usage is not available on this system" );
+        return;
+    }
+
+    BOOST_TEST( usage.m_resident_bytes > 0U );
+    BOOST_TEST( usage.m_peak_resident_bytes >= usage.m_resident_bytes );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_memory_sampled )
+{
+    boost::debug::process_memory_usage usage;
+    if( !boost::debug::memory_usage( usage ) )
+        return;
+
+    config_guard G;
+    G.set<bool>( ut::runtime_config::btrt_memory_usage, true );
+
+    ut::test_suite* ts_main = 0;
+    ut::test_case* tc = BOOST_TEST_CASE( touching_body );
+    run_sampled( tc, ts_main );
+
+    ut::test_results const& tr = ut::results_collector.results( tc->p_id );
+    BOOST_TEST( tr.p_peak_resident_bytes >= touched_bytes );
+    BOOST_TEST( tr.p_minor_page_faults + tr.p_major_page_faults >= 1U );
+
+    // the peak of the test suite is the highest of its test cases, its page faults are their sum
+    ut::test_results const& suite_tr = ut::results_collector.results( ts_main->p_id );
+    BOOST_TEST( suite_tr.p_peak_resident_bytes == tr.p_peak_resident_bytes );
+    BOOST_TEST( suite_tr.p_minor_page_faults == tr.p_minor_page_faults );
+
+    std::ostringstream report;
+    ut::results_reporter::set_stream( report );
+    ut::results_reporter::make_report( ut::DETAILED_REPORT, ts_main->p_id );
+
+    BOOST_TEST( report.str().find( "peak resident memory: " ) != std::string::npos );
+    BOOST_TEST( report.str().find( " major page faults" ) != std::string::npos );
+
+    // the short report is unchanged
+    std::ostringstream short_report;
+    ut::results_reporter::set_stream( short_report );
+    ut::results_reporter::make_report( ut::SHORT_REPORT, ts_main->p_id );
+
+    BOOST_TEST( short_report.str().find( "peak resident memory: " ) == std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_not_sampled_by_default )
+{
+    config_guard G;
+
+    ut::test_suite* ts_main = 0;
+    ut::test_case* tc = BOOST_TEST_CASE( touching_body );
+    run_sampled( tc, ts_main );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_peak_resident_bytes == 0U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_memory_budget )
+{
+    if( !boost::debug::reset_peak_memory_usage() ) {
+        BOOST_TEST_MESSAGE( "the peak resident memory can't be reset on this system" );
+        return;
+    }
+
+    config_guard G;
+
+    // within the budget
+    ut::test_suite* ts_main = 0;
+    ut::test_case* tc = BOOST_TEST_CASE( touching_body );
+    tc->p_memory_budget.value = 16 * touched_bytes;
+    std::string log = run_sampled( tc, ts_main );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == 2U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).passed() );
+    BOOST_TEST( log.find( "info: memory check has passed: peak resident memory grew by " ) != std::string::npos );
+
+    // above the budget
+    tc = BOOST_TEST_CASE( touching_body );
+    tc->p_memory_budget.value = touched_bytes / 2;
+    log = run_sampled( tc, ts_main );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_failed == 1U );
+    BOOST_TEST( log.find( "error: in \"main/touching_body\": memory check has failed: peak resident memory grew by " ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_decorator, * ut::memory_budget( 1024 * 1024 ) )
+{
+    BOOST_TEST( ut::framework::current_test_case().p_memory_budget == 1024U * 1024U );
+}
+
+// EOF
@@ -0,0 +1,160 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the performance counters measured by the perf_monitor
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE perf monitor test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/perf_monitor.hpp>
+#include <boost/test/output/xml_log_formatter.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <sstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+void touching_body()
+{
+    // touches fresh pages, which cause page faults
+    std::vector<char> buffer( 16 * 1024 * 1024 );
+    for( std::size_t i = 0; i < buffer.size(); i += 4096 )
+        buffer[i] = 1;
+
+    BOOST_TEST( buffer[0] == 1 );
+}
+
+//____________________________________________________________________________//
+
+void empty_body()
+{
+}
+
+//____________________________________________________________________________//
+
+// Runs the test tree with the performance counters of its test cases measured
+static std::string
+run_measured( ut::test_suite& ts )
+{
+    setup_test_tree( ts );
+
+    ut::framework::register_observer( ut::perf_monitor );
+    std::string log = run_logged( ts.p_id );
+    ut::framework::deregister_observer( ut::perf_monitor );
+
+    return log;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_counters_measured )
+{
+    if( !ut::perf_monitor.is_supported() ) {
+        BOOST_TEST_MESSAGE( "performance counters are not available on this system" );
+        return;
+    }
+
+    config_guard G;
+
+    ut::test_case* tc = BOOST_TEST_CASE( touching_body );
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    std::string log = run_measured( *ts_main );
+
+    ut::perf_counters const& pcs = ut::results_collector.results( tc->p_id ).p_perf_counters;
+    BOOST_TEST( !pcs.empty() );
+
+    // the software counters are available even where the hardware ones are not
+    BOOST_TEST( pcs.is_measured( ut::PC_PAGE_FAULTS ) );
+    BOOST_TEST( pcs.m_values[ut::PC_PAGE_FAULTS] >= 1U );
+
+    // the counters of the test suite sum the ones of its test cases
+    ut::perf_counters const& suite_pcs = ut::results_collector.results( ts_main->p_id ).p_perf_counters;
+    BOOST_TEST( suite_pcs.m_measured == pcs.m_measured );
+    BOOST_TEST( suite_pcs.m_values[ut::PC_PAGE_FAULTS] == pcs.m_values[ut::PC_PAGE_FAULTS] );
+
+    BOOST_TEST( log.find( "info: performance counters of \"main/touching_body\": " ) != std::string::npos );
+    BOOST_TEST( log.find( " page faults" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_fixtures_not_measured )
+{
+    if( !ut::perf_monitor.is_supported() )
+        return;
+
+    ut::test_case* tc = BOOST_TEST_CASE( empty_body );
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+
+    // the fixture touches as many pages as the body of the first test case
+    tc->p_fixtures.value.push_back( ut::test_unit_fixture_ptr(
+        new ut::function_based_fixture( &touching_body, boost::function<void ()>() ) ) );
+
+    run_measured( *ts_main );
+
+    ut::perf_counters const& pcs = ut::results_collector.results( tc->p_id ).p_perf_counters;
+    BOOST_TEST( pcs.is_measured( ut::PC_PAGE_FAULTS ) );
+    BOOST_TEST( pcs.m_values[ut::PC_PAGE_FAULTS] < 1000U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_not_measured_without_observer )
+{
+    ut::test_case* tc = BOOST_TEST_CASE( touching_body );
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    run_logged( ts_main->p_id );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_perf_counters.get().empty() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_counters_output )
+{
+    ut::perf_counters pcs;
+    pcs.m_values[ut::PC_CYCLES]         = 1200;
+    pcs.m_values[ut::PC_INSTRUCTIONS]   = 1500;
+    pcs.m_values[ut::PC_PAGE_FAULTS]    = 2;
+    pcs.m_measured = (1u << ut::PC_CYCLES) | (1u << ut::PC_INSTRUCTIONS) | (1u << ut::PC_PAGE_FAULTS);
+
+    std::ostringstream text;
+    text << pcs;
+    BOOST_TEST( text.str() == "1200 cycles, 1500 instructions, 2 page faults" );
+
+    std::ostringstream xml;
+    ut::output::xml_log_formatter formatter;
+    formatter.log_perf_counters( xml, ut::framework::current_test_case(), pcs );
+    BOOST_TEST( xml.str() == "<PerfCounters cycles=\"1200\" instructions=\"1500\" page_faults=\"2\"/>" );
+
+    ut::perf_counters sum;
+    sum += pcs;
+    sum += pcs;
+    BOOST_TEST( sum.m_measured == pcs.m_measured );
+    BOOST_TEST( sum.m_values[ut::PC_CYCLES] == 2400U );
+}
+
+// EOF
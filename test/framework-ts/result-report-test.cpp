@@ -23,6 +23,7 @@
 #include <boost/test/framework.hpp>
 #include <boost/test/unit_test_parameters.hpp>
 #include <boost/test/utils/nullstream.hpp>
+#include <boost/test/utils/algorithm.hpp>
 typedef boost::onullstream onullstream_type;
 
 // BOOST
@@ -96,6 +97,33 @@ void check( output_test_stream& output, test_suite* ts )
 
 //____________________________________________________________________________//
 
+// Replaces the durations, which vary from a run to another
+class output_test_stream_for_reports : public output_test_stream {
+public:
+    explicit output_test_stream_for_reports(
+        boost::unit_test::const_string    pattern_file_name = boost::unit_test::const_string(),
+        bool                              match_or_save     = true )
+    : output_test_stream(pattern_file_name, match_or_save)
+    {}
+
+    virtual std::string get_stream_string_representation() const {
+        static const std::string to_look_for[] = {"wall time: *\n",
+                                                  " wall_time_nanoseconds=\"*\"",
+                                                  " cpu_time_nanoseconds=\"*\""};
+        static const std::string to_replace[]  = {"wall time: ZZZ\n",
+                                                  " wall_time_nanoseconds=\"ZZZ\"",
+                                                  " cpu_time_nanoseconds=\"ZZZ\""};
+
+        return utils::replace_all_occurrences_with_wildcards(
+            output_test_stream::get_stream_string_representation(),
+            to_look_for, to_look_for + sizeof(to_look_for)/sizeof(to_look_for[0]),
+            to_replace, to_replace + sizeof(to_replace)/sizeof(to_replace[0])
+        );
+    }
+};
+
+//____________________________________________________________________________//
+
 struct guard {
     ~guard()
     {
@@ -119,7 +147,7 @@ BOOST_AUTO_TEST_CASE( test_result_reports )
             ? (runtime_config::save_pattern() ? PATTERN_FILE_NAME : "./baseline-outputs/" PATTERN_FILE_NAME )
             : framework::master_test_suite().argv[1] );
 
-    output_test_stream test_output( pattern_file_name, !runtime_config::save_pattern() );
+    output_test_stream_for_reports test_output( pattern_file_name, !runtime_config::save_pattern() );
     results_reporter::set_stream( test_output );
 
     test_suite* ts_0 = BOOST_TEST_SUITE( "0 test cases inside" );
@@ -0,0 +1,194 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the assertions of the threads started by a test case, made without any synchronization
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE concurrent assertions test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <atomic>
+#include <thread>
+
+//____________________________________________________________________________//
+
+static const unsigned threads_count    = 64;
+static const unsigned assertions_count = 10000;
+
+static void
+thread_function( unsigned thread_id )
+{
+    for( unsigned i = 0; i < assertions_count; ++i )
+        BOOST_TEST( i < assertions_count );
+
+    BOOST_WARN( thread_id != 0 );
+
+    BOOST_TEST_CONTEXT( "thread " << thread_id ) {
+        BOOST_ERROR( "failure of thread " << thread_id << " with a long enough message not to be written at once" );
+    }
+}
+
+//____________________________________________________________________________//
+
+void
+asserting_threads()
+{
+    std::vector<std::thread> threads;
+
+    for( unsigned i = 0; i < threads_count; ++i )
+        threads.push_back( std::thread( thread_function, i ) );
+
+    for( unsigned i = 0; i < threads_count; ++i )
+        threads[i].join();
+}
+
+//____________________________________________________________________________//
+
+void
+single_thread()
+{
+    std::thread( thread_function, 0U ).join();
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_assertions_from_threads )
+{
+    config_guard G;
+
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ut::test_case* tc_threads = BOOST_TEST_CASE( asserting_threads );
+    ut::test_case* tc_next    = BOOST_TEST_CASE( single_thread );
+    ts_main->add( tc_threads );
+    ts_main->add( tc_next );
+    setup_test_tree( *ts_main );
+
+    ut::unit_test_log.set_threshold_level( ut::log_warnings );
+
+    std::string log = run_logged( ts_main->p_id );
+
+    // the assertions are merged into the results of the test case which started the threads
+    ut::test_results const& tr = ut::results_collector.results( tc_threads->p_id );
+    BOOST_TEST( tr.p_assertions_passed == threads_count * assertions_count + threads_count - 1 ); // passed warnings
+    BOOST_TEST( tr.p_assertions_failed == threads_count );
+    BOOST_TEST( tr.p_warnings_failed == 1U );
+
+    ut::test_results const& tr_next = ut::results_collector.results( tc_next->p_id );
+    BOOST_TEST( tr_next.p_assertions_passed == assertions_count );
+    BOOST_TEST( tr_next.p_warnings_failed == 1U );
+    BOOST_TEST( tr_next.p_assertions_failed == 1U );
+
+    // each log entry is written out at once, along with its context
+    std::istringstream lines( log );
+    std::string line;
+    unsigned errors = 0, contexts = 0;
+
+    while( std::getline( lines, line ) ) {
+        if( line.find( "error: in \"main/asserting_threads\": failure of thread " ) != std::string::npos ) {
+            BOOST_TEST( line.find( "not to be written at once" ) == line.size() - 25 );
+            ++errors;
+        }
+        else if( line.find( "error: in \"main/single_thread\": failure of thread 0 " ) != std::string::npos )
+            ;
+        else if( line.find( "warning: in \"main/" ) != std::string::npos || line.find( "Running 2 test cases" ) == 0U )
+            ;
+        else if( line.find( "Failure occurred in a following context:" ) != std::string::npos ) {
+            std::getline( lines, line );
+            BOOST_TEST( line.find( "    thread " ) == 0U );
+            ++contexts;
+        }
+        else
+            BOOST_ERROR( "unexpected log line: " << line );
+    }
+
+    BOOST_TEST( errors == threads_count );
+    BOOST_TEST( contexts == threads_count + 1 );
+}
+
+//____________________________________________________________________________//
+
+static std::atomic<unsigned> concurrent_started( 0 );
+
+// Waits until both concurrent test cases are executed
+static void
+wait_concurrent()
+{
+    ++concurrent_started;
+
+    for( int i = 0; i < 5000 && concurrent_started < 2; ++i )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+}
+
+void
+concurrent_with_thread()
+{
+    wait_concurrent();
+
+    std::thread( []{ BOOST_ERROR( "failure of the first test case" ); } ).join();
+
+    BOOST_TEST( concurrent_started == 2U );
+}
+
+void
+concurrent_without_thread()
+{
+    wait_concurrent();
+
+    BOOST_TEST( concurrent_started == 2U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_assertions_from_concurrent_test_cases )
+{
+    config_guard G;
+
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "concurrent" );
+    ut::test_case* tc_with    = BOOST_TEST_CASE( concurrent_with_thread );
+    ut::test_case* tc_without = BOOST_TEST_CASE( concurrent_without_thread );
+    ts_main->add( tc_with );
+    ts_main->add( tc_without );
+    setup_test_tree( *ts_main );
+
+    G.set<unsigned>( ut::runtime_config::btrt_parallel, 2U );
+
+    std::string log = run_logged( ts_main->p_id );
+
+    // the test case which started the thread is unknown, but its assertions are reported with one of the test cases
+    ut::test_results const& tr = ut::results_collector.results( ts_main->p_id );
+    BOOST_TEST( tr.p_assertions_failed == 1U );
+    BOOST_TEST( tr.p_assertions_passed == 2U );
+    BOOST_TEST( tr.p_test_cases_failed == 1U );
+    BOOST_TEST( log.find( "failure of the first test case" ) != std::string::npos );
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_assertions_from_threads )
+{
+    BOOST_TEST_MESSAGE( "skipped: threads are not supported in this configuration" );
+}
+
+#endif
+
+// EOF
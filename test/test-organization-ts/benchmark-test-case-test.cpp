@@ -0,0 +1,155 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the measurement of the benchmark test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE benchmark test case test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/tree/observer.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <string>
+
+//____________________________________________________________________________//
+
+static ut::counter_t body_calls = 0;
+
+void measured_body()
+{
+    ++body_calls;
+    BOOST_TEST( body_calls > 0U );
+}
+
+//____________________________________________________________________________//
+
+void failing_body()
+{
+    ++body_calls;
+    BOOST_TEST( body_calls == 0U );
+}
+
+//____________________________________________________________________________//
+
+struct benchmark_collector : ut::test_observer {
+    benchmark_collector() : m_reports( 0 ) {}
+
+    virtual void benchmark_result( ut::test_case const&, ut::benchmark_data const& bd )
+    {
+        ++m_reports;
+        m_data = bd;
+    }
+
+    unsigned            m_reports;
+    ut::benchmark_data  m_data;
+};
+
+//____________________________________________________________________________//
+
+static std::string
+run_benchmark( ut::test_case* tc, std::string const& filter, benchmark_collector& collector )
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    config_guard G;
+
+    G.set<double>( ut::runtime_config::btrt_benchmark_min_time, 0.05 );
+    G.set<std::string>( ut::runtime_config::btrt_benchmark_filter, filter );
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    body_calls = 0;
+    ut::framework::register_observer( collector );
+    std::string log = run_logged( ts_main->p_id );
+    ut::framework::deregister_observer( collector );
+
+    return log;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_measured_benchmark )
+{
+    benchmark_collector collector;
+
+    ut::test_case* tc = BOOST_BENCHMARK_CASE( measured_body );
+    std::string log = run_benchmark( tc, "main/measured_*", collector );
+
+    BOOST_TEST( collector.m_reports == 1U );
+
+    ut::benchmark_data const& bd = collector.m_data;
+    BOOST_TEST( bd.m_iterations > 1U );
+    BOOST_TEST( bd.m_samples > 1U );
+    BOOST_TEST( bd.m_iterations <= body_calls ); // the calibration runs are not part of the measurement
+    BOOST_TEST( bd.m_mean > 0. );
+    BOOST_TEST( bd.m_median > 0. );
+    BOOST_TEST( bd.m_p99 >= bd.m_median );
+    BOOST_TEST( bd.m_rate > 0. );
+
+    // each measured iteration counts its assertions
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == body_calls );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).passed() );
+
+    BOOST_TEST( log.find( "info: benchmark \"main/measured_body\": " ) != std::string::npos );
+    BOOST_TEST( log.find( " iterations/s" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_benchmark_not_selected )
+{
+    benchmark_collector collector;
+
+    ut::test_case* tc = BOOST_BENCHMARK_CASE( measured_body );
+    std::string log = run_benchmark( tc, "other/*,main/failing_body", collector );
+
+    // the benchmarks not selected by the filter are executed once, like the other test cases
+    BOOST_TEST( body_calls == 1U );
+    BOOST_TEST( collector.m_reports == 0U );
+    BOOST_TEST( log.find( "benchmark \"" ) == std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_failing_benchmark )
+{
+    benchmark_collector collector;
+
+    ut::test_case* tc = BOOST_BENCHMARK_CASE( failing_body );
+    std::string log = run_benchmark( tc, "*", collector );
+
+    // the failures are reported, but the measurements are still reported
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_failed == body_calls );
+    BOOST_TEST( !ut::results_collector.results( tc->p_id ).passed() );
+    BOOST_TEST( collector.m_reports == 1U );
+}
+
+//____________________________________________________________________________//
+
+struct benchmark_fixture {
+    benchmark_fixture() : m_value( 1 ) {}
+
+    int m_value;
+};
+
+// executed once after the test cases above, which leave an empty benchmark filter
+BOOST_FIXTURE_BENCHMARK_TEST_CASE( registered_benchmark, benchmark_fixture )
+{
+    BOOST_TEST( m_value == 1 );
+}
+
+// EOF
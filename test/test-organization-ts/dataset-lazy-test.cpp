@@ -0,0 +1,178 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the data test cases generating their test cases on demand
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE dataset lazy test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/tree/test_case_counter.hpp>
+
+namespace ut = boost::unit_test;
+namespace data = boost::unit_test::data;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <algorithm>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+static std::mutex       executed_mutex;
+static std::vector<int> executed;
+
+BOOST_AUTO_TEST_SUITE( samples, * ut::disabled() )
+
+BOOST_TEST_DECORATOR( * ut::lazy_samples() )
+BOOST_DATA_TEST_CASE( lazy, data::xrange( 1000 ), value )
+{
+    {
+        std::lock_guard<std::mutex> lock( executed_mutex );
+        executed.push_back( value );
+    }
+
+    BOOST_TEST( value != 7 );
+}
+
+BOOST_DATA_TEST_CASE( eager, data::xrange( 3 ), value )
+{
+    BOOST_TEST( value < 3 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//____________________________________________________________________________//
+
+static ut::test_suite&
+samples_suite()
+{
+    return ut::framework::get<ut::test_suite>( ut::framework::master_test_suite().get( "samples" ) );
+}
+
+static ut::test_suite&
+lazy_suite()
+{
+    return ut::framework::get<ut::test_suite>( samples_suite().get( "lazy" ) );
+}
+
+// Executes the data test cases selected by the filters, relative to their parent test suite
+static std::vector<int>
+run_samples( std::vector<std::string> const& filters )
+{
+    config_guard G;
+
+    G.set<std::vector<std::string> >( ut::runtime_config::btrt_run_filters, filters );
+
+    executed.clear();
+
+    run_logged( samples_suite().p_id );
+
+    std::sort( executed.begin(), executed.end() );
+
+    return executed;
+}
+
+static std::vector<int>
+run_samples( std::string const& filter )
+{
+    return run_samples( std::vector<std::string>( 1, filter ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_registration )
+{
+    // the samples of a lazy data test case are not registered
+    BOOST_TEST( lazy_suite().is_lazy() );
+    BOOST_TEST( lazy_suite().size() == 0U );
+
+    ut::test_suite const& eager = ut::framework::get<ut::test_suite>( samples_suite().get( "eager" ) );
+    BOOST_TEST( !eager.is_lazy() );
+    BOOST_TEST( eager.size() == 3U );
+    BOOST_TEST( eager.get( "_2" ) != ut::INV_TEST_UNIT_ID );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_all_samples )
+{
+    std::vector<int> res = run_samples( "lazy" );
+
+    BOOST_TEST( res.size() == 1000U );
+    BOOST_TEST( res.front() == 0 );
+    BOOST_TEST( res.back() == 999 );
+
+    ut::test_results const& tr = ut::results_collector.results( lazy_suite().p_id );
+    BOOST_TEST( tr.p_test_cases_passed == 999U );
+    BOOST_TEST( tr.p_test_cases_failed == 1U );
+
+    // only the failed sample is kept for the reports
+    BOOST_TEST( lazy_suite().size() == 1U );
+    ut::test_unit_id failed_id = lazy_suite().get( "_7" );
+    BOOST_TEST_REQUIRE( failed_id != ut::INV_TEST_UNIT_ID );
+    BOOST_TEST( !ut::results_collector.results( failed_id ).passed() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_sample_filters )
+{
+    std::vector<int> res = run_samples( "lazy/_3,_99" );
+
+    int const expected[] = { 3, 99 };
+    BOOST_TEST( res == std::vector<int>( expected, expected + 2 ), boost::test_tools::per_element() );
+
+    // the samples released by the previous run are not counted
+    ut::test_case_counter tcc;
+    ut::traverse_test_tree( samples_suite(), tcc );
+    BOOST_TEST( tcc.p_count == 2U );
+
+    std::vector<std::string> filters;
+    filters.push_back( "lazy/_5*" );
+    filters.push_back( "!lazy/_5" );
+    res = run_samples( filters );
+
+    // _50 to _59 and _500 to _599
+    BOOST_TEST( res.size() == 110U );
+    BOOST_TEST( std::count( res.begin(), res.end(), 5 ) == 0 );
+
+    // the test cases of a disabled sample are not generated
+    filters.clear();
+    filters.push_back( "lazy" );
+    filters.push_back( "!lazy/*0" );
+    BOOST_TEST( run_samples( filters ).size() == 900U );
+}
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+
+BOOST_AUTO_TEST_CASE( test_parallel_samples )
+{
+    config_guard G;
+    G.set<unsigned>( ut::runtime_config::btrt_parallel, 4U );
+
+    std::vector<int> res = run_samples( "lazy" );
+
+    BOOST_TEST( res.size() == 1000U );
+    BOOST_TEST( (std::adjacent_find( res.begin(), res.end() ) == res.end()) );
+    BOOST_TEST( ut::results_collector.results( lazy_suite().p_id ).p_test_cases_failed == 1U );
+}
+
+#endif
+
+// EOF
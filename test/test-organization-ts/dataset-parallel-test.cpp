@@ -0,0 +1,182 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the data test cases executing their samples concurrently
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE dataset parallel test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/data/test_case.hpp>
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+
+namespace ut = boost::unit_test;
+namespace data = boost::unit_test::data;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+//____________________________________________________________________________//
+
+static std::mutex                   executed_mutex;
+static std::vector<int>             executed;
+static std::set<std::thread::id>    threads;
+
+static void
+record_sample( int value )
+{
+    // leave some time to the other threads to take the next samples
+    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+    std::lock_guard<std::mutex> lock( executed_mutex );
+    executed.push_back( value );
+    threads.insert( std::this_thread::get_id() );
+}
+
+BOOST_AUTO_TEST_SUITE( samples, * ut::disabled() )
+
+BOOST_TEST_DECORATOR( * ut::data_parallel( 4 ) )
+BOOST_DATA_TEST_CASE( eager, data::xrange( 100 ), value )
+{
+    record_sample( value );
+
+    BOOST_TEST( value != 7 );
+}
+
+BOOST_TEST_DECORATOR( * ut::lazy_samples() * ut::data_parallel( 4 ) )
+BOOST_DATA_TEST_CASE( lazy, data::xrange( 100 ), value )
+{
+    record_sample( value );
+
+    BOOST_TEST( value != 42 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+//____________________________________________________________________________//
+
+static ut::test_suite&
+samples_suite()
+{
+    return ut::framework::get<ut::test_suite>( ut::framework::master_test_suite().get( "samples" ) );
+}
+
+static ut::test_suite&
+data_suite( ut::const_string name )
+{
+    return ut::framework::get<ut::test_suite>( samples_suite().get( name ) );
+}
+
+// Executes the data test case, and gives the values of the samples executed and its log
+static std::vector<int>
+run_samples( std::string const& filter, std::string& log )
+{
+    config_guard G;
+
+    G.set<std::vector<std::string> >( ut::runtime_config::btrt_run_filters, std::vector<std::string>( 1, filter ) );
+
+    executed.clear();
+    threads.clear();
+
+    log = run_logged( samples_suite().p_id );
+
+    std::sort( executed.begin(), executed.end() );
+
+    return executed;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_decorator )
+{
+    BOOST_TEST( data_suite( "eager" ).p_data_parallel == 4U );
+    BOOST_TEST( data_suite( "lazy" ).p_data_parallel == 4U );
+    BOOST_TEST( samples_suite().p_data_parallel == 0U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_eager_samples )
+{
+    std::string log;
+    std::vector<int> res = run_samples( "eager", log );
+
+    // each sample is executed once
+    BOOST_TEST( res.size() == 100U );
+    BOOST_TEST( (std::adjacent_find( res.begin(), res.end() ) == res.end()) );
+
+    ut::test_results const& tr = ut::results_collector.results( data_suite( "eager" ).p_id );
+    BOOST_TEST( tr.p_test_cases_passed == 99U );
+    BOOST_TEST( tr.p_test_cases_failed == 1U );
+    BOOST_TEST( tr.p_assertions_failed == 1U );
+    BOOST_TEST( !ut::results_collector.results( data_suite( "eager" ).get( "_7" ) ).passed() );
+
+    // the failure is reported with the sample
+    BOOST_TEST( log.find( "value = 7" ) != std::string::npos );
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    BOOST_TEST( threads.size() > 1U );
+    BOOST_TEST( threads.size() <= 4U );
+#endif
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_lazy_samples )
+{
+    std::string log;
+    std::vector<int> res = run_samples( "lazy", log );
+
+    BOOST_TEST( res.size() == 100U );
+    BOOST_TEST( (std::adjacent_find( res.begin(), res.end() ) == res.end()) );
+
+    ut::test_results const& tr = ut::results_collector.results( data_suite( "lazy" ).p_id );
+    BOOST_TEST( tr.p_test_cases_passed == 99U );
+    BOOST_TEST( tr.p_test_cases_failed == 1U );
+
+    // only the failed sample is kept for the reports
+    BOOST_TEST( data_suite( "lazy" ).size() == 1U );
+    BOOST_TEST( data_suite( "lazy" ).get( "_42" ) != ut::INV_TEST_UNIT_ID );
+    BOOST_TEST( log.find( "value = 42" ) != std::string::npos );
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+    BOOST_TEST( threads.size() > 1U );
+#endif
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_measured_samples )
+{
+    config_guard G;
+
+    // the memory usage of the process can't be sampled for each test case of several threads
+    G.set<bool>( ut::runtime_config::btrt_memory_usage, true );
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    std::string log;
+    std::vector<int> res = run_samples( "eager", log );
+
+    BOOST_TEST( res.size() == 100U );
+    BOOST_TEST( threads.size() == 1U );
+    BOOST_TEST( log.find( "are executed serially" ) != std::string::npos );
+    BOOST_TEST( log.find( "value = 7" ) != std::string::npos );
+}
+
+// EOF
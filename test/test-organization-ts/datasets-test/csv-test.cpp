@@ -0,0 +1,131 @@
+//  (C) Copyright Gennadiy Rozental 2011-2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the dataset of the rows of a delimited file
+// ***************************************************************************
+
+// Boost.Test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/monomorphic/generators/csv.hpp>
+#include <boost/test/data/monomorphic/generators/xrange.hpp>
+#include <boost/test/data/monomorphic/grid.hpp>
+#include <boost/test/data/for_each_sample.hpp>
+
+namespace data = boost::unit_test::data;
+
+#include "datasets-test.hpp"
+
+// STL
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+//____________________________________________________________________________//
+
+struct csv_file {
+  csv_file( std::string const& content )
+  : name( "csv-test.csv" )
+  {
+    std::ofstream out( name.c_str(), std::ios::binary );
+    out << content;
+  }
+  ~csv_file()
+  {
+    std::remove( name.c_str() );
+    std::remove( (name + ".idx").c_str() );
+  }
+
+  std::string name;
+};
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_csv_typed_columns )
+{
+  csv_file f( "name,count,price,flag\n"
+              "apple, 3 ,1.25,true\r\n"
+              "\"pear, green\",-7,2e3,0\n" );
+
+  auto ds = data::csv<std::string, int, double, bool>( f.name, data::header = true );
+  BOOST_TEST( ds.size() == 2 );
+  BOOST_TEST( (int)decltype(ds)::arity == 4 );
+
+  int count = 0;
+  data::for_each_sample( ds, [&count]( std::string const&, int, double, bool ) { ++count; } );
+  BOOST_TEST( count == 2 );
+
+  auto row = ds.sample_at( 1 );
+  BOOST_TEST( std::get<0>( row ) == "pear, green" );
+  BOOST_TEST( std::get<1>( row ) == -7 );
+  BOOST_TEST( std::get<2>( row ) == 2000. );
+  BOOST_TEST( !std::get<3>( row ) );
+
+  row = ds.sample_at( 0 );
+  BOOST_TEST( std::get<0>( row ) == "apple" );
+  BOOST_TEST( std::get<1>( row ) == 3 );
+  BOOST_TEST( std::get<2>( row ) == 1.25 );
+  BOOST_TEST( std::get<3>( row ) );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_csv_slices )
+{
+  csv_file f( "a\t\"say \"\"hi\"\"\"\n\tb\n" );
+
+  auto ds = data::csv<boost::unit_test::const_string, boost::unit_test::const_string>( f.name, data::delimiter = '\t' );
+  BOOST_TEST( ds.size() == 2 );
+
+  // the fields refer to the file, the doubled quotes are kept
+  BOOST_TEST( std::get<1>( ds.sample_at( 0 ) ) == "say \"\"hi\"\"" );
+  BOOST_TEST( std::get<0>( ds.sample_at( 1 ) ).is_empty() );
+  BOOST_TEST( std::get<1>( ds.sample_at( 1 ) ) == "b" );
+
+  auto unquoted = data::csv<char, std::string>( f.name, data::delimiter = '\t' );
+  BOOST_TEST( std::get<0>( unquoted.sample_at( 0 ) ) == 'a' );
+  BOOST_TEST( std::get<1>( unquoted.sample_at( 0 ) ) == "say \"hi\"" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_csv_invalid_rows )
+{
+  csv_file f( "1,2\n"
+              "3\n"
+              "4,5,6\n"
+              "x,7\n"
+              "300,8\n"
+              "\"9\"x,10\n" );
+
+  auto ds = data::csv<int, unsigned char>( f.name );
+  BOOST_TEST( ds.size() == 6 );
+
+  // the rows are parsed when their samples are accessed
+  BOOST_TEST( std::get<1>( ds.sample_at( 0 ) ) == 2 );
+  BOOST_CHECK_THROW( ds.sample_at( 1 ), std::logic_error );
+  BOOST_CHECK_THROW( ds.sample_at( 2 ), std::logic_error );
+  BOOST_CHECK_THROW( ds.sample_at( 3 ), std::logic_error );
+  BOOST_TEST( std::get<0>( ds.sample_at( 4 ) ) == 300 );
+  BOOST_CHECK_THROW( (data::csv<signed char, int>( f.name ).sample_at( 4 )), std::logic_error );
+  BOOST_CHECK_THROW( ds.sample_at( 5 ), std::logic_error );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_csv_composition )
+{
+  csv_file f( "1,one\n2,two\n" );
+
+  auto ds = data::csv<int, std::string>( f.name ) * data::xrange( 3 );
+  BOOST_TEST( ds.size() == 6 );
+  BOOST_TEST( (int)decltype(ds)::arity == 3 );
+  BOOST_TEST( std::get<1>( ds.sample_at( 4 ) ) == "two" );
+  BOOST_TEST( std::get<2>( ds.sample_at( 4 ) ) == 1 );
+}
+
+// EOF
@@ -0,0 +1,183 @@
+//  (C) Copyright Gennadiy Rozental 2011-2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the dataset of the records of a file
+// ***************************************************************************
+
+// Boost.Test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/monomorphic/file_records.hpp>
+#include <boost/test/data/monomorphic/generators/xrange.hpp>
+#include <boost/test/data/monomorphic/zip.hpp>
+#include <boost/test/data/for_each_sample.hpp>
+
+namespace data = boost::unit_test::data;
+
+#include "datasets-test.hpp"
+
+// STL
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+struct records_file {
+  records_file( std::string const& content )
+  : name( "file_records-test.dat" )
+  {
+    write( content );
+  }
+  ~records_file()
+  {
+    std::remove( name.c_str() );
+    std::remove( (name + ".idx").c_str() );
+  }
+
+  void write( std::string const& content )
+  {
+    std::ofstream out( name.c_str(), std::ios::binary );
+    out << content;
+  }
+
+  std::string name;
+};
+
+//____________________________________________________________________________//
+
+template<typename DataSet>
+std::vector<std::string>
+records( DataSet const& ds )
+{
+  std::vector<std::string> res;
+
+  data::for_each_sample( ds, [&res]( boost::unit_test::const_string s ) { res.push_back( std::string( s.begin(), s.end() ) ); } );
+
+  return res;
+}
+
+#define BOOST_TEST_RECORDS( ds, expected ) \
+  BOOST_TEST( records( ds ) == std::vector<std::string>( expected, expected + sizeof(expected)/sizeof(expected[0]) ), \
+              boost::test_tools::per_element() )
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_lines )
+{
+  records_file f( "first\n\nthird\nlast" );
+
+  auto ds = data::file_records( f.name );
+  BOOST_TEST( ds.size() == 4 );
+
+  char const* expected[] = { "first", "", "third", "last" };
+  BOOST_TEST_RECORDS( ds, expected );
+
+  BOOST_TEST( ds.sample_at( 2 ) == "third" );
+  BOOST_TEST( data::monomorphic::has_sample_at<decltype(ds)>::value );
+
+  // the last line may be terminated or not
+  f.write( "first\nsecond\n" );
+  BOOST_TEST( data::file_records( f.name, data::index_file = "" ).size() == 2 );
+
+  f.write( "" );
+  BOOST_TEST( data::file_records( f.name, data::index_file = "" ).size() == 0 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_delimiter )
+{
+  records_file f( "a;bc;;d;" );
+
+  char const* expected[] = { "a", "bc", "", "d" };
+  BOOST_TEST_RECORDS( data::file_records( f.name, data::delimiter = ';' ), expected );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_fixed_size )
+{
+  records_file f( "abcdefghijkl" );
+
+  char const* expected[] = { "abcd", "efgh", "ijkl" };
+  BOOST_TEST_RECORDS( data::file_records( f.name, data::record_size = 4 ), expected );
+
+  BOOST_CHECK_THROW( data::file_records( f.name, data::record_size = 5 ), std::logic_error );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_length_prefix )
+{
+  std::string content;
+  content += std::string( "\x03\x00", 2 ) + "abc";
+  content += std::string( "\x00\x00", 2 );
+  content += std::string( "\x01\x00", 2 ) + "z";
+  records_file f( content );
+
+  char const* expected[] = { "abc", "", "z" };
+  BOOST_TEST_RECORDS( data::file_records( f.name, data::length_prefix = 2 ), expected );
+
+  // the records of the file are not recognized with another size of the length
+  BOOST_CHECK_THROW( data::file_records( f.name, data::length_prefix = 4 ), std::logic_error );
+  BOOST_CHECK_THROW( data::file_records( f.name, data::length_prefix = 3 ), std::logic_error );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_index_file )
+{
+  records_file f( "one\ntwo\nthree\n" );
+
+  std::size_t const count = data::file_records( f.name ).size().value();
+  BOOST_TEST( count == 3U );
+  BOOST_TEST( std::ifstream( (f.name + ".idx").c_str() ).good() );
+
+  // the saved index is used by the next datasets
+  char const* expected[] = { "one", "two", "three" };
+  BOOST_TEST_RECORDS( data::file_records( f.name ), expected );
+
+  // the index of another format is not used
+  char const* words[] = { "one\ntwo\nth", "ee\n" };
+  BOOST_TEST_RECORDS( data::file_records( f.name, data::delimiter = 'r' ), words );
+
+  // nor the index of a former content of the file
+  f.write( "four\nfive\n" );
+  char const* changed[] = { "four", "five" };
+  BOOST_TEST_RECORDS( data::file_records( f.name ), changed );
+
+  // nor an index giving records outside of the file
+  {
+    std::fstream idx( (f.name + ".idx").c_str(), std::ios::binary | std::ios::in | std::ios::out );
+    idx.seekp( -8, std::ios::end );
+    idx.write( "\xff\xff\xff\xff\x00\x00\x00\x00", 8 );
+  }
+  BOOST_TEST_RECORDS( data::file_records( f.name ), changed );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_errors )
+{
+  BOOST_CHECK_THROW( data::file_records( "file_records-test.missing" ), std::logic_error );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_composition )
+{
+  records_file f( "a\nb\nc\n" );
+
+  auto ds = data::file_records( f.name ) ^ data::xrange( 3 );
+  BOOST_TEST( ds.size() == 3 );
+  BOOST_TEST( std::get<0>( ds.sample_at( 1 ) ) == "b" );
+  BOOST_TEST( std::get<1>( ds.sample_at( 1 ) ) == 1 );
+}
+
+// EOF
@@ -0,0 +1,110 @@
+//  (C) Copyright Gennadiy Rozental 2011-2015.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the direct access to the samples of the datasets
+// ***************************************************************************
+
+// Boost.Test
+#include <boost/test/unit_test.hpp>
+#include <boost/test/data/monomorphic.hpp>
+#include <boost/test/data/test_case.hpp>
+
+namespace data = boost::unit_test::data;
+namespace mono = boost::unit_test::data::monomorphic;
+
+#include "datasets-test.hpp"
+
+//____________________________________________________________________________//
+
+// the samples are the same as the ones given by the iteration
+template<typename DataSet>
+void
+check_sample_at( DataSet const& ds )
+{
+  BOOST_TEST_REQUIRE( mono::has_sample_at<DataSet>::value );
+
+  auto it = ds.begin();
+  for( std::size_t i = 0; i < ds.size().value(); ++i, ++it ) {
+    BOOST_CHECK( *it == ds.sample_at( i ) );
+  }
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_sample_at_base_datasets )
+{
+  int arr[] = {7, 11, 13};
+  std::vector<int> vec = {3, 5, 8, 13};
+
+  check_sample_at( data::make( 5 ) );
+  check_sample_at( data::make( arr ) );
+  check_sample_at( data::make( vec ) );
+  check_sample_at( data::make( {1.5, 2.5} ) );
+  check_sample_at( data::xrange( 10 ) );
+  check_sample_at( data::xrange( -5, 20, 3 ) );
+
+  BOOST_TEST( data::make( arr ).sample_at( 2 ) == 13 );
+  BOOST_TEST( data::xrange( 1, 100, 7 ).sample_at( 3 ) == 22 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_sample_at_unsupported )
+{
+  // only the datasets which would not compute the same samples through the iteration
+  BOOST_TEST( !mono::has_sample_at<decltype(data::make( std::list<int>( 3 ) ))>::value );
+  BOOST_TEST( !mono::has_sample_at<decltype(data::xrange( 0., 1., 0.1 ))>::value );
+  BOOST_TEST( !mono::has_sample_at<decltype(data::random( 1, 5 ) ^ data::xrange( 5 ))>::value );
+  BOOST_TEST( !mono::has_sample_at<decltype(data::make( std::list<int>( 3 ) ) * data::xrange( 5 ))>::value );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_sample_at_composite_datasets )
+{
+  int arr[] = {7, 11, 13};
+  std::vector<std::string> vec = {"a", "b"};
+
+  check_sample_at( data::make( arr ) * data::make( vec ) );
+  check_sample_at( data::make( arr ) * data::xrange( 4 ) * data::make( vec ) );
+  check_sample_at( data::make( arr ) ^ data::xrange( 3 ) );
+  check_sample_at( data::make( 1 ) ^ data::xrange( 3 ) );
+  check_sample_at( data::make( arr ) + data::xrange( 4 ) );
+  check_sample_at( (data::make( arr ) ^ data::xrange( 3 )) * data::make( vec ) );
+
+  auto ds = data::xrange( 100 ) * data::xrange( 10 );
+  BOOST_TEST( std::get<0>( ds.sample_at( 537 ) ) == 53 );
+  BOOST_TEST( std::get<1>( ds.sample_at( 537 ) ) == 7 );
+}
+
+//____________________________________________________________________________//
+
+struct sample_test {
+  template<typename T>
+  static void test_method( T const& ) {}
+};
+
+BOOST_AUTO_TEST_CASE( test_sample_names_lookup )
+{
+  auto gen = data::ds_detail::make_test_case_gen<sample_test>( "gen", __FILE__, __LINE__, data::xrange( 1000 ) );
+  boost::shared_ptr<boost::unit_test::test_case_source> source = gen.source();
+
+  BOOST_TEST( source->find( "_0" ) == 0U );
+  BOOST_TEST( source->find( "_537" ) == 537U );
+  BOOST_TEST( source->find( "_999" ) == 999U );
+
+  // names which are not generated by the data test case
+  BOOST_TEST( source->find( "_1000" ) == 1000U );
+  BOOST_TEST( source->find( "_05" ) == 1000U );
+  BOOST_TEST( source->find( "_" ) == 1000U );
+  BOOST_TEST( source->find( "_1a" ) == 1000U );
+  BOOST_TEST( source->find( "537" ) == 1000U );
+  BOOST_TEST( source->find( "_99999999999999999999999" ) == 1000U );
+}
+
+// EOF
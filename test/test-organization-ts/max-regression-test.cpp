@@ -0,0 +1,209 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the max_regression decorator against a saved performance baseline
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE max regression test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+//____________________________________________________________________________//
+
+static unsigned body_calls  = 0;
+static unsigned body_us     = 0;
+
+void timed_body()
+{
+    ++body_calls;
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::microseconds( body_us );
+    while( std::chrono::steady_clock::now() < end )
+        ;
+}
+
+//____________________________________________________________________________//
+
+static unsigned failing_call = 0;
+
+void checking_body()
+{
+    ++body_calls;
+
+    BOOST_TEST_MESSAGE( "execution " << body_calls );
+    BOOST_TEST( body_calls != failing_call );
+}
+
+//____________________________________________________________________________//
+
+static char const* const baseline_file = "max-regression-test.baseline";
+
+struct baseline_guard {
+    ~baseline_guard()
+    {
+        std::remove( baseline_file );
+    }
+};
+
+//____________________________________________________________________________//
+
+static std::string
+run_checked( ut::test_case* tc, unsigned duration_us, bool save )
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    config_guard G;
+
+    G.set<bool>( ut::runtime_config::btrt_save_test_pattern, save );
+    G.set<std::string>( ut::runtime_config::btrt_regression_baseline, baseline_file );
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    body_calls = 0;
+    body_us    = duration_us;
+
+    return run_logged( ts_main->p_id );
+}
+
+//____________________________________________________________________________//
+
+static ut::test_case*
+make_checked_case( ut::test_case* tc = BOOST_TEST_CASE( timed_body ) )
+{
+    tc->p_max_regression.value      = 0.5;
+    tc->p_regression_repeats.value  = 3;
+
+    return tc;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_baseline_saved_and_checked )
+{
+    baseline_guard G;
+
+    // the baseline is saved
+    ut::test_case* tc = make_checked_case();
+    std::string log = run_checked( tc, 5000, true );
+
+    BOOST_TEST( body_calls == 3U );
+    BOOST_TEST( log.find( "performance check" ) == std::string::npos );
+
+    std::ifstream in( baseline_file );
+    std::string line;
+    BOOST_TEST_REQUIRE( !!std::getline( in, line ) );
+
+    double baseline = 0;
+    std::istringstream( line ) >> baseline;
+    BOOST_TEST( baseline >= 5e6 );
+    BOOST_TEST( line.find( " main/timed_body" ) != std::string::npos );
+
+    // the same duration is within the maximal regression
+    tc = make_checked_case();
+    log = run_checked( tc, 5000, false );
+
+    BOOST_TEST( body_calls == 3U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == 1U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).passed() );
+
+    // three times the duration is not
+    tc = make_checked_case();
+    log = run_checked( tc, 15000, false );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_failed == 1U );
+    BOOST_TEST( log.find( "error: in \"main/timed_body\": performance check has failed: median duration " ) != std::string::npos );
+    BOOST_TEST( log.find( "% above the baseline " ) != std::string::npos );
+    BOOST_TEST( log.find( "[maximum 50%]" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_missing_baseline )
+{
+    baseline_guard G;
+
+    ut::test_case* tc = make_checked_case();
+    std::string log = run_checked( tc, 0, false );
+
+    BOOST_TEST( body_calls == 3U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_failed == 0U );
+    BOOST_TEST( log.find( "no performance baseline for this test case" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_repeated_executions_reported_once )
+{
+    baseline_guard G;
+
+    // the assertions and the log entries of the first execution only are reported
+    ut::test_case* tc = make_checked_case( BOOST_TEST_CASE( checking_body ) );
+    failing_call = 0;
+    std::string log = run_checked( tc, 0, false );
+
+    BOOST_TEST( body_calls == 3U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == 1U );
+    BOOST_TEST( log.find( "execution 1" ) != std::string::npos );
+    BOOST_TEST( log.find( "execution 2" ) == std::string::npos );
+    BOOST_TEST( log.find( "execution 3" ) == std::string::npos );
+
+    // unless one of the next executions fails, which stops the repetition
+    tc = make_checked_case( BOOST_TEST_CASE( checking_body ) );
+    failing_call = 2;
+    log = run_checked( tc, 0, false );
+    failing_call = 0;
+
+    BOOST_TEST( body_calls == 2U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == 1U );
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_failed == 1U );
+    BOOST_TEST( log.find( "execution 2" ) != std::string::npos );
+    BOOST_TEST( log.find( "error: in \"main/checking_body\": check body_calls != failing_call has failed" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_without_baseline_file )
+{
+    // the test case is executed once when no baseline file is given
+    ut::test_case* tc = make_checked_case();
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    body_calls = 0;
+    run_logged( ts_main->p_id );
+
+    BOOST_TEST( body_calls == 1U );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_decorator, * ut::max_regression( 0.1, 5 ) )
+{
+    ut::test_case const& tc = ut::framework::current_test_case();
+
+    BOOST_TEST( tc.p_max_regression == 0.1 );
+    BOOST_TEST( tc.p_regression_repeats == 5U );
+}
+
+// EOF
@@ -0,0 +1,144 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief measures registration, traversal and execution of large test trees
+///
+/// The test trees of 10k and 100k test units are always measured. The tree of 1M test units is only
+/// measured if the test module is given the argument "large", as in `test_tree-scaling-test -- large`.
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test tree scaling test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/tree/traverse.hpp>
+#include <boost/test/tree/test_case_counter.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// Boost
+#include <boost/timer.hpp>
+
+// STL
+#include <cstring>
+#include <vector>
+
+//____________________________________________________________________________//
+
+void some_test()
+{
+    BOOST_TEST( true );
+}
+
+//____________________________________________________________________________//
+
+struct parent_checker : ut::test_tree_visitor {
+    parent_checker() : m_count( 0 ), m_mismatches( 0 ) {}
+
+    virtual void    visit( ut::test_case const& tc )
+    {
+        ++m_count;
+
+        // lookup of the parent test suite by id
+        if( ut::framework::get<ut::test_suite>( tc.p_parent_id ).p_id != tc.p_parent_id )
+            ++m_mismatches;
+    }
+
+    std::size_t m_count;
+    std::size_t m_mismatches;
+};
+
+//____________________________________________________________________________//
+
+static void
+measure( std::size_t size )
+{
+    std::size_t const tcs_per_suite = 100;
+
+    // 10. Registration
+    boost::timer t;
+
+    ut::test_suite* master = BOOST_TEST_SUITE( "master_" + ut::utils::string_cast( size ) );
+    for( std::size_t s = 0; s < size / tcs_per_suite; ++s ) {
+        ut::test_suite* ts = BOOST_TEST_SUITE( "ts_" + ut::utils::string_cast( s ) );
+        master->add( ts );
+
+        for( std::size_t c = 0; c < tcs_per_suite; ++c )
+            ts->add( ut::make_test_case( boost::function<void ()>( some_test ), "tc", __FILE__, __LINE__ ) );
+    }
+
+    double registration = t.elapsed();
+
+    // 20. Setup for execution: dependencies ordering and run status deduction
+    t.restart();
+
+    setup_test_tree( *master );
+    ut::framework::impl::setup_for_execution( *master );
+
+    double setup = t.elapsed();
+
+    // 30. Traversal, including lookup of the test units by id
+    t.restart();
+
+    ut::test_case_counter tcc;
+    ut::traverse_test_tree( master->p_id, tcc );
+
+    parent_checker pc;
+    ut::traverse_test_tree( master->p_id, pc, true );
+
+    double traversal = t.elapsed();
+
+    // 40. Execution, including collection of the results
+    t.restart();
+
+    run_logged( master->p_id, true );
+
+    double execution = t.elapsed();
+
+    BOOST_TEST( tcc.p_count == size );
+    BOOST_TEST( pc.m_count == size );
+    BOOST_TEST( pc.m_mismatches == 0U );
+    BOOST_TEST( ut::results_collector.results( master->p_id ).p_test_cases_passed == size );
+
+    BOOST_TEST_MESSAGE( size << " test units: registration " << registration << "s, setup " << setup
+                             << "s, traversal " << traversal << "s, execution " << execution << "s" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_10k_test_units )
+{
+    measure( 10000 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_100k_test_units )
+{
+    measure( 100000 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_1m_test_units )
+{
+    ut::master_test_suite_t& mts = ut::framework::master_test_suite();
+
+    if( mts.argc < 2 || std::strcmp( mts.argv[1], "large" ) != 0 ) {
+        BOOST_TEST_MESSAGE( "skipped: pass the argument 'large' to measure 1M test units" );
+        return;
+    }
+
+    measure( 1000000 );
+}
+
+// EOF
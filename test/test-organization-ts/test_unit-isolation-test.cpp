@@ -0,0 +1,204 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests execution of the test cases in child processes
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit isolation test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+namespace ut = boost::unit_test;
+namespace tt = boost::test_tools;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <string>
+#include <vector>
+
+#if defined(BOOST_TEST_SUPPORT_FORK)
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+//____________________________________________________________________________//
+
+static int s_side_effects = 0;
+
+void passing_test()
+{
+    ++s_side_effects;
+    BOOST_TEST( 1 == 1 );
+    BOOST_TEST_MESSAGE( "passing" );
+}
+
+void failing_test()
+{
+    ++s_side_effects;
+    BOOST_TEST_CONTEXT( "failing context" ) {
+        BOOST_TEST( 1 == 2 );
+        BOOST_TEST( 2 == 2 );
+    }
+}
+
+void throwing_test()
+{
+    ++s_side_effects;
+    BOOST_TEST( 1 == 1 );
+    throw std::runtime_error( "thrown from test case" );
+}
+
+void requiring_test()
+{
+    ++s_side_effects;
+    BOOST_TEST_REQUIRE( 1 == 2 );
+    BOOST_TEST( 1 == 1 );
+}
+
+#if defined(BOOST_TEST_SUPPORT_FORK)
+void killed_test()
+{
+    BOOST_TEST( 1 == 1 );
+    BOOST_TEST( 1 == 2 );
+    ::kill( ::getpid(), SIGKILL );
+}
+#endif
+
+//____________________________________________________________________________//
+
+struct tu_event_collector : ut::test_observer {
+    virtual void    test_unit_start( ut::test_unit const& tu )
+    {
+        m_events.push_back( "start " + tu.p_name.get() );
+    }
+    virtual void    test_unit_finish( ut::test_unit const& tu, unsigned long )
+    {
+        m_events.push_back( "finish " + tu.p_name.get() );
+    }
+    virtual void    assertion_result( ut::assertion_result ar )
+    {
+        m_events.push_back( "assertion " + ut::utils::string_cast( static_cast<int>( ar ) ) );
+    }
+    virtual void    exception_caught( boost::execution_exception const& ex )
+    {
+        m_events.push_back( "exception " + ut::utils::string_cast( ex.what() ) );
+    }
+
+    std::vector<std::string> m_events;
+};
+
+//____________________________________________________________________________//
+
+struct run_result {
+    std::vector<std::string>    m_events;
+    std::string                 m_log;
+};
+
+static run_result
+run_tree( ut::test_suite* master, ut::isolation_mode isolation, unsigned parallel )
+{
+    config_guard G;
+
+    G.set<ut::isolation_mode>( ut::runtime_config::btrt_isolation, isolation );
+    G.set<unsigned>( ut::runtime_config::btrt_parallel, parallel );
+
+    tu_event_collector c;
+    ut::framework::register_observer( c );
+
+    setup_test_tree( *master );
+
+    // test units entries are skipped as they report the testing time
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    run_result res;
+    res.m_log = run_logged( master->p_id, true );
+
+    ut::framework::deregister_observer( c );
+
+    res.m_events = c.m_events;
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    {
+        master = BOOST_TEST_SUITE( "master" );
+
+        void (*tests[])() = { &passing_test, &failing_test, &throwing_test, &requiring_test };
+
+        for( std::size_t s = 0; s < 12; s++ ) {
+            tcs.push_back( ut::make_test_case( boost::function<void ()>( tests[s % 4] ),
+                                               "tc_" + ut::utils::string_cast( s ),
+                                               __FILE__, __LINE__ ) );
+            master->add( tcs.back() );
+        }
+    }
+
+    ut::test_suite*             master;
+    std::vector<ut::test_case*> tcs;
+};
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_TEST_SUPPORT_FORK)
+
+BOOST_FIXTURE_TEST_CASE( test_isolated_matches_sequential, test_tree )
+{
+    run_result sequential = run_tree( master, ut::ISOLATION_NONE, 1 );
+
+    s_side_effects = 0;
+    run_result isolated = run_tree( master, ut::ISOLATION_FORK, 1 );
+    BOOST_TEST( s_side_effects == 0 ); // test cases were executed by the child processes
+
+    run_result isolated_parallel = run_tree( master, ut::ISOLATION_FORK, 4 );
+
+    BOOST_TEST( sequential.m_events == isolated.m_events, tt::per_element() );
+    BOOST_TEST( sequential.m_log == isolated.m_log );
+    BOOST_TEST( sequential.m_events == isolated_parallel.m_events, tt::per_element() );
+    BOOST_TEST( sequential.m_log == isolated_parallel.m_log );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_crash_is_contained, test_tree )
+{
+    ut::test_case* killed = ut::make_test_case( boost::function<void ()>( &killed_test ), "killed", __FILE__, __LINE__ );
+    master->add( killed );
+    ut::test_case* after = ut::make_test_case( boost::function<void ()>( &passing_test ), "after", __FILE__, __LINE__ );
+    master->add( after );
+
+    run_result res = run_tree( master, ut::ISOLATION_FORK, 2 );
+
+    ut::test_results const& tr = ut::results_collector.results( killed->p_id );
+    BOOST_TEST( tr.p_assertions_passed == 1U );
+    BOOST_TEST( tr.p_assertions_failed == 2U ); // including the abnormal termination
+    BOOST_TEST( tr.p_aborted );
+
+    BOOST_TEST( res.m_log.find( "terminated by signal" ) != std::string::npos );
+
+    // the test module keeps on executing the test cases
+    BOOST_TEST( ut::results_collector.results( after->p_id ).passed() );
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_isolation_not_supported )
+{
+    BOOST_TEST_MESSAGE( "isolation of the test cases is not supported in this configuration" );
+}
+
+#endif
+
+// EOF
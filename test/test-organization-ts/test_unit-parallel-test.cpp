@@ -0,0 +1,262 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests concurrent execution of the test cases
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit parallel test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+namespace ut = boost::unit_test;
+namespace tt = boost::test_tools;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <string>
+#include <vector>
+
+#if defined(BOOST_TEST_SUPPORT_THREADS)
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+//____________________________________________________________________________//
+
+void passing_test()
+{
+    BOOST_TEST( 1 == 1 );
+    BOOST_TEST_MESSAGE( "passing" );
+}
+
+void failing_test()
+{
+    BOOST_TEST_CONTEXT( "failing context" ) {
+        BOOST_TEST( 1 == 2 );
+        BOOST_TEST( 2 == 2 );
+    }
+}
+
+void throwing_test()
+{
+    BOOST_TEST( 1 == 1 );
+    throw std::runtime_error( "thrown from test case" );
+}
+
+void requiring_test()
+{
+    BOOST_TEST_REQUIRE( 1 == 2 );
+    BOOST_TEST( 1 == 1 );
+}
+
+#if defined(BOOST_TEST_SUPPORT_THREADS)
+static std::mutex                   s_mutex;
+static std::vector<std::thread::id> s_serial_threads;
+#endif
+
+void serial_test()
+{
+#if defined(BOOST_TEST_SUPPORT_THREADS)
+    std::lock_guard<std::mutex> lock( s_mutex );
+    s_serial_threads.push_back( std::this_thread::get_id() );
+#endif
+    BOOST_TEST( 1 == 1 );
+}
+
+#if defined(BOOST_TEST_SUPPORT_THREADS)
+static std::condition_variable      s_arrival;
+static unsigned                     s_arrived = 0;
+static std::vector<std::thread::id> s_concurrent_threads;
+
+// waits for the other concurrent test case: both arrive only if they are executed at the same time
+void concurrent_test()
+{
+    std::unique_lock<std::mutex> lock( s_mutex );
+    s_concurrent_threads.push_back( std::this_thread::get_id() );
+    ++s_arrived;
+    s_arrival.notify_all();
+
+    std::chrono::steady_clock::time_point const deadline = std::chrono::steady_clock::now() + std::chrono::seconds( 10 );
+    while( s_arrived < 2 && s_arrival.wait_until( lock, deadline ) != std::cv_status::timeout )
+        ;
+
+    BOOST_TEST( s_arrived == 2U );
+}
+#endif
+
+//____________________________________________________________________________//
+
+struct tu_event_collector : ut::test_observer {
+    virtual void    test_unit_start( ut::test_unit const& tu )
+    {
+        m_events.push_back( "start " + tu.p_name.get() );
+    }
+    virtual void    test_unit_finish( ut::test_unit const& tu, unsigned long )
+    {
+        m_events.push_back( "finish " + tu.p_name.get() );
+    }
+    virtual void    assertion_result( ut::assertion_result ar )
+    {
+        m_events.push_back( "assertion " + ut::utils::string_cast( static_cast<int>( ar ) ) );
+    }
+    virtual void    exception_caught( boost::execution_exception const& ex )
+    {
+        m_events.push_back( "exception " + ut::utils::string_cast( ex.what() ) );
+    }
+
+    std::vector<std::string> m_events;
+};
+
+//____________________________________________________________________________//
+
+struct run_result {
+    std::vector<std::string>    m_events;
+    std::string                 m_log;
+    std::vector<std::string>    m_results;
+};
+
+static run_result
+run_tree( ut::test_suite* master, std::vector<ut::test_case*> const& tcs, unsigned parallel )
+{
+    config_guard G;
+
+    G.set<unsigned>( ut::runtime_config::btrt_parallel, parallel );
+
+    tu_event_collector c;
+    ut::framework::register_observer( c );
+
+    setup_test_tree( *master );
+
+    // test units entries are skipped as they report the testing time
+    ut::unit_test_log.set_threshold_level( ut::log_messages );
+
+    std::string log = run_logged( master->p_id, true );
+
+    ut::framework::deregister_observer( c );
+
+    run_result res;
+    res.m_events = c.m_events;
+    res.m_log = log;
+
+    for( std::size_t i = 0; i < tcs.size(); ++i ) {
+        ut::test_results const& tr = ut::results_collector.results( tcs[i]->p_id );
+        res.m_results.push_back( ut::utils::string_cast( tr.p_assertions_passed.get() ) + "/" +
+                                 ut::utils::string_cast( tr.p_assertions_failed.get() ) + "/" +
+                                 ut::utils::string_cast( tr.p_aborted.get() ) );
+    }
+
+    return res;
+}
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    {
+        master = BOOST_TEST_SUITE( "master" );
+
+        void (*tests[])() = { &passing_test, &failing_test, &throwing_test, &requiring_test };
+
+        for( std::size_t s = 0; s < 16; s++ ) {
+            tcs.push_back( ut::make_test_case( boost::function<void ()>( tests[s % 4] ),
+                                               "tc_" + ut::utils::string_cast( s ),
+                                               __FILE__, __LINE__ ) );
+            master->add( tcs.back(), 0, s % 5 == 0 ? 10 : 0 );
+        }
+
+        tcs.push_back( ut::make_test_case( boost::function<void ()>( &serial_test ), "serial_tc", __FILE__, __LINE__ ) );
+        tcs.back()->p_serial.value = true;
+        master->add( tcs.back() );
+
+        for( std::size_t s = 16; s < 24; s++ ) {
+            tcs.push_back( ut::make_test_case( boost::function<void ()>( tests[s % 4] ),
+                                               "tc_" + ut::utils::string_cast( s ),
+                                               __FILE__, __LINE__ ) );
+            master->add( tcs.back() );
+        }
+    }
+
+    ut::test_suite*             master;
+    std::vector<ut::test_case*> tcs;
+};
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_parallel_matches_sequential, test_tree )
+{
+    run_result sequential = run_tree( master, tcs, 1 );
+    run_result parallel = run_tree( master, tcs, 4 );
+
+    BOOST_TEST( sequential.m_events == parallel.m_events, tt::per_element() );
+    BOOST_TEST( sequential.m_results == parallel.m_results, tt::per_element() );
+    BOOST_TEST( sequential.m_log == parallel.m_log );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_parallel_is_repeatable, test_tree )
+{
+    run_result res1 = run_tree( master, tcs, 3 );
+    run_result res2 = run_tree( master, tcs, 8 );
+
+    BOOST_TEST( res1.m_events == res2.m_events, tt::per_element() );
+    BOOST_TEST( res1.m_log == res2.m_log );
+}
+
+//____________________________________________________________________________//
+
+#if defined(BOOST_TEST_SUPPORT_THREADS)
+
+BOOST_FIXTURE_TEST_CASE( test_serial_runs_in_main_thread, test_tree )
+{
+    s_serial_threads.clear();
+
+    run_tree( master, tcs, 4 );
+
+    BOOST_TEST_REQUIRE( s_serial_threads.size() == 1U );
+    BOOST_TEST( s_serial_threads[0] == std::this_thread::get_id() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_parallel_runs_in_worker_threads )
+{
+    ut::test_suite* master = BOOST_TEST_SUITE( "master" );
+    std::vector<ut::test_case*> tcs;
+
+    for( std::size_t s = 0; s < 2; s++ ) {
+        tcs.push_back( ut::make_test_case( boost::function<void ()>( &concurrent_test ),
+                                           "concurrent_tc_" + ut::utils::string_cast( s ),
+                                           __FILE__, __LINE__ ) );
+        master->add( tcs.back() );
+    }
+
+    s_arrived = 0;
+    s_concurrent_threads.clear();
+
+    run_result res = run_tree( master, tcs, 2 );
+
+    // each test case waited for the other one in its own worker thread
+    BOOST_TEST( res.m_results[0] == "1/0/0" );
+    BOOST_TEST( res.m_results[1] == "1/0/0" );
+
+    BOOST_TEST_REQUIRE( s_concurrent_threads.size() == 2U );
+    BOOST_TEST( s_concurrent_threads[0] != s_concurrent_threads[1] );
+    BOOST_TEST( s_concurrent_threads[0] != std::this_thread::get_id() );
+    BOOST_TEST( s_concurrent_threads[1] != std::this_thread::get_id() );
+}
+
+#endif
+
+// EOF
@@ -0,0 +1,184 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the execution of the test cases based on the results of the previous runs
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit rerun test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+namespace ut = boost::unit_test;
+namespace tt = boost::test_tools;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+void some_test() {}
+
+void failing_test()
+{
+    BOOST_TEST( 1 == 2 );
+}
+
+//____________________________________________________________________________//
+
+struct tc_start_collector : ut::test_observer {
+    virtual void    test_unit_start( ut::test_unit const& tu )
+    {
+        m_names.push_back( tu.p_name );
+    }
+
+    std::vector<std::string> m_names;
+};
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    : file_name( "test_unit-rerun-test.durations" )
+    {
+        master = BOOST_TEST_SUITE( "master" );
+
+        for( std::size_t s = 0; s < 2; s++ ) {
+            ut::test_suite* ts = BOOST_TEST_SUITE( "ts_" + ut::utils::string_cast( s ) );
+            master->add( ts );
+
+            for( std::size_t c = 0; c < 3; c++ ) {
+                ut::test_case* tc = ut::make_test_case( boost::function<void ()>( s * 3 + c == 4 ? failing_test : some_test ),
+                                                        "tc_" + ut::utils::string_cast( s * 3 + c ),
+                                                        __FILE__, __LINE__ );
+                ts->add( tc );
+                tcs.push_back( tc );
+            }
+        }
+
+        // the last test case depends on a test case which did not fail
+        tcs[5]->depends_on( tcs[3] );
+
+        config.set<std::string>( ut::runtime_config::btrt_durations, file_name );
+    }
+    ~test_tree()
+    {
+        std::remove( file_name.c_str() );
+    }
+
+    void write_history( bool with_failures )
+    {
+        std::ofstream out( file_name.c_str() );
+        out << "5F other/tc\n";
+
+        for( std::size_t i = 0; i < tcs.size(); i++ )
+            out << 10 << (with_failures && i >= 4 ? "F " : " ") << tcs[i]->full_name() << '\n';
+    }
+
+    std::vector<std::string> run( ut::rerun_mode rerun, bool continue_test = true )
+    {
+        config.set<ut::rerun_mode>( ut::runtime_config::btrt_rerun, rerun );
+
+        tc_start_collector c;
+        ut::framework::register_observer( c );
+
+        setup_test_tree( *master );
+        run_logged( master->p_id, continue_test );
+
+        ut::framework::deregister_observer( c );
+
+        return c.m_names;
+    }
+
+    config_guard                config;
+    std::string                 file_name;
+    ut::test_suite*             master;
+    std::vector<ut::test_case*> tcs;
+};
+
+#define BOOST_TEST_NAMES( names, expected ) \
+    BOOST_TEST( names == std::vector<std::string>( expected, expected + sizeof(expected)/sizeof(expected[0]) ), tt::per_element() )
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_rerun_failed, test_tree )
+{
+    write_history( true );
+
+    // the test case depended on is executed as well
+    char const* expected[] = { "master", "ts_1", "tc_3", "tc_4", "tc_5" };
+
+    std::vector<std::string> names = run( ut::RERUN_FAILED );
+
+    BOOST_TEST_NAMES( names, expected );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_rerun_without_failures, test_tree )
+{
+    write_history( false );
+
+    char const* expected[] = { "master",
+                               "ts_0", "tc_0", "tc_1", "tc_2",
+                               "ts_1", "tc_3", "tc_4", "tc_5" };
+
+    std::vector<std::string> names = run( ut::RERUN_FAILED );
+
+    BOOST_TEST_NAMES( names, expected );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_rerun_failed_first, test_tree )
+{
+    write_history( true );
+
+    // dependency ranks are preserved
+    char const* expected[] = { "master",
+                               "ts_1", "tc_4", "tc_3", "tc_5",
+                               "ts_0", "tc_0", "tc_1", "tc_2" };
+
+    std::vector<std::string> names = run( ut::RERUN_FAILED_FIRST );
+
+    BOOST_TEST_NAMES( names, expected );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_failures_are_saved, test_tree )
+{
+    write_history( true );
+
+    // results are saved at the end of the outermost run only
+    run( ut::RERUN_ALL, false );
+
+    std::ifstream in( file_name.c_str() );
+    std::vector<std::string> failed;
+    std::string line;
+    while( std::getline( in, line ) ) {
+        std::string::size_type sep = line.find( ' ' );
+
+        BOOST_TEST_REQUIRE( sep != std::string::npos );
+        if( line[sep - 1] == 'F' )
+            failed.push_back( line.substr( sep + 1 ) );
+    }
+
+    // the test case which passed this time is no longer failed, the results of the other test cases are kept
+    char const* expected[] = { "master/ts_1/tc_4", "other/tc" };
+
+    BOOST_TEST_NAMES( failed, expected );
+}
+
+// EOF
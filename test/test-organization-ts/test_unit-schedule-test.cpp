@@ -0,0 +1,160 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests scheduling of the test cases based on their durations
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit schedule test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+namespace ut = boost::unit_test;
+namespace tt = boost::test_tools;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+void some_test() {}
+
+//____________________________________________________________________________//
+
+struct tc_start_collector : ut::test_observer {
+    virtual void    test_unit_start( ut::test_unit const& tu )
+    {
+        m_names.push_back( tu.p_name );
+    }
+
+    std::vector<std::string> m_names;
+};
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    : file_name( "test_unit-schedule-test.durations" )
+    {
+        master = BOOST_TEST_SUITE( "master" );
+
+        for( std::size_t s = 0; s < 2; s++ ) {
+            ut::test_suite* ts = BOOST_TEST_SUITE( "ts_" + ut::utils::string_cast( s ) );
+            master->add( ts );
+
+            for( std::size_t c = 0; c < 5; c++ ) {
+                ut::test_case* tc = ut::make_test_case( boost::function<void ()>( some_test ),
+                                                        "tc_" + ut::utils::string_cast( s * 5 + c ),
+                                                        __FILE__, __LINE__ );
+                ts->add( tc );
+                tcs.push_back( tc );
+            }
+        }
+
+        std::ofstream out( file_name.c_str() );
+        out << "5 other/tc\n";
+
+        // second test suite is twice as long as the first one
+        unsigned long durations[] = { 10, 300, 20, 100, 200 };
+        for( std::size_t i = 0; i < tcs.size(); i++ )
+            out << durations[i % 5] * (i / 5 + 1) << ' ' << tcs[i]->full_name() << '\n';
+
+        // the longest test case of the first test suite has to wait for the shortest one
+        tcs[1]->depends_on( tcs[0] );
+
+        config.set<std::string>( ut::runtime_config::btrt_durations, file_name );
+    }
+    ~test_tree()
+    {
+        std::remove( file_name.c_str() );
+    }
+
+    std::vector<std::string> run( ut::schedule_order schedule, bool continue_test = true )
+    {
+        config.set<ut::schedule_order>( ut::runtime_config::btrt_schedule, schedule );
+
+        tc_start_collector c;
+        ut::framework::register_observer( c );
+
+        setup_test_tree( *master );
+        run_logged( master->p_id, continue_test );
+
+        ut::framework::deregister_observer( c );
+
+        return c.m_names;
+    }
+
+    config_guard                config;
+    std::string                 file_name;
+    ut::test_suite*             master;
+    std::vector<ut::test_case*> tcs;
+};
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_declaration_order, test_tree )
+{
+    char const* expected[] = { "master",
+                               "ts_0", "tc_0", "tc_2", "tc_3", "tc_4", "tc_1",
+                               "ts_1", "tc_5", "tc_6", "tc_7", "tc_8", "tc_9" };
+
+    std::vector<std::string> names = run( ut::SCHEDULE_DECLARATION );
+
+    BOOST_TEST( names == std::vector<std::string>( expected, expected + sizeof(expected)/sizeof(expected[0]) ),
+                tt::per_element() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_longest_first_order, test_tree )
+{
+    // dependency ranks are preserved, and test suites are ordered by their total duration
+    char const* expected[] = { "master",
+                               "ts_1", "tc_6", "tc_9", "tc_8", "tc_7", "tc_5",
+                               "ts_0", "tc_4", "tc_3", "tc_2", "tc_0", "tc_1" };
+
+    std::vector<std::string> names = run( ut::SCHEDULE_LONGEST_FIRST );
+
+    BOOST_TEST( names == std::vector<std::string>( expected, expected + sizeof(expected)/sizeof(expected[0]) ),
+                tt::per_element() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_durations_are_saved, test_tree )
+{
+    // durations are saved at the end of the outermost run only
+    run( ut::SCHEDULE_DECLARATION, false );
+
+    std::ifstream in( file_name.c_str() );
+    std::vector<std::string> names;
+    std::string line;
+    while( std::getline( in, line ) ) {
+        std::string::size_type sep = line.find( ' ' );
+
+        BOOST_TEST_REQUIRE( sep != std::string::npos );
+        BOOST_TEST( std::strtoul( line.c_str(), 0, 10 ) != 0UL );
+        names.push_back( line.substr( sep + 1 ) );
+    }
+
+    // the durations of the other test cases are kept
+    std::vector<std::string> expected;
+    BOOST_TEST_FOREACH( ut::test_case*, tc, tcs )
+        expected.push_back( tc->full_name() );
+    expected.push_back( "other/tc" ); // entries are sorted by name
+
+    BOOST_TEST( names == expected, tt::per_element() );
+}
+
+// EOF
@@ -0,0 +1,174 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests partition of the test cases into shards
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit sharding test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/tree/visitor.hpp>
+#include <boost/test/utils/string_cast.hpp>
+
+namespace ut = boost::unit_test;
+namespace tt = boost::test_tools;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+void some_test() {}
+
+//____________________________________________________________________________//
+
+struct enabled_collector : ut::test_tree_visitor {
+    virtual void    visit( ut::test_case const& tc )
+    {
+        if( tc.is_enabled() )
+            m_names.insert( tc.full_name() );
+    }
+
+    std::set<std::string> m_names;
+};
+
+//____________________________________________________________________________//
+
+struct test_tree {
+    test_tree()
+    {
+        master = BOOST_TEST_SUITE( "master" );
+
+        for( std::size_t s = 0; s < 4; s++ ) {
+            ut::test_suite* ts = BOOST_TEST_SUITE( "ts_" + ut::utils::string_cast( s ) );
+            master->add( ts );
+
+            for( std::size_t c = 0; c < 10; c++ ) {
+                tcs.push_back( ut::make_test_case( boost::function<void ()>( some_test ),
+                                                   "tc_" + ut::utils::string_cast( c ),
+                                                   __FILE__, __LINE__ ) );
+                ts->add( tcs.back() );
+            }
+            suites.push_back( ts );
+        }
+
+        // chain of dependencies between test cases, and test suite depending on a test case
+        tcs[3]->depends_on( tcs[17] );
+        tcs[17]->depends_on( tcs[25] );
+        suites[3]->depends_on( tcs[1] );
+
+        setup_test_tree( *master );
+    }
+
+    std::set<std::string> shard( unsigned index, unsigned count )
+    {
+        config.set<unsigned>( ut::runtime_config::btrt_shard_count, count );
+        config.set<unsigned>( ut::runtime_config::btrt_shard_index, index );
+
+        ut::framework::impl::setup_for_execution( *master );
+
+        enabled_collector c;
+        ut::traverse_test_tree( master->p_id, c );
+
+        return c.m_names;
+    }
+
+    config_guard                    config;
+    ut::test_suite*                 master;
+    std::vector<ut::test_suite*>    suites;
+    std::vector<ut::test_case*>     tcs;
+};
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_shards_partition_test_cases, test_tree )
+{
+    unsigned const count = 3;
+
+    std::map<std::string,unsigned> shard_of;
+    for( unsigned i = 0; i < count; ++i ) {
+        std::set<std::string> names = shard( i, count );
+
+        BOOST_TEST( !names.empty() );
+        BOOST_TEST( names == shard( i, count ), tt::per_element() ); // same partition each time
+
+        BOOST_TEST_FOREACH( std::string const&, name, names ) {
+            BOOST_TEST( shard_of.count( name ) == 0U, "test case " << name << " assigned to several shards" );
+            shard_of[name] = i;
+        }
+    }
+
+    BOOST_TEST( shard_of.size() == tcs.size() );
+
+    // test cases depending on each other are assigned to the same shard
+    BOOST_TEST( shard_of[tcs[3]->full_name()] == shard_of[tcs[17]->full_name()] );
+    BOOST_TEST( shard_of[tcs[17]->full_name()] == shard_of[tcs[25]->full_name()] );
+    for( std::size_t c = 30; c < 40; ++c )
+        BOOST_TEST( shard_of[tcs[c]->full_name()] == shard_of[tcs[1]->full_name()] );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_shards_do_not_depend_on_registration_order, test_tree )
+{
+    std::set<std::string> names = shard( 1, 4 );
+
+    // additional test cases do not change the shard of the existing ones
+    for( std::size_t c = 10; c < 20; c++ )
+        suites[0]->add( ut::make_test_case( boost::function<void ()>( some_test ),
+                                            "tc_" + ut::utils::string_cast( c ),
+                                            __FILE__, __LINE__ ) );
+    ut::framework::finalize_setup_phase( master->p_id );
+
+    std::set<std::string> more_names = shard( 1, 4 );
+
+    BOOST_TEST_FOREACH( std::string const&, name, names )
+        BOOST_TEST( more_names.count( name ) == 1U, "test case " << name << " moved to another shard" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_FIXTURE_TEST_CASE( test_shards_balanced_by_durations, test_tree )
+{
+    std::string file_name = "test_unit-sharding-test.durations";
+    {
+        std::ofstream durations( file_name.c_str() );
+
+        // one long test case and the others taking 10 times less time
+        for( std::size_t i = 0; i < tcs.size(); ++i )
+            durations << (i == 5 ? 1000 : 100) << ' ' << tcs[i]->full_name() << '\n';
+    }
+    config.set<std::string>( ut::runtime_config::btrt_durations, file_name );
+
+    std::size_t total = 0;
+    std::vector<unsigned> loads;
+    for( unsigned i = 0; i < 2; ++i ) {
+        std::set<std::string> names = shard( i, 2 );
+        total += names.size();
+
+        loads.push_back( 0 );
+        BOOST_TEST_FOREACH( std::string const&, name, names )
+            loads.back() += name == tcs[5]->full_name() ? 1000 : 100;
+    }
+
+    std::remove( file_name.c_str() );
+
+    BOOST_TEST( total == tcs.size() );
+
+    // shards differ by no more than the duration of the shortest test case
+    BOOST_TEST( (loads[0] > loads[1] ? loads[0] - loads[1] : loads[1] - loads[0]) <= 100U );
+}
+
+// EOF
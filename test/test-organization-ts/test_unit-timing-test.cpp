@@ -0,0 +1,242 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief tests the durations measured for the test units and the timeouts
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE test unit timing test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+#include <boost/test/results_reporter.hpp>
+#include <boost/test/utils/timer.hpp>
+#include <boost/test/execution_monitor.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// STL
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+#include <chrono>
+#include <thread>
+#endif
+
+//____________________________________________________________________________//
+
+static volatile unsigned long spin_sink = 0;
+
+static void
+spin_for( double seconds )
+{
+    ut::utils::timer t;
+    while( t.elapsed() < seconds )
+        ++spin_sink;
+}
+
+void busy_body()
+{
+    spin_for( 0.05 );
+
+    BOOST_TEST( spin_sink > 0U );
+}
+
+void endless_body()
+{
+    spin_for( 5 );
+}
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+void threaded_body()
+{
+    std::thread( &spin_for, 0.05 ).join();
+}
+
+void sleeping_body()
+{
+    for( int i = 0; i < 500; ++i )
+        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+}
+#endif
+
+static int
+endless_function()
+{
+    endless_body();
+
+    return 0;
+}
+
+//____________________________________________________________________________//
+
+static ut::test_suite*
+run_timed( ut::test_case* tc, double timeout = 0 )
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ts_main->add( tc, 0, timeout );
+    setup_test_tree( *ts_main );
+
+    run_logged( ts_main->p_id );
+
+    return ts_main;
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_timer )
+{
+    boost::uint64_t const start = ut::utils::steady_clock_ns();
+    ut::utils::timer t;
+
+    spin_for( 0.01 );
+
+    ut::utils::elapsed_time const et = t.elapsed_times();
+    BOOST_TEST( et.m_wall_ns >= 10000000U );
+    BOOST_TEST( et.m_cpu_ns > 0U );
+    BOOST_TEST( ut::utils::steady_clock_ns() - start >= et.m_wall_ns );
+    BOOST_TEST( t.elapsed() >= 0.01 );
+
+    t.restart();
+    BOOST_TEST( t.elapsed() < 0.01 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_durations_stored )
+{
+    config_guard G;
+
+    ut::test_case* tc = BOOST_TEST_CASE( busy_body );
+    ut::test_suite* ts_main = run_timed( tc );
+
+    ut::test_results const& tr = ut::results_collector.results( tc->p_id );
+    BOOST_TEST( tr.passed() );
+    BOOST_TEST( tr.p_duration_nanoseconds >= 50000000U );
+    BOOST_TEST( tr.p_cpu_time_nanoseconds > 0U );
+
+    // the durations of a test suite are the sums of the ones of its test cases
+    ut::test_results const& suite_tr = ut::results_collector.results( ts_main->p_id );
+    BOOST_TEST( suite_tr.p_duration_nanoseconds == tr.p_duration_nanoseconds );
+    BOOST_TEST( suite_tr.p_cpu_time_nanoseconds == tr.p_cpu_time_nanoseconds );
+
+    std::ostringstream report;
+    ut::results_reporter::set_stream( report );
+    ut::results_reporter::make_report( ut::DETAILED_REPORT, ts_main->p_id );
+
+    BOOST_TEST( report.str().find( "wall time: " ) != std::string::npos );
+    BOOST_TEST( report.str().find( ", CPU time: " ) != std::string::npos );
+
+    // the short report is unchanged
+    std::ostringstream short_report;
+    ut::results_reporter::set_stream( short_report );
+    ut::results_reporter::make_report( ut::SHORT_REPORT, ts_main->p_id );
+
+    BOOST_TEST( short_report.str().find( "wall time: " ) == std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+BOOST_AUTO_TEST_CASE( test_cpu_time_of_threads )
+{
+    config_guard G;
+
+    // the CPU time of the test case includes the one of the threads it starts
+    ut::test_case* tc = BOOST_TEST_CASE( threaded_body );
+    run_timed( tc );
+
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_cpu_time_nanoseconds >= 40000000U );
+}
+#endif
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_sub_second_timeout )
+{
+    config_guard G;
+
+    ut::test_case* tc = BOOST_TEST_CASE( endless_body );
+
+    ut::utils::timer t;
+    run_timed( tc, 0.2 );
+
+    BOOST_TEST( t.elapsed() < 2. );
+
+    ut::test_results const& tr = ut::results_collector.results( tc->p_id );
+    BOOST_TEST( tr.p_aborted );
+    BOOST_TEST( !tr.passed() );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_timeout_backtrace )
+{
+    boost::execution_monitor em;
+    em.p_timeout.value          = 0.1;
+    em.p_timeout_action.value   = boost::TIMEOUT_BACKTRACE;
+
+    // the stack is written to the standard error stream, then the timeout is reported
+    bool timed_out = false;
+    try {
+        em.execute( &endless_function );
+    }
+    catch( boost::execution_exception const& ex ) {
+        timed_out = ex.code() == boost::execution_exception::timeout_error;
+    }
+
+    BOOST_TEST( timed_out );
+}
+
+//____________________________________________________________________________//
+
+#ifdef BOOST_TEST_SUPPORT_THREADS
+
+BOOST_AUTO_TEST_CASE( test_concurrent_timeouts )
+{
+    if( !boost::execution_monitor::thread_timeouts_supported() ) {
+        BOOST_TEST_MESSAGE( "the timeouts are process wide on this system" );
+        return;
+    }
+
+    config_guard G;
+    G.set<unsigned>( ut::runtime_config::btrt_parallel, 4U );
+
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    std::vector<ut::test_case*> tcs;
+    for( int i = 0; i < 4; ++i ) {
+        tcs.push_back( ut::make_test_case( &sleeping_body, "sleeping_body_" + ut::utils::string_cast( i ), __FILE__, __LINE__ ) );
+        ts_main->add( tcs.back(), 0, 0.25 );
+    }
+    setup_test_tree( *ts_main );
+
+    ut::utils::timer t;
+    run_logged( ts_main->p_id );
+
+    // each test case is interrupted by its own timer, sequentially they would last one second
+    BOOST_TEST( t.elapsed() < 0.9 );
+
+    for( std::size_t i = 0; i < tcs.size(); ++i )
+        BOOST_TEST( ut::results_collector.results( tcs[i]->p_id ).p_aborted );
+}
+
+#endif
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_decorator, * ut::timeout( 0.5 ) )
+{
+    BOOST_TEST( ut::framework::current_test_case().p_timeout == 0.5 );
+}
+
+// EOF
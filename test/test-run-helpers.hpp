@@ -0,0 +1,143 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+//  File        : $RCSfile$
+//
+//  Version     : $Revision$
+//
+//  Description : helpers of the tests running test trees of their own
+// ***************************************************************************
+
+#ifndef BOOST_TEST_TEST_RUN_HELPERS_HPP
+#define BOOST_TEST_TEST_RUN_HELPERS_HPP
+
+// Boost.Test
+#include <boost/test/framework.hpp>
+#include <boost/test/tree/test_unit.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_reporter.hpp>
+#include <boost/test/utils/algorithm.hpp>
+
+// Boost
+#include <boost/bind/bind.hpp>
+#include <boost/function/function0.hpp>
+
+// STL
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//____________________________________________________________________________//
+
+// Restores the log, the report stream and the runtime parameters changed by the test
+class config_guard {
+public:
+    config_guard() : m_log_format_set( false ) {}
+    ~config_guard()
+    {
+        namespace ut = boost::unit_test;
+
+        for( ; !m_restore.empty(); m_restore.pop_back() )
+            m_restore.back()();
+
+        if( m_log_format_set )
+            ut::unit_test_log.set_format( ut::runtime_config::get<ut::output_format>( ut::runtime_config::btrt_log_format ) );
+        ut::unit_test_log.set_threshold_level( ut::runtime_config::get<ut::log_level>( ut::runtime_config::btrt_log_level ) );
+        ut::unit_test_log.set_stream( std::cout );
+        ut::results_reporter::set_stream( std::cerr );
+    }
+
+    // sets the runtime parameter until the end of the test
+    template<typename T>
+    void    set( std::string const& parameter_name, T const& value )
+    {
+        namespace ut = boost::unit_test;
+
+        T const previous = ut::runtime_config::has( parameter_name ) ? ut::runtime_config::get<T>( parameter_name ) : T();
+
+        m_restore.push_back( boost::bind( &config_guard::assign<T>, parameter_name, previous ) );
+        assign( parameter_name, value );
+    }
+
+    // sets the format of the log until the end of the test
+    void    set_log_format( boost::unit_test::output_format format )
+    {
+        m_log_format_set = true;
+        boost::unit_test::unit_test_log.set_format( format );
+    }
+
+private:
+    template<typename T>
+    static void assign( std::string const& parameter_name, T const& value )
+    {
+        boost::unit_test::runtime_config::s_arguments_store.set<T>( parameter_name, value );
+    }
+
+    // Data members
+    std::vector<boost::function<void ()> >  m_restore;
+    bool                                    m_log_format_set;
+};
+
+//____________________________________________________________________________//
+
+// Enables the test tree built by the test and completes its setup, like the framework does for the
+// test units registered automatically (these ones are set up already: their decorators are applied once)
+inline void
+setup_test_tree( boost::unit_test::test_suite& ts )
+{
+    ts.p_default_status.value = boost::unit_test::test_unit::RS_ENABLED;
+
+    boost::unit_test::framework::finalize_setup_phase( ts.p_id );
+}
+
+//____________________________________________________________________________//
+
+// Runs the test tree with its log written to the output
+inline void
+run_logged( boost::unit_test::test_unit_id id, std::ostream& output, bool continue_test = false )
+{
+    boost::unit_test::unit_test_log.set_stream( output );
+
+    // unless the test continues, test_start and test_finish are logged too
+    boost::unit_test::framework::run( id, continue_test );
+
+    boost::unit_test::unit_test_log.set_stream( std::cout );
+}
+
+//____________________________________________________________________________//
+
+// Runs the test tree and gives the log it produced at the current threshold level
+inline std::string
+run_logged( boost::unit_test::test_unit_id id, bool continue_test = false )
+{
+    std::ostringstream output;
+    run_logged( id, output, continue_test );
+
+    return output.str();
+}
+
+//____________________________________________________________________________//
+
+// Gives the log with the testing times, which differ between the runs, replaced with fixed ones
+inline std::string
+scrub_times( std::string const& log )
+{
+    static const std::string to_look_for[] = { "; testing time: *us\n", "; testing time: *ms\n",
+                                               "<TestingTime>*</TestingTime>", "time=\"*\"" };
+    static const std::string to_replace[]  = { "\n", "\n", "<TestingTime>ZZZ</TestingTime>", "time=\"0.1234\"" };
+
+    return boost::unit_test::utils::replace_all_occurrences_with_wildcards(
+        log,
+        to_look_for, to_look_for + sizeof(to_look_for)/sizeof(to_look_for[0]),
+        to_replace, to_replace + sizeof(to_replace)/sizeof(to_replace[0]) );
+}
+
+//____________________________________________________________________________//
+
+#endif // BOOST_TEST_TEST_RUN_HELPERS_HPP
@@ -0,0 +1,123 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief measures the passing assertions which are not reported by any logger
+///
+/// 10^6 passing assertions are always measured. 10^8 passing assertions are only measured if the test
+/// module is given the argument "large", as in `assertion-fast-path-test -- large`.
+// ***************************************************************************
+
+// Boost.Test
+#define BOOST_TEST_MODULE assertion fast path test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+#include <boost/test/results_collector.hpp>
+
+namespace ut = boost::unit_test;
+
+#include "../test-run-helpers.hpp"
+
+// Boost
+#include <boost/timer.hpp>
+
+// STL
+#include <cstring>
+#include <string>
+
+//____________________________________________________________________________//
+
+static unsigned long assertions_count = 0;
+
+void passing_assertions()
+{
+    for( unsigned long i = 0; i < assertions_count; ++i )
+        BOOST_TEST( i < assertions_count );
+}
+
+//____________________________________________________________________________//
+
+static std::string
+log_of( unsigned long count, ut::output_format format, ut::log_level level, double& elapsed )
+{
+    ut::test_suite* ts_main = BOOST_TEST_SUITE( "main" );
+    ut::test_case* tc = BOOST_TEST_CASE( passing_assertions );
+    ts_main->add( tc );
+    setup_test_tree( *ts_main );
+
+    assertions_count = count;
+
+    std::string log;
+    {
+        config_guard G;
+
+        G.set_log_format( format );
+        ut::unit_test_log.set_threshold_level( level );
+
+        boost::timer t;
+        log = run_logged( ts_main->p_id );
+        elapsed = t.elapsed();
+    }
+
+    // the passing assertions are counted regardless of the log level
+    BOOST_TEST( ut::results_collector.results( tc->p_id ).p_assertions_passed == count );
+
+    return log;
+}
+
+//____________________________________________________________________________//
+
+static void
+measure( unsigned long count )
+{
+    ut::output_format const formats[] = { ut::OF_CLF, ut::OF_XML, ut::OF_JUNIT };
+    char const* const       names[]   = { "HRF", "XML", "JUNIT" };
+    double elapsed[sizeof(formats)/sizeof(formats[0])];
+
+    for( std::size_t f = 0; f < sizeof(formats)/sizeof(formats[0]); ++f ) {
+        std::string log = log_of( count, formats[f], ut::log_all_errors, elapsed[f] );
+
+        BOOST_TEST( log.find( "has passed" ) == std::string::npos );
+    }
+
+    for( std::size_t f = 0; f < sizeof(formats)/sizeof(formats[0]); ++f )
+        BOOST_TEST_MESSAGE( count << " passing assertions logged in format " << names[f] << ": " << elapsed[f] << "s" );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_passing_assertions_reported_at_success_level )
+{
+    double elapsed;
+    std::string log = log_of( 10, ut::OF_CLF, ut::log_successful_tests, elapsed );
+
+    BOOST_TEST( log.find( "check i < assertions_count has passed" ) != std::string::npos );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_1m_passing_assertions )
+{
+    measure( 1000000 );
+}
+
+//____________________________________________________________________________//
+
+BOOST_AUTO_TEST_CASE( test_100m_passing_assertions )
+{
+    ut::master_test_suite_t& mts = ut::framework::master_test_suite();
+
+    if( mts.argc < 2 || std::strcmp( mts.argv[1], "large" ) != 0 ) {
+        BOOST_TEST_MESSAGE( "skipped: pass the argument 'large' to measure 10^8 passing assertions" );
+        return;
+    }
+
+    measure( 100000000 );
+}
+
+// EOF
@@ -0,0 +1,157 @@
+//  (C) Copyright Gennadiy Rozental 2001.
+//  Distributed under the Boost Software License, Version 1.0.
+//  (See accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/libs/test for the library home page.
+//
+/// @file
+/// @brief converts a log written in the BINARY log format to the HRF, XML or JUNIT log format
+///
+/// Usage: log_decoder [--log_format=HRF|CLF|XML|JUNIT] [--log_level=<level>] [--log_sink=<file>] [<binary log>]
+///
+/// The binary log is read from the standard input if no file is given, and the converted log is written
+/// to the standard output if no sink is given.
+// ***************************************************************************
+
+// Boost.Test
+#include <boost/test/output/binary_log_formatter.hpp>
+#include <boost/test/output/compiler_log_formatter.hpp>
+#include <boost/test/output/junit_log_formatter.hpp>
+#include <boost/test/output/xml_log_formatter.hpp>
+#include <boost/test/unit_test_log.hpp>
+#include <boost/test/unit_test_parameters.hpp>
+
+namespace ut = boost::unit_test;
+
+// Boost
+#include <boost/scoped_ptr.hpp>
+
+// STL
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+//____________________________________________________________________________//
+
+static const std::pair<const char*, ut::log_level> all_log_levels[] = {
+    std::make_pair( "all"           , ut::log_successful_tests ),
+    std::make_pair( "success"       , ut::log_successful_tests ),
+    std::make_pair( "test_suite"    , ut::log_test_units ),
+    std::make_pair( "unit_scope"    , ut::log_test_units ),
+    std::make_pair( "message"       , ut::log_messages ),
+    std::make_pair( "warning"       , ut::log_warnings ),
+    std::make_pair( "error"         , ut::log_all_errors ),
+    std::make_pair( "cpp_exception" , ut::log_cpp_exception_errors ),
+    std::make_pair( "system_error"  , ut::log_system_errors ),
+    std::make_pair( "fatal_error"   , ut::log_fatal_errors ),
+    std::make_pair( "nothing"       , ut::log_nothing )
+};
+
+//____________________________________________________________________________//
+
+static bool
+parse_argument( char const* arg, char const* name, std::string& value )
+{
+    std::size_t len = std::strlen( name );
+
+    if( std::strncmp( arg, name, len ) != 0 || arg[len] != '=' )
+        return false;
+
+    value = arg + len + 1;
+    return true;
+}
+
+//____________________________________________________________________________//
+
+static int
+usage( char const* error )
+{
+    std::cerr << error << '\n'
+              << "Usage: log_decoder [--log_format=HRF|CLF|XML|JUNIT] [--log_level=<level>] [--log_sink=<file>] [<binary log>]"
+              << std::endl;
+    return 1;
+}
+
+//____________________________________________________________________________//
+
+int
+main( int argc, char* argv[] )
+{
+    std::string format( "HRF" ), level, sink, input_file;
+
+    for( int i = 1; i < argc; ++i ) {
+        if( parse_argument( argv[i], "--log_format", format ) ||
+            parse_argument( argv[i], "--log_level", level ) ||
+            parse_argument( argv[i], "--log_sink", sink ) )
+            continue;
+
+        if( argv[i][0] == '-' || !input_file.empty() )
+            return usage( (std::string( "Unexpected argument " ) + argv[i]).c_str() );
+
+        input_file = argv[i];
+    }
+
+    boost::scoped_ptr<ut::unit_test_log_formatter> formatter;
+    if( format == "HRF" || format == "CLF" )
+        formatter.reset( new ut::output::compiler_log_formatter );
+    else if( format == "XML" )
+        formatter.reset( new ut::output::xml_log_formatter );
+    else if( format == "JUNIT" )
+        formatter.reset( new ut::output::junit_log_formatter );
+    else
+        return usage( ("Unknown log format " + format).c_str() );
+
+    // by default, the log entries are written out at the level they were recorded with
+    ut::log_level formatter_log_level = ut::log_successful_tests;
+    if( !level.empty() ) {
+        formatter_log_level = ut::invalid_log_level;
+
+        for( std::size_t elem = 0; elem < sizeof(all_log_levels)/sizeof(all_log_levels[0]); elem++ ) {
+            if( level == all_log_levels[elem].first )
+                formatter_log_level = all_log_levels[elem].second;
+        }
+
+        if( formatter_log_level == ut::invalid_log_level )
+            return usage( ("Unknown log level " + level).c_str() );
+    }
+    formatter->set_log_level( formatter_log_level );
+
+    // the formatters are configured by the environment variables of the framework only
+    int rt_argc = 1;
+    ut::runtime_config::init( rt_argc, argv );
+
+    // the messages of the framework are in the binary log already
+    ut::unit_test_log.set_threshold_level( ut::log_nothing );
+
+    std::ifstream input_stream;
+    if( !input_file.empty() ) {
+        input_stream.open( input_file.c_str(), std::ios_base::in | std::ios_base::binary );
+        if( !input_stream )
+            return usage( ("Cannot open " + input_file).c_str() );
+    }
+
+    std::ofstream output_stream;
+    if( !sink.empty() ) {
+        output_stream.open( sink.c_str() );
+        if( !output_stream )
+            return usage( ("Cannot open " + sink).c_str() );
+    }
+
+    try {
+        ut::output::decode_binary_log( input_file.empty() ? std::cin : input_stream, *formatter,
+                                       sink.empty() ? std::cout : output_stream );
+    }
+    catch( std::runtime_error const& ex ) {
+        std::cerr << "Failed to decode the binary log: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+//____________________________________________________________________________//
+
+// EOF